@@ -32,6 +32,8 @@ class ngraph::codegen::CodeWriter
 public:
     CodeWriter();
     std::string get_code() const;
+    /// Number of characters written so far
+    size_t get_code_size() { return static_cast<size_t>(m_ss.tellp()); }
 
     void operator+=(const std::string&);
 
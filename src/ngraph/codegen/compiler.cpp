@@ -14,7 +14,12 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 #include <clang/Basic/DiagnosticOptions.h>
 #include <clang/Basic/TargetInfo.h>
@@ -73,6 +78,9 @@ using namespace std;
 using namespace ngraph;
 
 static codegen::StaticCompiler s_static_compiler;
+// Additional compiler instances used to compile multiple modules concurrently.
+// Each instance is only ever used by one thread at a time.
+static std::vector<std::unique_ptr<codegen::StaticCompiler>> s_compiler_pool;
 static std::mutex m_mutex;
 
 codegen::Module::Module(std::unique_ptr<llvm::Module> module)
@@ -99,12 +107,28 @@ codegen::Compiler::~Compiler()
 
 void codegen::Compiler::set_precompiled_header_source(const std::string& source)
 {
+    lock_guard<mutex> lock(m_mutex);
     s_static_compiler.set_precompiled_header_source(source);
+    for (auto& compiler : s_compiler_pool)
+    {
+        compiler->set_precompiled_header_source(source);
+    }
 }
 
 void codegen::Compiler::add_header_search_path(const std::string& path)
 {
+    lock_guard<mutex> lock(m_mutex);
     s_static_compiler.add_header_search_path(path);
+    for (auto& compiler : s_compiler_pool)
+    {
+        compiler->add_header_search_path(path);
+    }
+}
+
+std::string codegen::Compiler::get_header_fingerprint()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return s_static_compiler.get_header_fingerprint();
 }
 
 std::unique_ptr<codegen::Module> codegen::Compiler::compile(const std::string& source)
@@ -113,6 +137,47 @@ std::unique_ptr<codegen::Module> codegen::Compiler::compile(const std::string& s
     return s_static_compiler.compile(m_compiler_action, source);
 }
 
+std::vector<std::unique_ptr<codegen::Module>>
+    codegen::Compiler::compile(const std::vector<std::string>& sources, size_t thread_count)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    thread_count = std::max<size_t>(1, std::min(thread_count, sources.size()));
+    while (s_compiler_pool.size() < thread_count - 1)
+    {
+        std::unique_ptr<codegen::StaticCompiler> compiler(new codegen::StaticCompiler());
+        for (const string& path : s_static_compiler.get_header_search_paths())
+        {
+            compiler->add_header_search_path(path);
+        }
+        compiler->set_precompiled_header_source(
+            s_static_compiler.get_precompiled_header_source());
+        s_compiler_pool.push_back(move(compiler));
+    }
+
+    vector<unique_ptr<codegen::Module>> modules(sources.size());
+    m_compiler_actions.resize(sources.size());
+    std::atomic<size_t> next_source{0};
+    auto compile_sources = [&](codegen::StaticCompiler* compiler) {
+        for (size_t i = next_source++; i < sources.size(); i = next_source++)
+        {
+            modules[i] = compiler->compile(m_compiler_actions[i], sources[i]);
+        }
+    };
+
+    vector<std::thread> threads;
+    for (size_t i = 0; i < thread_count - 1; i++)
+    {
+        threads.emplace_back(compile_sources, s_compiler_pool[i].get());
+    }
+    compile_sources(&s_static_compiler);
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+    return modules;
+}
+
 static std::string GetExecutablePath(const char* Argv0)
 {
     // This just needs to be some symbol in the binary; C++ doesn't
@@ -258,6 +323,65 @@ void codegen::StaticCompiler::add_header_search_path(const string& path)
     }
 }
 
+// 64 bit FNV-1a, each string is followed by a separator so that moving bytes between
+// consecutive strings changes the hash
+static void hash_string(uint64_t& hash, const string& data)
+{
+    for (unsigned char c : data)
+    {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    hash *= 0x100000001b3ULL;
+}
+
+string codegen::StaticCompiler::get_header_fingerprint() const
+{
+    // The built-in headers are part of the library so they are only hashed once
+    static const uint64_t builtin_hash = []() {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (const string& search_path : builtin_search_paths)
+        {
+            hash_string(hash, search_path);
+        }
+        for (const pair<string, string>& header_info : builtin_headers)
+        {
+            hash_string(hash, header_info.first);
+            hash_string(hash, header_info.second);
+        }
+        return hash;
+    }();
+
+    uint64_t hash = builtin_hash;
+    for (const string& search_path : m_extra_search_path_list)
+    {
+        hash_string(hash, search_path);
+        if (!file_util::exists(search_path))
+        {
+            continue;
+        }
+        vector<string> files;
+        file_util::iterate_files(search_path,
+                                 [&files](const string& file, bool is_dir) {
+                                     if (!is_dir)
+                                     {
+                                         files.push_back(file);
+                                     }
+                                 },
+                                 true);
+        sort(files.begin(), files.end());
+        for (const string& file : files)
+        {
+            hash_string(hash, file);
+            hash_string(hash, file_util::read_file_to_string(file));
+        }
+    }
+
+    char fingerprint[32];
+    snprintf(fingerprint, sizeof(fingerprint), "%016llx", static_cast<unsigned long long>(hash));
+    return fingerprint;
+}
+
 std::unique_ptr<codegen::Module>
     codegen::StaticCompiler::compile(std::unique_ptr<clang::CodeGenAction>& m_compiler_action,
                                      const string& source)
@@ -61,10 +61,19 @@ public:
     ~Compiler();
     void set_precompiled_header_source(const std::string& source);
     void add_header_search_path(const std::string& path);
+    /// \brief Hash of the headers a compile can include besides its source: the built-in
+    ///        headers and every file under the added search paths.
+    std::string get_header_fingerprint();
     std::unique_ptr<ngraph::codegen::Module> compile(const std::string& source);
+    /// \brief Compiles each source into its own module, running up to thread_count
+    ///        compiler instances concurrently.
+    std::vector<std::unique_ptr<ngraph::codegen::Module>>
+        compile(const std::vector<std::string>& sources, size_t thread_count);
     std::unique_ptr<clang::CodeGenAction>& get_compiler_action() { return m_compiler_action; }
 private:
     std::unique_ptr<clang::CodeGenAction> m_compiler_action;
+    // The actions own the LLVM contexts of the modules they produced
+    std::vector<std::unique_ptr<clang::CodeGenAction>> m_compiler_actions;
 };
 
 class ngraph::codegen::StaticCompiler
@@ -76,7 +85,16 @@ public:
     void set_debuginfo_enabled(bool state) { m_debuginfo_enabled = state; }
     bool is_debuginfo_enabled() { return m_debuginfo_enabled; }
     void set_precompiled_header_source(const std::string& source);
+    const std::string& get_precompiled_header_source() const
+    {
+        return m_precomiled_header_source;
+    }
     void add_header_search_path(const std::string& path);
+    const std::vector<std::string>& get_header_search_paths() const
+    {
+        return m_extra_search_path_list;
+    }
+    std::string get_header_fingerprint() const;
 
     std::unique_ptr<ngraph::codegen::Module>
         compile(std::unique_ptr<clang::CodeGenAction>& compiler_action, const std::string& source);
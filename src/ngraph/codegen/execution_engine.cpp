@@ -14,12 +14,218 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+#include <unordered_map>
+
+#include <llvm/Config/llvm-config.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
 
 #include "ngraph/codegen/execution_engine.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/log.hpp"
+
+#if defined(__clang__)
+#define IS_RTTI_ENABLED __has_feature(cxx_rtti)
+#elif defined(__GNUC__)
+#define IS_RTTI_ENABLED __GXX_RTTI
+#else
+// Unknown compiler so assume RTTI is enabled by default
+#define IS_RTTI_ENABLED 1
+#endif
 
+#if IS_RTTI_ENABLED
+#error "This source file interfaces with LLVM and must be compiled with RTTI disabled"
+#endif
+
+#ifndef NGRAPH_VERSION
+#define NGRAPH_VERSION "unknown"
+#endif
+
+using namespace std;
 using namespace ngraph;
 
+// Static constructors of cached modules are invisible to the JIT since a cache hit only
+// provides object code, not the llvm.global_ctors table. All modules that go through the
+// cache therefore have their constructors lowered into a function named after the module's
+// cache key which is called explicitly once the objects are loaded.
+static string get_lowered_constructors_name(const string& key)
+{
+    return "__ngraph_module_constructors_" + key;
+}
+
+class ngraph::codegen::ObjectCache : public llvm::ObjectCache
+{
+public:
+    ObjectCache(const string& cache_dir, const string& header_fingerprint)
+        : m_cache_dir(cache_dir)
+        , m_header_fingerprint(header_fingerprint)
+    {
+        file_util::make_directory(m_cache_dir);
+    }
+
+    // The cache key covers everything that can change the generated object code for a
+    // given source: the headers it can include, the ngraph build, the host CPU and target,
+    // the LLVM version and the compiler options that are controlled from the environment.
+    string get_key(const string& source) const
+    {
+        string identity = source;
+        identity += '\0';
+        identity += m_header_fingerprint;
+        identity += '\0';
+        identity += NGRAPH_VERSION;
+        identity += '\0';
+        identity += llvm::sys::getProcessTriple();
+        identity += '\0';
+        identity += llvm::sys::getHostCPUName().str();
+        identity += '\0';
+        identity += LLVM_VERSION_STRING;
+        identity += '\0';
+        identity += (getenv("NGRAPH_COMPILER_DEBUGINFO_ENABLE") != nullptr ? "debug" : "");
+
+        // 64 bit FNV-1a
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (unsigned char c : identity)
+        {
+            hash ^= c;
+            hash *= 0x100000001b3ULL;
+        }
+        char key[32];
+        snprintf(key, sizeof(key), "ngraph_%016llx", static_cast<unsigned long long>(hash));
+        return key;
+    }
+
+    bool contains(const string& key, const string& source) const
+    {
+        // The source is stored next to the object and compared on lookup so that a hash
+        // collision can never load the wrong object code
+        string source_path = get_path(key, ".cpp");
+        return file_util::exists(source_path) && file_util::exists(get_path(key, ".o")) &&
+               file_util::read_file_to_string(source_path) == source;
+    }
+
+    void add_pending(const string& key, const string& source) { m_pending[key] = source; }
+    void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef object) override
+    {
+        auto it = m_pending.find(module->getModuleIdentifier());
+        if (it == m_pending.end())
+        {
+            return;
+        }
+        // Write the object before the source since the source marks the entry as valid
+        if (write_file(get_path(it->first, ".o"), object.getBufferStart(), object.getBufferSize()))
+        {
+            write_file(get_path(it->first, ".cpp"), it->second.data(), it->second.size());
+        }
+        m_pending.erase(it);
+    }
+
+    unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override
+    {
+        const string& key = module->getModuleIdentifier();
+        if (m_pending.find(key) != m_pending.end())
+        {
+            return nullptr;
+        }
+        auto buffer = llvm::MemoryBuffer::getFile(get_path(key, ".o"));
+        if (!buffer)
+        {
+            return nullptr;
+        }
+        return move(buffer.get());
+    }
+
+private:
+    string get_path(const string& key, const string& extension) const
+    {
+        return file_util::path_join(m_cache_dir, key + extension);
+    }
+
+    // Entries are written to a temporary file and renamed into place so concurrent
+    // processes sharing a cache directory never observe a partially written file
+    bool write_file(const string& path, const char* data, size_t size) const
+    {
+        string tmp_path = path + ".tmp" + to_string(getpid());
+        {
+            ofstream out(tmp_path, ios::binary);
+            out.write(data, size);
+            if (!out)
+            {
+                NGRAPH_WARN << "Unable to write object cache entry " << tmp_path;
+                file_util::remove_file(tmp_path);
+                return false;
+            }
+        }
+        if (rename(tmp_path.c_str(), path.c_str()) != 0)
+        {
+            file_util::remove_file(tmp_path);
+            return false;
+        }
+        return true;
+    }
+
+    string m_cache_dir;
+    string m_header_fingerprint;
+    unordered_map<string, string> m_pending;
+};
+
+// Replaces llvm.global_ctors by an externally visible function calling each constructor
+// in priority order
+static void lower_static_constructors(llvm::Module& module, const string& name)
+{
+    llvm::LLVMContext& context = module.getContext();
+    llvm::Function* constructors =
+        llvm::Function::Create(llvm::FunctionType::get(llvm::Type::getVoidTy(context), false),
+                               llvm::GlobalValue::ExternalLinkage,
+                               name,
+                               &module);
+    llvm::IRBuilder<> builder(llvm::BasicBlock::Create(context, "entry", constructors));
+
+    llvm::GlobalVariable* global_ctors = module.getNamedGlobal("llvm.global_ctors");
+    if (global_ctors)
+    {
+        vector<pair<uint64_t, llvm::Function*>> entries;
+        if (global_ctors->hasInitializer())
+        {
+            auto* list = llvm::dyn_cast<llvm::ConstantArray>(global_ctors->getInitializer());
+            for (unsigned i = 0; list && i < list->getNumOperands(); i++)
+            {
+                auto* entry = llvm::dyn_cast<llvm::ConstantStruct>(list->getOperand(i));
+                if (entry == nullptr)
+                {
+                    continue;
+                }
+                auto* priority = llvm::dyn_cast<llvm::ConstantInt>(entry->getOperand(0));
+                auto* function =
+                    llvm::dyn_cast<llvm::Function>(entry->getOperand(1)->stripPointerCasts());
+                if (priority && function)
+                {
+                    entries.push_back({priority->getZExtValue(), function});
+                }
+            }
+        }
+        stable_sort(entries.begin(),
+                    entries.end(),
+                    [](const pair<uint64_t, llvm::Function*>& a,
+                       const pair<uint64_t, llvm::Function*>& b) { return a.first < b.first; });
+        for (auto& entry : entries)
+        {
+            builder.CreateCall(entry.second);
+        }
+        global_ctors->eraseFromParent();
+    }
+    builder.CreateRetVoid();
+}
+
 codegen::ExecutionEngine::ExecutionEngine()
     : m_execution_engine{nullptr}
 {
@@ -34,12 +240,70 @@ codegen::ExecutionEngine::~ExecutionEngine()
 }
 
 bool codegen::ExecutionEngine::add_module(std::unique_ptr<ngraph::codegen::Module>& module)
+{
+    if (module)
+    {
+        return add_llvm_module(module->take_module());
+    }
+    return false;
+}
+
+void codegen::ExecutionEngine::enable_object_cache(const std::string& cache_dir,
+                                                  const std::string& header_fingerprint)
+{
+    m_object_cache.reset(new codegen::ObjectCache(cache_dir, header_fingerprint));
+}
+
+bool codegen::ExecutionEngine::add_module(std::unique_ptr<ngraph::codegen::Module>& module,
+                                          const std::string& source)
+{
+    if (!module)
+    {
+        return false;
+    }
+    unique_ptr<llvm::Module> llvm_module = module->take_module();
+    if (m_object_cache)
+    {
+        string key = m_object_cache->get_key(source);
+        llvm_module->setModuleIdentifier(key);
+        lower_static_constructors(*llvm_module, get_lowered_constructors_name(key));
+        m_object_cache->add_pending(key, source);
+        m_lowered_constructors.push_back(get_lowered_constructors_name(key));
+    }
+    return add_llvm_module(move(llvm_module));
+}
+
+bool codegen::ExecutionEngine::add_cached_module(const std::string& source)
+{
+    if (!m_object_cache)
+    {
+        return false;
+    }
+    string key = m_object_cache->get_key(source);
+    if (!m_object_cache->contains(key, source))
+    {
+        return false;
+    }
+
+    // MCJIT loads object code per module so an empty module named after the cache key
+    // stands in for the cached object
+    if (!m_context)
+    {
+        m_context.reset(new llvm::LLVMContext());
+    }
+    unique_ptr<llvm::Module> placeholder(new llvm::Module(key, *m_context));
+    placeholder->setTargetTriple(llvm::sys::getProcessTriple());
+    m_lowered_constructors.push_back(get_lowered_constructors_name(key));
+    return add_llvm_module(move(placeholder));
+}
+
+bool codegen::ExecutionEngine::add_llvm_module(std::unique_ptr<llvm::Module> module)
 {
     if (module)
     {
         if (!m_execution_engine)
         {
-            m_execution_engine.reset(llvm::EngineBuilder(module->take_module())
+            m_execution_engine.reset(llvm::EngineBuilder(move(module))
                                          .setEngineKind(llvm::EngineKind::JIT)
                                          .setOptLevel(llvm::CodeGenOpt::Aggressive)
                                          .setMCPU(llvm::sys::getHostCPUName())
@@ -51,6 +315,14 @@ bool codegen::ExecutionEngine::add_module(std::unique_ptr<ngraph::codegen::Modul
             {
                 return false;
             }
+            if (m_object_cache)
+            {
+                m_execution_engine->setObjectCache(m_object_cache.get());
+            }
+        }
+        else
+        {
+            m_execution_engine->addModule(move(module));
         }
     }
     else
@@ -67,6 +339,15 @@ void codegen::ExecutionEngine::finalize()
     {
         m_execution_engine->finalizeObject();
         m_execution_engine->runStaticConstructorsDestructors(false);
+        for (const string& name : m_lowered_constructors)
+        {
+            auto constructors =
+                reinterpret_cast<void (*)()>(get_pointer_to_named_function(name));
+            if (constructors)
+            {
+                constructors();
+            }
+        }
     }
     else
     {
@@ -18,6 +18,8 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "ngraph/codegen/compiler.hpp"
 
@@ -26,11 +28,13 @@ namespace ngraph
     namespace codegen
     {
         class ExecutionEngine;
+        class ObjectCache;
     }
 }
 
 namespace llvm
 {
+    class LLVMContext;
     class Module;
     class ExecutionEngine;
 }
@@ -44,6 +48,21 @@ public:
     bool add_module(std::unique_ptr<ngraph::codegen::Module>& module);
     void finalize();
 
+    /// \brief Enables the persistent object cache rooted at cache_dir. Object code
+    ///        generated for modules added with add_module(module, source) is stored there
+    ///        and can be reloaded by add_cached_module without invoking the compiler.
+    ///        header_fingerprint, see Compiler::get_header_fingerprint, is part of every
+    ///        cache key so that entries compiled against other headers are not reused.
+    void enable_object_cache(const std::string& cache_dir,
+                             const std::string& header_fingerprint);
+    bool is_object_cache_enabled() const { return m_object_cache != nullptr; }
+    /// \brief Adds a module and records its object code in the object cache under a key
+    ///        derived from source, the source text the module was compiled from.
+    bool add_module(std::unique_ptr<ngraph::codegen::Module>& module, const std::string& source);
+    /// \brief Adds the cached object code for source, if any.
+    /// \return true on a cache hit, false if source must be compiled
+    bool add_cached_module(const std::string& source);
+
     template <typename ftype>
     std::function<ftype> find_function(const std::string& func_name)
     {
@@ -51,9 +70,14 @@ public:
     }
 
 private:
+    // Declared ahead of the engine so that modules created in this context outlive it
+    std::unique_ptr<llvm::LLVMContext> m_context;
+    std::unique_ptr<ngraph::codegen::ObjectCache> m_object_cache;
     std::unique_ptr<llvm::ExecutionEngine> m_execution_engine;
     std::string m_jit_error;
+    std::vector<std::string> m_lowered_constructors;
 
+    bool add_llvm_module(std::unique_ptr<llvm::Module> module);
     void* get_pointer_to_named_function(const std::string& func_name);
     template <typename signature>
     std::function<signature> f_cast(void* f)
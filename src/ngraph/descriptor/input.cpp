@@ -35,6 +35,7 @@ void Input::replace_output(Output& new_output)
     m_output->remove_input(this);
     new_output.add_input(this);
     m_output = &new_output;
+    Node::m_graph_version++;
 }
 
 void Input::replace_output(std::shared_ptr<Node> node, size_t i)
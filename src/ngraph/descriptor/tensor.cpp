@@ -35,6 +35,9 @@ descriptor::Tensor::Tensor(const element::Type& element_type,
     , m_is_constant{is_constant}
     , m_name{name}
     , m_next_view_id{0}
+    , m_has_liveness{false}
+    , m_first_use{0}
+    , m_last_use{0}
 {
     size_t size = 1;
     for (size_t s : primary_tensor_view->get_tensor_view_type()->get_shape())
@@ -69,6 +72,13 @@ size_t descriptor::Tensor::get_pool_offset() const
     return m_pool_offset;
 }
 
+void descriptor::Tensor::set_liveness(size_t first_use, size_t last_use)
+{
+    m_has_liveness = true;
+    m_first_use = first_use;
+    m_last_use = last_use;
+}
+
 ostream& operator<<(ostream& out, const descriptor::Tensor& tensor)
 {
     out << "Tensor(" << tensor.get_name() << ", ";
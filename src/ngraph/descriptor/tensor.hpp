@@ -64,6 +64,13 @@ public:
     size_t size() const;
     void set_pool_offset(size_t);
     size_t get_pool_offset() const;
+    /// Lifetime of a temporary set by pass::Liveness, as indices into the ordered ops of its
+    /// function: the op computing it and the last op using it
+    void set_liveness(size_t first_use, size_t last_use);
+    void clear_liveness() { m_has_liveness = false; }
+    bool has_liveness() const { return m_has_liveness; }
+    size_t get_first_use() const { return m_first_use; }
+    size_t get_last_use() const { return m_last_use; }
     const element::Type& get_element_type() const { return m_element_type; }
     static std::string make_tensor_name(const Node* node, size_t value_index);
     void set_is_output() { m_is_output = true; }
@@ -78,6 +85,9 @@ protected:
     size_t m_next_view_id;
     size_t m_size;
     size_t m_pool_offset;
+    bool m_has_liveness;
+    size_t m_first_use;
+    size_t m_last_use;
 };
 
 std::ostream& operator<<(std::ostream&, const ngraph::descriptor::Tensor&);
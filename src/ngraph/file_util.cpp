@@ -61,6 +61,21 @@ std::string ngraph::file_util::get_file_ext(const std::string& s)
     return rc;
 }
 
+std::string ngraph::file_util::get_directory(const std::string& s)
+{
+    string rc = s;
+    auto pos = s.find_last_of('/');
+    if (pos != string::npos)
+    {
+        rc = s.substr(0, pos);
+    }
+    else
+    {
+        rc = "";
+    }
+    return rc;
+}
+
 string ngraph::file_util::path_join(const string& s1, const string& s2)
 {
     string rc;
@@ -33,7 +33,10 @@ Function::Function(const ResultVector& results,
     : m_results(results)
     , m_parameters(parameters)
     , m_temporary_pool_size(0)
+    , m_temporary_pool_lower_bound(0)
     , m_instance_id(m_next_instance_id.fetch_add(1))
+    , m_ordered_ops_valid(false)
+    , m_ordered_ops_version(0)
     , m_name(name)
     , m_unique_name("Function_" + to_string(m_instance_id))
 {
@@ -46,7 +49,10 @@ Function::Function(const NodeVector& results,
     : m_results(results.size())
     , m_parameters(parameters)
     , m_temporary_pool_size(0)
+    , m_temporary_pool_lower_bound(0)
     , m_instance_id(m_next_instance_id.fetch_add(1))
+    , m_ordered_ops_valid(false)
+    , m_ordered_ops_version(0)
     , m_name(name)
     , m_unique_name("Function_" + to_string(m_instance_id))
 {
@@ -90,7 +96,17 @@ void Function::init()
 
 std::list<shared_ptr<Node>> Function::get_ordered_ops()
 {
-    return topological_sort(get_ops());
+    // Sorting dominates compile time on large graphs, and the order is requested by every
+    // pass, so it is only recomputed after the graph has been rewired
+    std::lock_guard<std::mutex> lock(m_ordered_ops_mutex);
+    size_t version = Node::get_graph_version();
+    if (!m_ordered_ops_valid || m_ordered_ops_version != version)
+    {
+        m_ordered_ops = topological_sort(get_ops());
+        m_ordered_ops_valid = true;
+        m_ordered_ops_version = version;
+    }
+    return m_ordered_ops;
 }
 
 const std::string& Function::get_friendly_name() const
@@ -20,6 +20,7 @@
 #include <initializer_list>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -80,6 +81,10 @@ namespace ngraph
         size_t get_instance_id() { return m_instance_id; }
         size_t get_temporary_pool_size();
         void set_temporary_pool_size(size_t);
+        // Peak total size of the temporaries live at the same time, which no layout of the
+        // temporary pool can go below
+        size_t get_temporary_pool_lower_bound() { return m_temporary_pool_lower_bound; }
+        void set_temporary_pool_lower_bound(size_t size) { m_temporary_pool_lower_bound = size; }
         // updates graph and m_results list
         void replace_node(std::shared_ptr<Node> old, std::shared_ptr<Node> repl);
 
@@ -87,6 +92,7 @@ namespace ngraph
         ResultVector m_results;
         op::ParameterVector m_parameters;
         size_t m_temporary_pool_size;
+        size_t m_temporary_pool_lower_bound;
 
     private:
         Function(const Function&) = delete;
@@ -94,6 +100,11 @@ namespace ngraph
 
         static std::atomic<size_t> m_next_instance_id;
         size_t m_instance_id;
+        // Topological order of the ops, valid while Node::get_graph_version() is unchanged
+        std::list<std::shared_ptr<Node>> m_ordered_ops;
+        bool m_ordered_ops_valid;
+        size_t m_ordered_ops_version;
+        std::mutex m_ordered_ops_mutex;
         std::string m_name;
         const std::string m_unique_name;
     };
@@ -15,6 +15,7 @@
 *******************************************************************************/
 
 #include "ngraph/node.hpp"
+#include <algorithm>
 #include <memory>
 #include <typeindex>
 #include <typeinfo>
@@ -34,6 +35,7 @@ using namespace std;
 using namespace ngraph;
 
 atomic<size_t> Node::m_next_instance_id(0);
+atomic<size_t> Node::m_graph_version(0);
 
 Node::Node(const std::string& node_type, const NodeVector& arguments)
     : m_node_type(node_type)
@@ -144,6 +146,41 @@ void Node::set_placement(Placement placement)
     m_placement = placement;
 }
 
+vector<descriptor::Tensor*> Node::get_liveness_new_list() const
+{
+    vector<descriptor::Tensor*> new_list;
+    for (const descriptor::Output& output : m_outputs)
+    {
+        descriptor::Tensor& tensor = output.get_tensor();
+        if (tensor.has_liveness() && tensor.get_first_use() == m_liveness_index)
+        {
+            new_list.push_back(&tensor);
+        }
+    }
+    return new_list;
+}
+
+vector<descriptor::Tensor*> Node::get_liveness_free_list() const
+{
+    vector<descriptor::Tensor*> free_list;
+    auto add = [&](descriptor::Tensor& tensor) {
+        if (tensor.has_liveness() && tensor.get_last_use() == m_liveness_index &&
+            find(free_list.begin(), free_list.end(), &tensor) == free_list.end())
+        {
+            free_list.push_back(&tensor);
+        }
+    };
+    for (const descriptor::Input& input : m_inputs)
+    {
+        add(input.get_output().get_tensor());
+    }
+    for (const descriptor::Output& output : m_outputs)
+    {
+        add(output.get_tensor());
+    }
+    return free_list;
+}
+
 std::shared_ptr<Node> Node::get_input_op(size_t index)
 {
     for (auto arg : m_arguments)
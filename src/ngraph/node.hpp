@@ -124,6 +124,9 @@ namespace ngraph
         virtual bool is_constant() const;
         virtual bool is_commutative() { return false; }
         size_t get_instance_id() const { return m_instance_id; }
+        /// Changes whenever the input of any node is connected to a different output, which
+        /// lets Function keep its topological order until the graph is rewritten
+        static size_t get_graph_version() { return m_graph_version; }
         friend std::ostream& operator<<(std::ostream&, const Node&);
 
         // TODO: Deprecate
@@ -176,9 +179,15 @@ namespace ngraph
         /// Returns the shape of input i
         const Shape& get_input_shape(size_t i) const;
 
-        std::unordered_set<descriptor::Tensor*> liveness_live_list;
-        std::unordered_set<descriptor::Tensor*> liveness_new_list;
-        std::unordered_set<descriptor::Tensor*> liveness_free_list;
+        /// Temporaries computed by this node, from the lifetimes set by pass::Liveness
+        std::vector<descriptor::Tensor*> get_liveness_new_list() const;
+
+        /// Temporaries last used by this node, from the lifetimes set by pass::Liveness
+        std::vector<descriptor::Tensor*> get_liveness_free_list() const;
+
+        /// Position of this node in the ordered ops of its function, set by pass::Liveness
+        size_t get_liveness_index() const { return m_liveness_index; }
+        void set_liveness_index(size_t index) { m_liveness_index = index; }
 
         std::shared_ptr<Node> backprop_node(const std::shared_ptr<Node>& x,
                                             const std::shared_ptr<Node>& c);
@@ -215,10 +224,12 @@ namespace ngraph
         std::string m_name;
         const std::string m_unique_name;
         static std::atomic<size_t> m_next_instance_id;
+        static std::atomic<size_t> m_graph_version;
         std::deque<descriptor::Input> m_inputs;
         std::deque<descriptor::Output> m_outputs;
         std::unordered_map<Node*, autodiff::Adjoints> m_adjoint_map;
         Placement m_placement = Placement::DEFAULT;
+        size_t m_liveness_index = 0;
 
     private:
         NodeVector m_arguments;
@@ -0,0 +1,144 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <typeinfo>
+#include <unordered_map>
+
+#include "ngraph/op_cost.hpp"
+#include "ngraph/ops/avg_pool.hpp"
+#include "ngraph/ops/batch_norm.hpp"
+#include "ngraph/ops/convolution.hpp"
+#include "ngraph/ops/dot.hpp"
+#include "ngraph/ops/max_pool.hpp"
+#include "ngraph/ops/softmax.hpp"
+#include "ngraph/ops/util/arithmetic_reduction.hpp"
+#include "ngraph/ops/util/binary_elementwise_arithmetic.hpp"
+#include "ngraph/ops/util/binary_elementwise_comparison.hpp"
+#include "ngraph/ops/util/unary_elementwise_arithmetic.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static unordered_map<type_index, FlopsCounter>& get_flops_counters()
+{
+    static unordered_map<type_index, FlopsCounter> counters;
+    return counters;
+}
+
+void ngraph::register_flops_counter(const type_index& op_type, const FlopsCounter& counter)
+{
+    get_flops_counters()[op_type] = counter;
+}
+
+static size_t get_flops(const Node& node)
+{
+    auto it = get_flops_counters().find(type_index(typeid(node)));
+    if (it != get_flops_counters().end())
+    {
+        return it->second(node);
+    }
+    if (auto dot = dynamic_cast<const op::Dot*>(&node))
+    {
+        // Every output element is a dot product over the reduction axes
+        const Shape& arg0_shape = dot->get_input_shape(0);
+        size_t reduction_size = 1;
+        for (size_t i = arg0_shape.size() - dot->get_reduction_axes_count();
+             i < arg0_shape.size();
+             i++)
+        {
+            reduction_size *= arg0_shape[i];
+        }
+        return 2 * shape_size(dot->get_shape()) * reduction_size;
+    }
+    // Convolutions and their backprops all do one multiply-add per output delta element,
+    // input channel and filter tap, i.e. per delta element and filter element of one
+    // output channel
+    if (dynamic_cast<const op::Convolution*>(&node))
+    {
+        const Shape& filters_shape = node.get_input_shape(1);
+        return 2 * shape_size(node.get_shape()) * shape_size(filters_shape) / filters_shape[0];
+    }
+    if (dynamic_cast<const op::ConvolutionBackpropData*>(&node))
+    {
+        const Shape& filters_shape = node.get_input_shape(0);
+        return 2 * shape_size(node.get_input_shape(1)) * shape_size(filters_shape) /
+               filters_shape[0];
+    }
+    if (dynamic_cast<const op::ConvolutionBackpropFilters*>(&node))
+    {
+        const Shape& filters_shape = node.get_shape();
+        return 2 * shape_size(node.get_input_shape(1)) * shape_size(filters_shape) /
+               filters_shape[0];
+    }
+    if (auto pool = dynamic_cast<const op::AvgPool*>(&node))
+    {
+        return shape_size(pool->get_shape()) * shape_size(pool->get_window_shape());
+    }
+    if (auto pool = dynamic_cast<const op::AvgPoolBackprop*>(&node))
+    {
+        return shape_size(pool->get_input_shape(0)) * shape_size(pool->get_window_shape());
+    }
+    if (auto pool = dynamic_cast<const op::MaxPool*>(&node))
+    {
+        return shape_size(pool->get_shape()) * shape_size(pool->get_window_shape());
+    }
+    if (auto pool = dynamic_cast<const op::MaxPoolBackprop*>(&node))
+    {
+        return shape_size(pool->get_input_shape(1)) * shape_size(pool->get_window_shape());
+    }
+    if (dynamic_cast<const op::BatchNorm*>(&node) ||
+        dynamic_cast<const op::BatchNormBackprop*>(&node))
+    {
+        // Mean, variance, then normalize, scale and shift every element
+        return 8 * shape_size(node.get_input_shape(2));
+    }
+    if (dynamic_cast<const op::Softmax*>(&node))
+    {
+        // exp, sum and divide
+        return 3 * shape_size(node.get_shape());
+    }
+    if (dynamic_cast<const op::util::UnaryElementwiseArithmetic*>(&node) ||
+        dynamic_cast<const op::util::BinaryElementwiseArithmetic*>(&node) ||
+        dynamic_cast<const op::util::BinaryElementwiseComparison*>(&node))
+    {
+        return shape_size(node.get_input_shape(0));
+    }
+    if (dynamic_cast<const op::util::ArithmeticReduction*>(&node))
+    {
+        return shape_size(node.get_input_shape(0));
+    }
+    return 0;
+}
+
+OpCost ngraph::get_op_cost(const Node& node)
+{
+    OpCost cost{0, 0, 0};
+    if (node.is_parameter() || node.is_constant())
+    {
+        return cost;
+    }
+    for (const descriptor::Input& input : node.get_inputs())
+    {
+        const descriptor::Output& output = input.get_output();
+        cost.bytes_read += shape_size(output.get_shape()) * output.get_element_type().size();
+    }
+    for (const descriptor::Output& output : node.get_outputs())
+    {
+        cost.bytes_written += shape_size(output.get_shape()) * output.get_element_type().size();
+    }
+    cost.flops = get_flops(node);
+    return cost;
+}
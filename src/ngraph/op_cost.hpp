@@ -0,0 +1,57 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <typeindex>
+
+#include "ngraph/node.hpp"
+
+namespace ngraph
+{
+    /// \brief Analytic work of one execution of an op.
+    struct OpCost
+    {
+        /// Floating point operations, a multiply-add counting as two
+        size_t flops;
+        /// Bytes of all inputs and outputs, assuming each is touched once
+        size_t bytes_read;
+        size_t bytes_written;
+
+        size_t bytes() const { return bytes_read + bytes_written; }
+        /// \brief FLOPs per byte moved, the x axis of a roofline plot
+        double arithmetic_intensity() const
+        {
+            return bytes() == 0 ? 0.0 : static_cast<double>(flops) / bytes();
+        }
+    };
+
+    /// \brief Estimates the FLOPs and bytes moved by node from the shapes of its inputs and
+    /// outputs.
+    ///
+    /// FLOPs are counted for Dot, convolutions, pooling, batch norm, softmax, elementwise
+    /// arithmetic and comparisons, and arithmetic reductions. Other ops, such as Reshape,
+    /// Broadcast or Slice, only move data and count zero FLOPs. Backends count the FLOPs of
+    /// their own ops, such as fused ops, with register_flops_counter.
+    OpCost get_op_cost(const Node& node);
+
+    using FlopsCounter = std::function<size_t(const Node&)>;
+
+    /// \brief Makes get_op_cost count the FLOPs of ops of type op_type with counter.
+    void register_flops_counter(const std::type_index& op_type, const FlopsCounter& counter);
+}
@@ -16,17 +16,41 @@
 
 #pragma once
 
+#include <cstddef>
+#include <vector>
+
 namespace ngraph
 {
     namespace op
     {
         namespace util
         {
+            /// \brief An output of an op that may share the buffer of one of its inputs
+            struct oi_pair
+            {
+                size_t output;
+                size_t input;
+            };
+
             /// \brief Abstract base class for annotations added to graph ops
             class OpAnnotations
             {
             public:
                 OpAnnotations() {}
+                /// \brief Marks that the op may write output into the buffer of input when
+                /// the input is not used after the op. Pairs are tried in insertion order.
+                ///
+                /// "After" refers to the order of Function::get_ordered_ops, so a backend that
+                /// runs ops concurrently must not add pairs unless its schedule also makes the
+                /// other readers of the input finish before the op.
+                void add_in_place_oi_pair(const oi_pair& oi) { m_in_place_oi_pairs.push_back(oi); }
+                const std::vector<oi_pair>& get_in_place_oi_pairs() const
+                {
+                    return m_in_place_oi_pairs;
+                }
+
+            private:
+                std::vector<oi_pair> m_in_place_oi_pairs;
             };
         }
     }
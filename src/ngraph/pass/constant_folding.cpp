@@ -0,0 +1,358 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_set>
+
+#include "constant_folding.hpp"
+#include "ngraph/function.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/ops/abs.hpp"
+#include "ngraph/ops/add.hpp"
+#include "ngraph/ops/broadcast.hpp"
+#include "ngraph/ops/concat.hpp"
+#include "ngraph/ops/constant.hpp"
+#include "ngraph/ops/convert.hpp"
+#include "ngraph/ops/divide.hpp"
+#include "ngraph/ops/exp.hpp"
+#include "ngraph/ops/log.hpp"
+#include "ngraph/ops/maximum.hpp"
+#include "ngraph/ops/minimum.hpp"
+#include "ngraph/ops/multiply.hpp"
+#include "ngraph/ops/negative.hpp"
+#include "ngraph/ops/power.hpp"
+#include "ngraph/ops/relu.hpp"
+#include "ngraph/ops/reshape.hpp"
+#include "ngraph/ops/slice.hpp"
+#include "ngraph/ops/sqrt.hpp"
+#include "ngraph/ops/subtract.hpp"
+#include "ngraph/ops/sum.hpp"
+#include "ngraph/runtime/kernel/abs.hpp"
+#include "ngraph/runtime/kernel/add.hpp"
+#include "ngraph/runtime/kernel/broadcast.hpp"
+#include "ngraph/runtime/kernel/concat.hpp"
+#include "ngraph/runtime/kernel/convert.hpp"
+#include "ngraph/runtime/kernel/divide.hpp"
+#include "ngraph/runtime/kernel/exp.hpp"
+#include "ngraph/runtime/kernel/log.hpp"
+#include "ngraph/runtime/kernel/maximum.hpp"
+#include "ngraph/runtime/kernel/minimum.hpp"
+#include "ngraph/runtime/kernel/multiply.hpp"
+#include "ngraph/runtime/kernel/negate.hpp"
+#include "ngraph/runtime/kernel/power.hpp"
+#include "ngraph/runtime/kernel/relu.hpp"
+#include "ngraph/runtime/kernel/reshape.hpp"
+#include "ngraph/runtime/kernel/slice.hpp"
+#include "ngraph/runtime/kernel/sqrt.hpp"
+#include "ngraph/runtime/kernel/subtract.hpp"
+#include "ngraph/runtime/kernel/sum.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#define TI(x) type_index(typeid(x))
+
+static const unordered_set<type_index> s_foldable_ops{TI(op::Abs),
+                                                      TI(op::Add),
+                                                      TI(op::Broadcast),
+                                                      TI(op::Concat),
+                                                      TI(op::Convert),
+                                                      TI(op::Divide),
+                                                      TI(op::Exp),
+                                                      TI(op::Log),
+                                                      TI(op::Maximum),
+                                                      TI(op::Minimum),
+                                                      TI(op::Multiply),
+                                                      TI(op::Negative),
+                                                      TI(op::Power),
+                                                      TI(op::Relu),
+                                                      TI(op::Reshape),
+                                                      TI(op::Slice),
+                                                      TI(op::Sqrt),
+                                                      TI(op::Subtract),
+                                                      TI(op::Sum)};
+
+template <typename T, typename S>
+static void fold_convert(const void* arg, void* out, size_t count)
+{
+    runtime::kernel::convert<T, S>(static_cast<const T*>(arg), static_cast<S*>(out), count);
+}
+
+template <typename T>
+static void fold_convert(const element::Type& out_type, const void* arg, void* out, size_t count)
+{
+    if (out_type == element::boolean)
+    {
+        fold_convert<T, char>(arg, out, count);
+    }
+    else if (out_type == element::f32)
+    {
+        fold_convert<T, float>(arg, out, count);
+    }
+    else if (out_type == element::f64)
+    {
+        fold_convert<T, double>(arg, out, count);
+    }
+    else if (out_type == element::i8)
+    {
+        fold_convert<T, int8_t>(arg, out, count);
+    }
+    else if (out_type == element::i16)
+    {
+        fold_convert<T, int16_t>(arg, out, count);
+    }
+    else if (out_type == element::i32)
+    {
+        fold_convert<T, int32_t>(arg, out, count);
+    }
+    else if (out_type == element::i64)
+    {
+        fold_convert<T, int64_t>(arg, out, count);
+    }
+    else if (out_type == element::u8)
+    {
+        fold_convert<T, uint8_t>(arg, out, count);
+    }
+    else if (out_type == element::u16)
+    {
+        fold_convert<T, uint16_t>(arg, out, count);
+    }
+    else if (out_type == element::u32)
+    {
+        fold_convert<T, uint32_t>(arg, out, count);
+    }
+    else if (out_type == element::u64)
+    {
+        fold_convert<T, uint64_t>(arg, out, count);
+    }
+    else
+    {
+        throw ngraph_error("Unsupported element type " + out_type.c_type_string() +
+                           " in constant folding");
+    }
+}
+
+template <typename T>
+static void fold(const Node& node, const vector<const void*>& args, void* out)
+{
+    const T* arg0 = static_cast<const T*>(args[0]);
+    const T* arg1 = args.size() > 1 ? static_cast<const T*>(args[1]) : nullptr;
+    T* result = static_cast<T*>(out);
+    const Shape& arg0_shape = node.get_input_shape(0);
+    const Shape& out_shape = node.get_shape();
+    size_t count = shape_size(out_shape);
+
+    type_index type = TI(node);
+    if (type == TI(op::Abs))
+    {
+        runtime::kernel::abs<T>(arg0, result, count);
+    }
+    else if (type == TI(op::Add))
+    {
+        runtime::kernel::add<T>(arg0, arg1, result, count);
+    }
+    else if (type == TI(op::Broadcast))
+    {
+        auto broadcast = static_cast<const op::Broadcast*>(&node);
+        runtime::kernel::broadcast<T>(
+            arg0, result, arg0_shape, out_shape, broadcast->get_broadcast_axes());
+    }
+    else if (type == TI(op::Concat))
+    {
+        auto concat = static_cast<const op::Concat*>(&node);
+        vector<const T*> in_args;
+        vector<Shape> in_shapes;
+        for (size_t i = 0; i < args.size(); i++)
+        {
+            in_args.push_back(static_cast<const T*>(args[i]));
+            in_shapes.push_back(node.get_input_shape(i));
+        }
+        runtime::kernel::concat<T>(
+            in_args, result, in_shapes, out_shape, concat->get_concatenation_axis());
+    }
+    else if (type == TI(op::Convert))
+    {
+        fold_convert<T>(node.get_element_type(), arg0, out, count);
+    }
+    else if (type == TI(op::Divide))
+    {
+        runtime::kernel::divide<T>(arg0, arg1, result, count);
+    }
+    else if (type == TI(op::Exp))
+    {
+        runtime::kernel::exp<T>(arg0, result, count);
+    }
+    else if (type == TI(op::Log))
+    {
+        runtime::kernel::log<T>(arg0, result, count);
+    }
+    else if (type == TI(op::Maximum))
+    {
+        runtime::kernel::maximum<T>(arg0, arg1, result, count);
+    }
+    else if (type == TI(op::Minimum))
+    {
+        runtime::kernel::minimum<T>(arg0, arg1, result, count);
+    }
+    else if (type == TI(op::Multiply))
+    {
+        runtime::kernel::multiply<T>(arg0, arg1, result, count);
+    }
+    else if (type == TI(op::Negative))
+    {
+        runtime::kernel::negate<T>(arg0, result, count);
+    }
+    else if (type == TI(op::Power))
+    {
+        runtime::kernel::power<T>(arg0, arg1, result, count);
+    }
+    else if (type == TI(op::Relu))
+    {
+        runtime::kernel::relu<T>(arg0, result, count);
+    }
+    else if (type == TI(op::Reshape))
+    {
+        auto reshape = static_cast<const op::Reshape*>(&node);
+        runtime::kernel::reshape<T>(
+            arg0, result, arg0_shape, reshape->get_input_order(), out_shape);
+    }
+    else if (type == TI(op::Slice))
+    {
+        auto slice = static_cast<const op::Slice*>(&node);
+        runtime::kernel::slice<T>(arg0,
+                                  result,
+                                  arg0_shape,
+                                  slice->get_lower_bounds(),
+                                  slice->get_upper_bounds(),
+                                  slice->get_strides(),
+                                  out_shape);
+    }
+    else if (type == TI(op::Sqrt))
+    {
+        runtime::kernel::sqrt<T>(arg0, result, count);
+    }
+    else if (type == TI(op::Subtract))
+    {
+        runtime::kernel::subtract<T>(arg0, arg1, result, count);
+    }
+    else if (type == TI(op::Sum))
+    {
+        auto sum = static_cast<const op::Sum*>(&node);
+        runtime::kernel::sum<T>(arg0, result, arg0_shape, out_shape, sum->get_reduction_axes());
+    }
+    else
+    {
+        throw ngraph_error("Unhandled op in constant folding: " + node.description());
+    }
+}
+
+// Dispatches on the element type of the op's arguments
+static void fold(const element::Type& type,
+                 const Node& node,
+                 const vector<const void*>& args,
+                 void* out)
+{
+    if (type == element::boolean)
+    {
+        fold<char>(node, args, out);
+    }
+    else if (type == element::f32)
+    {
+        fold<float>(node, args, out);
+    }
+    else if (type == element::f64)
+    {
+        fold<double>(node, args, out);
+    }
+    else if (type == element::i8)
+    {
+        fold<int8_t>(node, args, out);
+    }
+    else if (type == element::i16)
+    {
+        fold<int16_t>(node, args, out);
+    }
+    else if (type == element::i32)
+    {
+        fold<int32_t>(node, args, out);
+    }
+    else if (type == element::i64)
+    {
+        fold<int64_t>(node, args, out);
+    }
+    else if (type == element::u8)
+    {
+        fold<uint8_t>(node, args, out);
+    }
+    else if (type == element::u16)
+    {
+        fold<uint16_t>(node, args, out);
+    }
+    else if (type == element::u32)
+    {
+        fold<uint32_t>(node, args, out);
+    }
+    else if (type == element::u64)
+    {
+        fold<uint64_t>(node, args, out);
+    }
+    else
+    {
+        throw ngraph_error("Unsupported element type " + type.c_type_string() +
+                           " in constant folding");
+    }
+}
+
+bool ngraph::pass::ConstantFolding::run_on_function(std::shared_ptr<ngraph::Function> f)
+{
+    bool replaced = false;
+    // Ops are visited in topological order, so chains of foldable ops collapse into
+    // a single constant as each one sees the constant its argument was replaced with
+    for (shared_ptr<Node> node : f->get_ordered_ops())
+    {
+        auto& n = *node;
+        NodeVector arguments = node->get_input_ops();
+        if (s_foldable_ops.find(TI(n)) == s_foldable_ops.end() || arguments.empty())
+        {
+            continue;
+        }
+
+        vector<const void*> args;
+        for (shared_ptr<Node> arg : arguments)
+        {
+            auto constant = dynamic_pointer_cast<op::Constant>(arg);
+            if (!constant || m_updatable_constants.count(constant->get_friendly_name()))
+            {
+                break;
+            }
+            args.push_back(constant->get_data_ptr());
+        }
+        if (args.size() != arguments.size())
+        {
+            continue;
+        }
+
+        const element::Type& type = node->get_element_type();
+        vector<char> data(shape_size(node->get_shape()) * type.size());
+        fold(arguments.at(0)->get_element_type(), *node, args, data.data());
+
+        NGRAPH_DEBUG << "Folding " << node->get_name() << " into a constant";
+        f->replace_node(node, make_shared<op::Constant>(type, node->get_shape(), data.data()));
+        replaced = true;
+    }
+    return replaced;
+}
@@ -0,0 +1,49 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <set>
+#include <string>
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class ConstantFolding;
+    }
+}
+
+// Evaluates ops whose arguments are all constants with the reference kernels
+// and replaces them with the resulting constant
+class ngraph::pass::ConstantFolding : public FunctionPass
+{
+public:
+    /// @param updatable_constants Friendly names of constants whose data may be replaced
+    ///        after compilation. Ops using them are not folded.
+    ConstantFolding(const std::set<std::string>& updatable_constants = {})
+        : FunctionPass()
+        , m_updatable_constants(updatable_constants)
+    {
+    }
+
+    virtual bool run_on_function(std::shared_ptr<ngraph::Function> f);
+
+private:
+    std::set<std::string> m_updatable_constants;
+};
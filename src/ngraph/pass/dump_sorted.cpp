@@ -19,6 +19,7 @@
 #include "ngraph/descriptor/input.hpp"
 #include "ngraph/descriptor/output.hpp"
 #include "ngraph/pass/dump_sorted.hpp"
+#include "ngraph/pass/liveness.hpp"
 #include "ngraph/util.hpp"
 
 using namespace std;
@@ -39,7 +40,10 @@ bool pass::DumpSorted::run_on_module(vector<shared_ptr<Function>>& functions)
             out << "=====================================================================\n";
             out << f->get_name() << " start\n";
             out << "=====================================================================\n";
-            for (const shared_ptr<Node>& node : f->get_ordered_ops())
+            list<shared_ptr<Node>> ops = f->get_ordered_ops();
+            vector<vector<descriptor::Tensor*>> live_lists = Liveness::get_live_lists(ops);
+            size_t index = 0;
+            for (const shared_ptr<Node>& node : ops)
             {
                 out << node->get_name() << "(";
                 vector<string> inputs;
@@ -58,15 +62,15 @@ bool pass::DumpSorted::run_on_module(vector<shared_ptr<Function>>& functions)
                 out << join(outputs);
                 out << "\n";
 
-                for (const descriptor::Tensor* tensor : node->liveness_live_list)
+                for (const descriptor::Tensor* tensor : live_lists[index++])
                 {
                     out << "    L " << tensor->get_name() << "\n";
                 }
-                for (const descriptor::Tensor* tensor : node->liveness_new_list)
+                for (const descriptor::Tensor* tensor : node->get_liveness_new_list())
                 {
                     out << "    N " << tensor->get_name() << "\n";
                 }
-                for (const descriptor::Tensor* tensor : node->liveness_free_list)
+                for (const descriptor::Tensor* tensor : node->get_liveness_free_list())
                 {
                     out << "    F " << tensor->get_name() << "\n";
                 }
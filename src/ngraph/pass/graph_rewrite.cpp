@@ -15,23 +15,117 @@
 *******************************************************************************/
 
 #include <algorithm>
+#include <deque>
 #include <iostream>
+#include <iterator>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "graph_rewrite.hpp"
+#include "ngraph/except.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/pattern/matcher.hpp"
 
+// Matchers that keep undoing each other's rewrites revisit the same nodes forever
+static const size_t s_max_node_visits = 256;
+
+static ngraph::NodeVector get_users(const std::shared_ptr<ngraph::Node>& node)
+{
+    ngraph::NodeVector users;
+    for (size_t i = 0; i < node->get_output_size(); ++i)
+    {
+        for (auto input : node->get_output_inputs(i))
+        {
+            users.push_back(input->get_node());
+        }
+    }
+    return users;
+}
+
 bool ngraph::pass::GraphRewrite::run_matchers_on_nodes_list(
     const std::list<std::shared_ptr<ngraph::Node>>& nodes,
     const std::vector<std::shared_ptr<pattern::Matcher>>& matchers,
     std::shared_ptr<ngraph::Function> f)
 {
+    // A pattern rooted at an op only matches nodes of the same type, so matchers are indexed
+    // by the type of their root. Label and Any roots can match any node.
+    std::unordered_map<std::type_index, std::vector<size_t>> typed_matchers;
+    std::vector<size_t> untyped_matchers;
+    for (size_t i = 0; i < matchers.size(); i++)
+    {
+        auto root = matchers[i]->pattern_node();
+        if (std::dynamic_pointer_cast<pattern::op::Label>(root) ||
+            std::dynamic_pointer_cast<pattern::op::Any>(root))
+        {
+            untyped_matchers.push_back(i);
+        }
+        else
+        {
+            auto& r = *root;
+            typed_matchers[std::type_index(typeid(r))].push_back(i);
+        }
+    }
+
+    // Nodes are visited in topological order first. Whenever a callback rewrites the graph, the
+    // users of the match root and their new arguments are revisited, so that patterns formed by
+    // a rewrite are picked up within the same pass.
+    std::deque<std::shared_ptr<ngraph::Node>> worklist(nodes.begin(), nodes.end());
+    std::unordered_set<ngraph::Node*> queued;
+    for (auto& node : nodes)
+    {
+        queued.insert(node.get());
+    }
+    auto enqueue = [&](const std::shared_ptr<ngraph::Node>& node) {
+        if (queued.insert(node.get()).second)
+        {
+            worklist.push_back(node);
+        }
+    };
+
     bool rewritten = false;
-    for (auto node : nodes)
+    std::vector<size_t> candidates;
+    std::unordered_map<ngraph::Node*, size_t> visits;
+    while (!worklist.empty())
     {
-        for (auto matcher : matchers)
+        auto node = worklist.front();
+        worklist.pop_front();
+        queued.erase(node.get());
+        if (++visits[node.get()] > s_max_node_visits)
+        {
+            throw ngraph_error("GraphRewrite revisited " + node->get_name() + " more than " +
+                               std::to_string(s_max_node_visits) +
+                               " times, matchers may be undoing each other's rewrites");
+        }
+
+        auto users = get_users(node);
+        if (users.empty() && !node->is_output())
+        {
+            // Replaced by an earlier rewrite
+            continue;
+        }
+
+        auto& n = *node;
+        auto typed = typed_matchers.find(std::type_index(typeid(n)));
+        candidates.clear();
+        if (typed == typed_matchers.end())
+        {
+            candidates = untyped_matchers;
+        }
+        else
+        {
+            // Keep the order in which matchers were added, it sets their priority
+            std::merge(typed->second.begin(),
+                       typed->second.end(),
+                       untyped_matchers.begin(),
+                       untyped_matchers.end(),
+                       std::back_inserter(candidates));
+        }
+
+        for (size_t index : candidates)
         {
+            auto matcher = matchers[index];
             NGRAPH_DEBUG << "Running matcher " << matcher << " on " << node << " , "
                          << node->get_name() << " , is_output = " << node->is_output();
             if (matcher->match(node))
@@ -39,8 +133,20 @@ bool ngraph::pass::GraphRewrite::run_matchers_on_nodes_list(
                 NGRAPH_DEBUG << "Matcher " << matcher << " matched " << node << " , "
                              << node->get_name();
                 rewritten = true;
+                size_t graph_version = ngraph::Node::get_graph_version();
                 if (matcher->process_match())
                 {
+                    if (graph_version != ngraph::Node::get_graph_version())
+                    {
+                        for (auto& user : users)
+                        {
+                            enqueue(user);
+                            for (auto& arg : user->get_input_ops())
+                            {
+                                enqueue(arg);
+                            }
+                        }
+                    }
                     break;
                 }
             }
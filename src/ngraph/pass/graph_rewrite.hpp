@@ -41,6 +41,10 @@ namespace ngraph
 /// the existing ops by providing a callback to \p Matcher object
 /// Patterns can be added by using \sa add_matcher
 /// Callbacks should use \sa replace_node to transform matched sub graphs
+/// Nodes are only offered to the matchers whose pattern root has their type, and the nodes around
+/// a rewrite are offered again, so rewrites that create new matches are applied in the same pass
+/// A node visited more than a fixed number of times, which happens when matchers undo each
+/// other's rewrites, makes the pass throw instead of looping forever
 
 class ngraph::pass::GraphRewrite : public FunctionPass
 {
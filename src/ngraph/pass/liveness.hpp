@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <list>
+#include <memory>
+#include <vector>
+
 #include "ngraph/descriptor/tensor.hpp"
 #include "ngraph/pass/pass.hpp"
 
@@ -27,12 +31,18 @@ namespace ngraph
     }
 }
 
+/// Records the lifetime of every temporary as the interval between the op computing it and the
+/// last op using it, see descriptor::Tensor::get_first_use and Node::get_liveness_free_list.
 class ngraph::pass::Liveness : public CallGraphPass
 {
 public:
     virtual bool run_on_call_graph(const std::list<std::shared_ptr<Node>>&) override;
 
+    /// Temporaries live at each of ops, which Liveness must have run on. This materializes
+    /// every live set, so it is meant for debugging and visualization only.
+    static std::vector<std::vector<descriptor::Tensor*>>
+        get_live_lists(const std::list<std::shared_ptr<Node>>& ops);
+
 private:
     bool is_temporary(const descriptor::Tensor&);
-    void validate_liveness(const std::list<Node*>& ops);
 };
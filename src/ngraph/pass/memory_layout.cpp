@@ -14,11 +14,18 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
 #include <exception>
+#include <map>
+#include <numeric>
+#include <set>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "ngraph/log.hpp"
 #include "ngraph/log.hpp"
+#include "ngraph/ops/op.hpp"
 #include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/memory_layout.hpp"
@@ -27,27 +34,275 @@
 using namespace std;
 using namespace ngraph;
 
-pass::MemoryLayout::MemoryLayout(size_t alignment)
+pass::MemoryLayout::MemoryLayout(size_t alignment, allocation_scheme scheme)
     : m_alignment(alignment)
+    , m_scheme(scheme)
 {
 }
 
+namespace
+{
+    // A region of the temporary pool, shared by a temporary and the outputs computed in place
+    // on it. Uses are indices into the ordered ops, both inclusive.
+    struct Buffer
+    {
+        size_t size;
+        size_t first_use;
+        size_t last_use;
+        size_t greedy_offset;
+        vector<descriptor::Tensor*> tensors;
+    };
+
+    // The placed buffers, indexed by lifetime so that finding the ones that overlap a
+    // lifetime only visits those, rather than every buffer placed so far. A buffer overlaps
+    // [first, last] if it is live at first, found with a segment tree over the steps, or if
+    // it starts within (first, last], found by its first use.
+    class PlacedBuffers
+    {
+    public:
+        PlacedBuffers(const vector<Buffer>& buffers, size_t step_count)
+            : m_buffers(buffers)
+            , m_step_count(step_count)
+            , m_tree(4 * max<size_t>(step_count, 1))
+        {
+        }
+
+        void insert(size_t index)
+        {
+            insert(index, 1, 0, m_step_count - 1);
+            m_by_first_use.insert({m_buffers[index].first_use, index});
+        }
+
+        template <typename F>
+        void for_each_overlapping(size_t first, size_t last, F f) const
+        {
+            size_t node = 1;
+            size_t lo = 0;
+            size_t hi = m_step_count - 1;
+            while (true)
+            {
+                for (size_t index : m_tree[node])
+                {
+                    f(index);
+                }
+                if (lo == hi)
+                {
+                    break;
+                }
+                size_t mid = (lo + hi) / 2;
+                if (first <= mid)
+                {
+                    node = 2 * node;
+                    hi = mid;
+                }
+                else
+                {
+                    node = 2 * node + 1;
+                    lo = mid + 1;
+                }
+            }
+            for (auto it = m_by_first_use.upper_bound(first);
+                 it != m_by_first_use.end() && it->first <= last;
+                 ++it)
+            {
+                f(it->second);
+            }
+        }
+
+    private:
+        void insert(size_t index, size_t node, size_t lo, size_t hi)
+        {
+            const Buffer& buffer = m_buffers[index];
+            if (buffer.last_use < lo || hi < buffer.first_use)
+            {
+                return;
+            }
+            if (buffer.first_use <= lo && hi <= buffer.last_use)
+            {
+                m_tree[node].push_back(index);
+                return;
+            }
+            size_t mid = (lo + hi) / 2;
+            insert(index, 2 * node, lo, mid);
+            insert(index, 2 * node + 1, mid + 1, hi);
+        }
+
+        const vector<Buffer>& m_buffers;
+        size_t m_step_count;
+        vector<vector<size_t>> m_tree;
+        multimap<size_t, size_t> m_by_first_use;
+    };
+}
+
+// Places the buffers largest first, each into the tightest gap left between the buffers
+// already placed whose lifetimes overlap its own
+static size_t plan_offline(const vector<Buffer>& buffers,
+                           size_t step_count,
+                           vector<size_t>& offsets)
+{
+    vector<size_t> order(buffers.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return buffers[a].size > buffers[b].size ||
+               (buffers[a].size == buffers[b].size &&
+                buffers[a].first_use < buffers[b].first_use);
+    });
+
+    offsets.assign(buffers.size(), 0);
+    if (buffers.empty())
+    {
+        return 0;
+    }
+    PlacedBuffers placed(buffers, step_count);
+    size_t pool_size = 0;
+    vector<pair<size_t, size_t>> conflicts;
+    for (size_t index : order)
+    {
+        const Buffer& buffer = buffers[index];
+        conflicts.clear();
+        placed.for_each_overlapping(buffer.first_use, buffer.last_use, [&](size_t other) {
+            conflicts.push_back({offsets[other], offsets[other] + buffers[other].size});
+        });
+        sort(conflicts.begin(), conflicts.end());
+
+        size_t best_offset = numeric_limits<size_t>::max();
+        size_t best_gap = numeric_limits<size_t>::max();
+        size_t gap_start = 0;
+        for (const pair<size_t, size_t>& conflict : conflicts)
+        {
+            if (conflict.first > gap_start)
+            {
+                size_t gap = conflict.first - gap_start;
+                if (gap >= buffer.size && gap < best_gap)
+                {
+                    best_gap = gap;
+                    best_offset = gap_start;
+                }
+            }
+            gap_start = max(gap_start, conflict.second);
+        }
+        if (best_offset == numeric_limits<size_t>::max())
+        {
+            best_offset = gap_start;
+        }
+
+        offsets[index] = best_offset;
+        pool_size = max(pool_size, best_offset + buffer.size);
+        placed.insert(index);
+    }
+    return pool_size;
+}
+
+static size_t get_lower_bound(const vector<Buffer>& buffers, size_t step_count)
+{
+    vector<size_t> allocated(step_count + 1, 0);
+    vector<size_t> freed(step_count + 1, 0);
+    for (const Buffer& buffer : buffers)
+    {
+        allocated[buffer.first_use] += buffer.size;
+        freed[buffer.last_use] += buffer.size;
+    }
+    size_t live = 0;
+    size_t lower_bound = 0;
+    for (size_t step = 0; step <= step_count; step++)
+    {
+        live += allocated[step];
+        lower_bound = max(lower_bound, live);
+        live -= freed[step];
+    }
+    return lower_bound;
+}
+
 bool pass::MemoryLayout::run_on_function(shared_ptr<ngraph::Function> function)
 {
+    vector<Buffer> buffers;
+    unordered_map<const descriptor::Tensor*, size_t> buffer_index;
+    // The offline planner only needs the lifetimes, so the greedy placement is skipped for it
+    bool greedy = m_scheme != allocation_scheme::OFFLINE;
     MemoryManager mm(m_alignment);
+    size_t step = 0;
     for (shared_ptr<Node> node : function->get_ordered_ops())
     {
-        for (descriptor::Tensor* tensor : node->liveness_new_list)
+        // An output may take over the buffer of an input that dies at this op when the
+        // backend has marked the pair as safe to run in place
+        map<descriptor::Tensor*, descriptor::Tensor*> in_place_outputs;
+        set<const descriptor::Tensor*> reused_inputs;
+        if (auto op = dynamic_pointer_cast<op::Op>(node))
+        {
+            if (auto op_annotations = op->get_op_annotations())
+            {
+                for (const op::util::oi_pair& oi : op_annotations->get_in_place_oi_pairs())
+                {
+                    descriptor::Tensor* output = &node->get_output_tensor(oi.output);
+                    descriptor::Tensor* input = &node->get_inputs().at(oi.input).get_tensor();
+                    if (output->has_liveness() && input->has_liveness() &&
+                        input->get_last_use() == node->get_liveness_index() &&
+                        !in_place_outputs.count(output) && !reused_inputs.count(input) &&
+                        output->size() == input->size())
+                    {
+                        in_place_outputs[output] = input;
+                        reused_inputs.insert(input);
+                    }
+                }
+            }
+        }
+
+        for (descriptor::Tensor* tensor : node->get_liveness_new_list())
+        {
+            size_t index;
+            auto it = in_place_outputs.find(tensor);
+            if (it != in_place_outputs.end())
+            {
+                index = buffer_index.at(it->second);
+            }
+            else
+            {
+                index = buffers.size();
+                size_t size = MemoryManager::align(tensor->size(), m_alignment);
+                buffers.push_back({size, step, step, greedy ? mm.allocate(size) : 0, {}});
+            }
+            buffers[index].tensors.push_back(tensor);
+            buffer_index[tensor] = index;
+        }
+        for (const descriptor::Tensor* tensor : node->get_liveness_free_list())
+        {
+            Buffer& buffer = buffers[buffer_index.at(tensor)];
+            buffer.last_use = step;
+            if (greedy && !reused_inputs.count(tensor))
+            {
+                mm.free(buffer.greedy_offset);
+            }
+        }
+        step++;
+    }
+
+    vector<size_t> offsets(buffers.size());
+    size_t pool_size = 0;
+    if (greedy)
+    {
+        pool_size = mm.max_allocated();
+        for (size_t i = 0; i < buffers.size(); i++)
         {
-            size_t offset = mm.allocate(tensor->size());
-            tensor->set_pool_offset(offset);
+            offsets[i] = buffers[i].greedy_offset;
         }
-        for (const descriptor::Tensor* tensor : node->liveness_free_list)
+    }
+    else
+    {
+        pool_size = plan_offline(buffers, step, offsets);
+    }
+
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        for (descriptor::Tensor* tensor : buffers[i].tensors)
         {
-            mm.free(tensor->get_pool_offset());
+            tensor->set_pool_offset(offsets[i]);
         }
     }
-    function->set_temporary_pool_size(mm.max_allocated());
+    size_t lower_bound = get_lower_bound(buffers, step);
+    function->set_temporary_pool_size(pool_size);
+    function->set_temporary_pool_lower_bound(lower_bound);
+    NGRAPH_DEBUG << "MemoryLayout " << function->get_name() << ": temporary pool of "
+                 << pool_size << " bytes, lower bound " << lower_bound << " bytes";
 
     return false;
 }
@@ -65,6 +320,8 @@ pass::MemoryManager::MemoryManager(size_t alignment)
 {
     // assert(m_base_offset % m_alignment == 0);
     m_node_list.emplace_back(numeric_limits<size_t>::max(), block_state::FREE);
+    m_offset_index[0] = m_node_list.begin();
+    m_free_index.insert({numeric_limits<size_t>::max(), 0});
 }
 
 size_t pass::MemoryManager::allocate(size_t size)
@@ -81,73 +338,43 @@ size_t pass::MemoryManager::allocate(size_t size)
 size_t pass::MemoryManager::best_fit(size_t size)
 {
     size = align(size, m_alignment);
-    size_t offset = 0;
-    size_t min_delta = numeric_limits<size_t>::max();
-    auto best_fit = m_node_list.end();
-    size_t best_offset = offset;
-    for (auto it = m_node_list.begin(); it != m_node_list.end(); ++it)
-    {
-        if (it->m_state == block_state::FREE && it->m_size >= size)
-        {
-            size_t delta = it->m_size - size;
-            if (delta < min_delta)
-            {
-                min_delta = delta;
-                best_fit = it;
-                best_offset = offset;
-            }
-        }
-        offset += it->m_size;
-    }
-
-    if (best_fit == m_node_list.end())
+    // The smallest free block that fits, the one with the lowest offset among equals
+    auto best_fit = m_free_index.lower_bound({size, 0});
+    if (best_fit == m_free_index.end())
     {
         throw bad_alloc();
     }
-
-    if (min_delta == 0)
-    {
-        // exact fit
-        best_fit->m_state = block_state::ALLOCATED;
-    }
-    else
-    {
-        m_node_list.insert(best_fit, node{size, block_state::ALLOCATED});
-        best_fit->m_size -= size;
-    }
-    m_max_allocated = max(m_max_allocated, best_offset + size);
-
-    return best_offset;
+    size_t offset = best_fit->second;
+    return allocate_block(m_offset_index.at(offset), offset, size);
 }
 
 size_t pass::MemoryManager::first_fit(size_t size)
 {
     size = align(size, m_alignment);
-    size_t offset = 0;
-    bool found = false;
-    for (auto it = m_node_list.begin(); it != m_node_list.end(); ++it)
+    for (const auto& block : m_offset_index)
     {
-        if (it->m_state == block_state::FREE && it->m_size >= size)
+        if (block.second->m_state == block_state::FREE && block.second->m_size >= size)
         {
-            if (it->m_size > size)
-            {
-                m_node_list.insert(it, node{size, block_state::ALLOCATED});
-                it->m_size -= size;
-            }
-            else
-            {
-                // exact fit
-                it->m_state = block_state::ALLOCATED;
-            }
-
-            found = true;
-            break;
+            return allocate_block(block.second, block.first, size);
         }
-        offset += it->m_size;
     }
-    if (!found)
+    throw bad_alloc();
+}
+
+size_t pass::MemoryManager::allocate_block(list<node>::iterator it, size_t offset, size_t size)
+{
+    m_free_index.erase({it->m_size, offset});
+    if (it->m_size == size)
     {
-        throw bad_alloc();
+        // exact fit
+        it->m_state = block_state::ALLOCATED;
+    }
+    else
+    {
+        m_offset_index[offset] = m_node_list.insert(it, node{size, block_state::ALLOCATED});
+        it->m_size -= size;
+        m_offset_index[offset + size] = it;
+        m_free_index.insert({it->m_size, offset + size});
     }
     m_max_allocated = max(m_max_allocated, offset + size);
 
@@ -156,44 +383,41 @@ size_t pass::MemoryManager::first_fit(size_t size)
 
 void pass::MemoryManager::free(size_t offset)
 {
-    size_t search_offset = 0;
-    bool found = false;
-    for (auto it = m_node_list.begin(); it != m_node_list.end(); ++it)
+    auto block = m_offset_index.find(offset);
+    if (block == m_offset_index.end())
+    {
+        throw runtime_error("bad free");
+    }
+    list<node>::iterator it = block->second;
+    if (it->m_state == block_state::FREE)
     {
-        if (offset == search_offset)
+        m_free_index.erase({it->m_size, offset});
+    }
+    if (it != m_node_list.begin())
+    {
+        // node has predecessor
+        list<node>::iterator it_prev = prev(it);
+        if (it_prev->m_state == block_state::FREE)
         {
-            list<node>::iterator it_next = next(it);
-            if (it == m_node_list.begin())
-            {
-                // free the first node in the list
-                it->m_state = block_state::FREE;
-            }
-            else
-            {
-                // node has predecessor
-                list<node>::iterator it_prev = prev(it);
-                if (it_prev->m_state == block_state::FREE)
-                {
-                    it->m_size += it_prev->m_size;
-                    m_node_list.erase(it_prev);
-                }
-            }
-            if (it_next != m_node_list.end() && it_next->m_state == block_state::FREE)
-            {
-                // join this node with next
-                it->m_size += it_next->m_size;
-                m_node_list.erase(it_next);
-            }
-            it->m_state = block_state::FREE;
-            found = true;
-            break;
+            m_offset_index.erase(offset);
+            offset -= it_prev->m_size;
+            m_free_index.erase({it_prev->m_size, offset});
+            m_offset_index[offset] = it;
+            it->m_size += it_prev->m_size;
+            m_node_list.erase(it_prev);
         }
-        search_offset += it->m_size;
     }
-    if (!found)
+    list<node>::iterator it_next = next(it);
+    if (it_next != m_node_list.end() && it_next->m_state == block_state::FREE)
     {
-        throw runtime_error("bad free");
+        // join this node with next
+        m_free_index.erase({it_next->m_size, offset + it->m_size});
+        m_offset_index.erase(offset + it->m_size);
+        it->m_size += it_next->m_size;
+        m_node_list.erase(it_next);
     }
+    it->m_state = block_state::FREE;
+    m_free_index.insert({it->m_size, offset});
 }
 
 void pass::MemoryManager::dump(ostream& out)
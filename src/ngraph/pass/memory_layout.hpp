@@ -18,7 +18,10 @@
 
 #include <limits>
 #include <list>
+#include <map>
+#include <set>
 #include <sstream>
+#include <utility>
 
 #include "ngraph/pass/pass.hpp"
 
@@ -35,11 +38,21 @@ namespace ngraph
 class ngraph::pass::MemoryLayout : public FunctionPass
 {
 public:
-    MemoryLayout(size_t alignment = 1);
+    /// GREEDY places tensors in execution order as they become live, using MemoryManager.
+    /// OFFLINE plans with the lifetimes of all tensors known up front, placing the largest
+    /// first. Both record the liveness lower bound of the pool on the function.
+    enum class allocation_scheme
+    {
+        GREEDY,
+        OFFLINE
+    };
+
+    MemoryLayout(size_t alignment = 1, allocation_scheme scheme = allocation_scheme::GREEDY);
     bool run_on_function(std::shared_ptr<ngraph::Function>) override;
 
 private:
     size_t m_alignment;
+    allocation_scheme m_scheme;
 };
 
 class ngraph::pass::MemoryManager
@@ -86,8 +99,12 @@ public:
 private:
     size_t first_fit(size_t size);
     size_t best_fit(size_t size);
+    size_t allocate_block(std::list<node>::iterator it, size_t offset, size_t size);
 
     std::list<node> m_node_list;
+    // Every block by offset, and the free blocks by size then offset for best fit
+    std::map<size_t, std::list<node>::iterator> m_offset_index;
+    std::set<std::pair<size_t, size_t>> m_free_index;
     size_t m_alignment;
     allocation_scheme m_scheme;
     size_t m_max_allocated;
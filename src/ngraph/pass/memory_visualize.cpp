@@ -24,6 +24,7 @@
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/node.hpp"
+#include "ngraph/pass/liveness.hpp"
 #include "ngraph/util.hpp"
 
 using namespace std;
@@ -66,7 +67,10 @@ bool pass::MemoryVisualize::run_on_module(vector<shared_ptr<ngraph::Function>>&
             size_t temp_max_size = 0;
             for (shared_ptr<Node> node : nodes)
             {
-                tensors.insert(node->liveness_live_list.begin(), node->liveness_live_list.end());
+                for (descriptor::Tensor* tensor : node->get_liveness_new_list())
+                {
+                    tensors.insert(tensor);
+                }
             }
             for (descriptor::Tensor* tensor : tensors)
             {
@@ -102,10 +106,12 @@ shared_ptr<Node> pass::MemoryVisualize::find_largest_op(const list<shared_ptr<No
 {
     shared_ptr<Node> largest_op = nullptr;
     size_t largest_size = 0;
+    vector<vector<descriptor::Tensor*>> live_lists = Liveness::get_live_lists(nodes);
+    size_t i = 0;
     for (shared_ptr<Node> exop : nodes)
     {
         size_t size = 0;
-        for (const descriptor::Tensor* tensor : exop->liveness_live_list)
+        for (const descriptor::Tensor* tensor : live_lists[i++])
         {
             size += tensor->size();
         }
@@ -125,9 +131,17 @@ void pass::MemoryVisualize::draw_tensor_weight(ostream& file, const list<shared_
     if (largest_op)
     {
         unordered_set<descriptor::Tensor*> largest_live;
-        for (descriptor::Tensor* tensor : largest_op->liveness_live_list)
+        size_t largest_index = largest_op->get_liveness_index();
+        for (shared_ptr<Node> exop : nodes)
         {
-            largest_live.insert(tensor);
+            for (descriptor::Tensor* tensor : exop->get_liveness_new_list())
+            {
+                if (tensor->get_first_use() <= largest_index &&
+                    largest_index <= tensor->get_last_use())
+                {
+                    largest_live.insert(tensor);
+                }
+            }
         }
 
         unordered_map<const descriptor::Tensor*, size_t> age_list;
@@ -143,12 +157,12 @@ void pass::MemoryVisualize::draw_tensor_weight(ostream& file, const list<shared_
         size_t i = 0;
         for (shared_ptr<Node> exop : nodes)
         {
-            for (const descriptor::Tensor* tensor : exop->liveness_new_list)
+            for (const descriptor::Tensor* tensor : exop->get_liveness_new_list())
             {
                 age_list[tensor] = i;
                 generator_op[tensor] = exop;
             }
-            for (const descriptor::Tensor* tensor : exop->liveness_free_list)
+            for (const descriptor::Tensor* tensor : exop->get_liveness_free_list())
             {
                 size_t start = age_list[tensor];
                 age_list[tensor] = (i - start);
@@ -252,14 +266,14 @@ int pass::MemoryVisualize::compute_op_weight(const shared_ptr<Node> exop)
     //     tensor = output_decl.tensor
     //     if tensor.is_persistent is False:
     //         mass -= tensor->size()
-    for (const descriptor::Tensor* tensor : exop->liveness_new_list)
+    for (const descriptor::Tensor* tensor : exop->get_liveness_new_list())
     {
         if (tensor->is_persistent() == false)
         {
             mass += tensor->size();
         }
     }
-    for (const descriptor::Tensor* tensor : exop->liveness_free_list)
+    for (const descriptor::Tensor* tensor : exop->get_liveness_free_list())
     {
         if (tensor->is_persistent() == false)
         {
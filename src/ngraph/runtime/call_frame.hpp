@@ -31,20 +31,38 @@ namespace ngraph
         class PerformanceCounter
         {
         public:
-            PerformanceCounter(const char* n, size_t us, size_t calls)
+            PerformanceCounter(const char* n,
+                               size_t us,
+                               size_t calls,
+                               size_t cycles = 0,
+                               size_t instructions = 0,
+                               size_t cache_misses = 0)
                 : m_name(n)
                 , m_total_microseconds(us)
                 , m_call_count(calls)
+                , m_total_cycles(cycles)
+                , m_total_instructions(instructions)
+                , m_total_cache_misses(cache_misses)
             {
             }
             const std::string& name() const { return m_name; }
             size_t total_microseconds() const { return m_total_microseconds; }
             size_t microseconds() const { return m_total_microseconds / m_call_count; }
             size_t call_count() const { return m_call_count; }
+            /// @brief Hardware counts summed over all calls, zero if the backend or host
+            /// does not provide them. They cover the thread that ran the op and, depending
+            /// on the backend, threads it started; they may be estimates scaled for counter
+            /// multiplexing. See runtime::cpu::HardwareCounters for the CPU backend.
+            size_t total_cycles() const { return m_total_cycles; }
+            size_t total_instructions() const { return m_total_instructions; }
+            size_t total_cache_misses() const { return m_total_cache_misses; }
         private:
             std::string m_name;
             size_t m_total_microseconds;
             size_t m_call_count;
+            size_t m_total_cycles;
+            size_t m_total_instructions;
+            size_t m_total_cache_misses;
         };
 
         // A VM for executing lightly-compiled graph functions.
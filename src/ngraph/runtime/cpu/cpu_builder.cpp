@@ -0,0 +1,1067 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ngraph/ops/abs.hpp"
+#include "ngraph/ops/acos.hpp"
+#include "ngraph/ops/add.hpp"
+#include "ngraph/ops/asin.hpp"
+#include "ngraph/ops/atan.hpp"
+#include "ngraph/ops/avg_pool.hpp"
+#include "ngraph/ops/broadcast.hpp"
+#include "ngraph/ops/ceiling.hpp"
+#include "ngraph/ops/concat.hpp"
+#include "ngraph/ops/convert.hpp"
+#include "ngraph/ops/convolution.hpp"
+#include "ngraph/ops/cos.hpp"
+#include "ngraph/ops/cosh.hpp"
+#include "ngraph/ops/divide.hpp"
+#include "ngraph/ops/dot.hpp"
+#include "ngraph/ops/equal.hpp"
+#include "ngraph/ops/exp.hpp"
+#include "ngraph/ops/floor.hpp"
+#include "ngraph/ops/greater.hpp"
+#include "ngraph/ops/greater_eq.hpp"
+#include "ngraph/ops/less.hpp"
+#include "ngraph/ops/less_eq.hpp"
+#include "ngraph/ops/log.hpp"
+#include "ngraph/ops/max.hpp"
+#include "ngraph/ops/max_pool.hpp"
+#include "ngraph/ops/maximum.hpp"
+#include "ngraph/ops/min.hpp"
+#include "ngraph/ops/minimum.hpp"
+#include "ngraph/ops/multiply.hpp"
+#include "ngraph/ops/negative.hpp"
+#include "ngraph/ops/not.hpp"
+#include "ngraph/ops/not_equal.hpp"
+#include "ngraph/ops/one_hot.hpp"
+#include "ngraph/ops/pad.hpp"
+#include "ngraph/ops/power.hpp"
+#include "ngraph/ops/product.hpp"
+#include "ngraph/ops/relu.hpp"
+#include "ngraph/ops/reshape.hpp"
+#include "ngraph/ops/result.hpp"
+#include "ngraph/ops/reverse.hpp"
+#include "ngraph/ops/select.hpp"
+#include "ngraph/ops/sign.hpp"
+#include "ngraph/ops/sin.hpp"
+#include "ngraph/ops/sinh.hpp"
+#include "ngraph/ops/slice.hpp"
+#include "ngraph/ops/softmax.hpp"
+#include "ngraph/ops/sqrt.hpp"
+#include "ngraph/ops/subtract.hpp"
+#include "ngraph/ops/sum.hpp"
+#include "ngraph/ops/tan.hpp"
+#include "ngraph/ops/tanh.hpp"
+#include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/kernel/abs.hpp"
+#include "ngraph/runtime/kernel/acos.hpp"
+#include "ngraph/runtime/kernel/add.hpp"
+#include "ngraph/runtime/kernel/asin.hpp"
+#include "ngraph/runtime/kernel/atan.hpp"
+#include "ngraph/runtime/kernel/avg_pool.hpp"
+#include "ngraph/runtime/kernel/broadcast.hpp"
+#include "ngraph/runtime/kernel/ceiling.hpp"
+#include "ngraph/runtime/kernel/concat.hpp"
+#include "ngraph/runtime/kernel/convert.hpp"
+#include "ngraph/runtime/kernel/convolution.hpp"
+#include "ngraph/runtime/kernel/cos.hpp"
+#include "ngraph/runtime/kernel/cosh.hpp"
+#include "ngraph/runtime/kernel/divide.hpp"
+#include "ngraph/runtime/kernel/dot.hpp"
+#include "ngraph/runtime/kernel/equal.hpp"
+#include "ngraph/runtime/kernel/exp.hpp"
+#include "ngraph/runtime/kernel/floor.hpp"
+#include "ngraph/runtime/kernel/greater.hpp"
+#include "ngraph/runtime/kernel/greater_eq.hpp"
+#include "ngraph/runtime/kernel/less.hpp"
+#include "ngraph/runtime/kernel/less_eq.hpp"
+#include "ngraph/runtime/kernel/log.hpp"
+#include "ngraph/runtime/kernel/max.hpp"
+#include "ngraph/runtime/kernel/max_pool.hpp"
+#include "ngraph/runtime/kernel/maximum.hpp"
+#include "ngraph/runtime/kernel/min.hpp"
+#include "ngraph/runtime/kernel/minimum.hpp"
+#include "ngraph/runtime/kernel/multiply.hpp"
+#include "ngraph/runtime/kernel/negate.hpp"
+#include "ngraph/runtime/kernel/not.hpp"
+#include "ngraph/runtime/kernel/not_equal.hpp"
+#include "ngraph/runtime/kernel/one_hot.hpp"
+#include "ngraph/runtime/kernel/pad.hpp"
+#include "ngraph/runtime/kernel/power.hpp"
+#include "ngraph/runtime/kernel/product.hpp"
+#include "ngraph/runtime/kernel/relu.hpp"
+#include "ngraph/runtime/kernel/reshape.hpp"
+#include "ngraph/runtime/kernel/reverse.hpp"
+#include "ngraph/runtime/kernel/select.hpp"
+#include "ngraph/runtime/kernel/sign.hpp"
+#include "ngraph/runtime/kernel/sin.hpp"
+#include "ngraph/runtime/kernel/sinh.hpp"
+#include "ngraph/runtime/kernel/slice.hpp"
+#include "ngraph/runtime/kernel/softmax.hpp"
+#include "ngraph/runtime/kernel/sqrt.hpp"
+#include "ngraph/runtime/kernel/subtract.hpp"
+#include "ngraph/runtime/kernel/sum.hpp"
+#include "ngraph/runtime/kernel/tan.hpp"
+#include "ngraph/runtime/kernel/tanh.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Returns BUILDER<T>(...) for the C++ type T of element type ET
+#define SELECT_BUILDER(ET, BUILDER, ...)                                                           \
+    if (ET == element::boolean)                                                                    \
+    {                                                                                              \
+        return BUILDER<char>(__VA_ARGS__);                                                         \
+    }                                                                                              \
+    else if (ET == element::f32)                                                                   \
+    {                                                                                              \
+        return BUILDER<float>(__VA_ARGS__);                                                        \
+    }                                                                                              \
+    else if (ET == element::f64)                                                                   \
+    {                                                                                              \
+        return BUILDER<double>(__VA_ARGS__);                                                       \
+    }                                                                                              \
+    else if (ET == element::i8)                                                                    \
+    {                                                                                              \
+        return BUILDER<int8_t>(__VA_ARGS__);                                                       \
+    }                                                                                              \
+    else if (ET == element::i16)                                                                   \
+    {                                                                                              \
+        return BUILDER<int16_t>(__VA_ARGS__);                                                      \
+    }                                                                                              \
+    else if (ET == element::i32)                                                                   \
+    {                                                                                              \
+        return BUILDER<int32_t>(__VA_ARGS__);                                                      \
+    }                                                                                              \
+    else if (ET == element::i64)                                                                   \
+    {                                                                                              \
+        return BUILDER<int64_t>(__VA_ARGS__);                                                      \
+    }                                                                                              \
+    else if (ET == element::u8)                                                                    \
+    {                                                                                              \
+        return BUILDER<uint8_t>(__VA_ARGS__);                                                      \
+    }                                                                                              \
+    else if (ET == element::u16)                                                                   \
+    {                                                                                              \
+        return BUILDER<uint16_t>(__VA_ARGS__);                                                     \
+    }                                                                                              \
+    else if (ET == element::u32)                                                                   \
+    {                                                                                              \
+        return BUILDER<uint32_t>(__VA_ARGS__);                                                     \
+    }                                                                                              \
+    else if (ET == element::u64)                                                                   \
+    {                                                                                              \
+        return BUILDER<uint64_t>(__VA_ARGS__);                                                     \
+    }                                                                                              \
+    throw ngraph_error("Unsupported element type " + ET.c_type_string() + " in CPU builder");
+
+// Like SELECT_BUILDER, for builders that take the kernel instantiated for T as first argument
+#define SELECT_KERNEL_BUILDER(ET, BUILDER, KERNEL, ...)                                            \
+    if (ET == element::boolean)                                                                    \
+    {                                                                                              \
+        return BUILDER<char>(KERNEL<char>, __VA_ARGS__);                                           \
+    }                                                                                              \
+    else if (ET == element::f32)                                                                   \
+    {                                                                                              \
+        return BUILDER<float>(KERNEL<float>, __VA_ARGS__);                                         \
+    }                                                                                              \
+    else if (ET == element::f64)                                                                   \
+    {                                                                                              \
+        return BUILDER<double>(KERNEL<double>, __VA_ARGS__);                                       \
+    }                                                                                              \
+    else if (ET == element::i8)                                                                    \
+    {                                                                                              \
+        return BUILDER<int8_t>(KERNEL<int8_t>, __VA_ARGS__);                                       \
+    }                                                                                              \
+    else if (ET == element::i16)                                                                   \
+    {                                                                                              \
+        return BUILDER<int16_t>(KERNEL<int16_t>, __VA_ARGS__);                                     \
+    }                                                                                              \
+    else if (ET == element::i32)                                                                   \
+    {                                                                                              \
+        return BUILDER<int32_t>(KERNEL<int32_t>, __VA_ARGS__);                                     \
+    }                                                                                              \
+    else if (ET == element::i64)                                                                   \
+    {                                                                                              \
+        return BUILDER<int64_t>(KERNEL<int64_t>, __VA_ARGS__);                                     \
+    }                                                                                              \
+    else if (ET == element::u8)                                                                    \
+    {                                                                                              \
+        return BUILDER<uint8_t>(KERNEL<uint8_t>, __VA_ARGS__);                                     \
+    }                                                                                              \
+    else if (ET == element::u16)                                                                   \
+    {                                                                                              \
+        return BUILDER<uint16_t>(KERNEL<uint16_t>, __VA_ARGS__);                                   \
+    }                                                                                              \
+    else if (ET == element::u32)                                                                   \
+    {                                                                                              \
+        return BUILDER<uint32_t>(KERNEL<uint32_t>, __VA_ARGS__);                                   \
+    }                                                                                              \
+    else if (ET == element::u64)                                                                   \
+    {                                                                                              \
+        return BUILDER<uint64_t>(KERNEL<uint64_t>, __VA_ARGS__);                                   \
+    }                                                                                              \
+    throw ngraph_error("Unsupported element type " + ET.c_type_string() + " in CPU builder");
+
+#define BUILD_UNARY_ELEMENTWISE(KERNEL)                                                            \
+    SELECT_KERNEL_BUILDER(args[0].get_element_type(),                                              \
+                          build_unary,                                                             \
+                          KERNEL,                                                                  \
+                          external_function->get_tensor_location(args[0].get_name()),              \
+                          external_function->get_tensor_location(out[0].get_name()),               \
+                          out[0].get_size())
+
+#define BUILD_BINARY_ELEMENTWISE(KERNEL)                                                           \
+    SELECT_KERNEL_BUILDER(args[0].get_element_type(),                                              \
+                          build_binary,                                                            \
+                          KERNEL,                                                                  \
+                          external_function->get_tensor_location(args[0].get_name()),              \
+                          external_function->get_tensor_location(args[1].get_name()),              \
+                          external_function->get_tensor_location(out[0].get_name()),               \
+                          out[0].get_size())
+
+#define BUILD_COMPARISON(KERNEL)                                                                   \
+    SELECT_KERNEL_BUILDER(args[0].get_element_type(),                                              \
+                          build_comparison,                                                        \
+                          KERNEL,                                                                  \
+                          external_function->get_tensor_location(args[0].get_name()),              \
+                          external_function->get_tensor_location(args[1].get_name()),              \
+                          external_function->get_tensor_location(out[0].get_name()),               \
+                          out[0].get_size())
+
+namespace
+{
+    using runtime::cpu::CPUKernelFunctor;
+    using runtime::cpu::CPURuntimeContext;
+    using runtime::cpu::TensorLocation;
+
+    template <typename T>
+    CPUKernelFunctor build_unary(void (*kernel)(const T*, T*, size_t),
+                                 const TensorLocation& arg,
+                                 const TensorLocation& out,
+                                 size_t count)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            kernel(static_cast<T*>(arg.get(ctx)), static_cast<T*>(out.get(ctx)), count);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_binary(void (*kernel)(const T*, const T*, T*, size_t),
+                                  const TensorLocation& arg0,
+                                  const TensorLocation& arg1,
+                                  const TensorLocation& out,
+                                  size_t count)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            kernel(static_cast<T*>(arg0.get(ctx)),
+                   static_cast<T*>(arg1.get(ctx)),
+                   static_cast<T*>(out.get(ctx)),
+                   count);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_comparison(void (*kernel)(const T*, const T*, char*, size_t),
+                                      const TensorLocation& arg0,
+                                      const TensorLocation& arg1,
+                                      const TensorLocation& out,
+                                      size_t count)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            kernel(static_cast<T*>(arg0.get(ctx)),
+                   static_cast<T*>(arg1.get(ctx)),
+                   static_cast<char*>(out.get(ctx)),
+                   count);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_select(const TensorLocation& arg0,
+                                  const TensorLocation& arg1,
+                                  const TensorLocation& arg2,
+                                  const TensorLocation& out,
+                                  size_t count)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::select<T>(static_cast<char*>(arg0.get(ctx)),
+                                       static_cast<T*>(arg1.get(ctx)),
+                                       static_cast<T*>(arg2.get(ctx)),
+                                       static_cast<T*>(out.get(ctx)),
+                                       count);
+        };
+    }
+
+    template <typename TI>
+    struct ConvertBuilder
+    {
+        template <typename TO>
+        static CPUKernelFunctor build(const TensorLocation& arg,
+                                      const TensorLocation& out,
+                                      size_t count)
+        {
+            return [=](CPURuntimeContext* ctx) {
+                runtime::kernel::convert<TI, TO>(
+                    static_cast<TI*>(arg.get(ctx)), static_cast<TO*>(out.get(ctx)), count);
+            };
+        }
+    };
+
+    template <typename TI>
+    CPUKernelFunctor build_convert(const element::Type& out_type,
+                                   const TensorLocation& arg,
+                                   const TensorLocation& out,
+                                   size_t count)
+    {
+        SELECT_BUILDER(out_type, ConvertBuilder<TI>::template build, arg, out, count);
+    }
+
+    // Kernels that reduce over, or rearrange, the axes of their argument
+    template <typename T>
+    CPUKernelFunctor build_broadcast(const TensorLocation& arg,
+                                     const TensorLocation& out,
+                                     const Shape& in_shape,
+                                     const Shape& out_shape,
+                                     const AxisSet& broadcast_axes)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::broadcast<T>(static_cast<T*>(arg.get(ctx)),
+                                          static_cast<T*>(out.get(ctx)),
+                                          in_shape,
+                                          out_shape,
+                                          broadcast_axes);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_reshape(const TensorLocation& arg,
+                                   const TensorLocation& out,
+                                   const Shape& in_shape,
+                                   const AxisVector& input_order,
+                                   const Shape& out_shape)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::reshape<T>(static_cast<T*>(arg.get(ctx)),
+                                        static_cast<T*>(out.get(ctx)),
+                                        in_shape,
+                                        input_order,
+                                        out_shape);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_slice(const TensorLocation& arg,
+                                 const TensorLocation& out,
+                                 const Shape& arg_shape,
+                                 const Coordinate& lower_bounds,
+                                 const Coordinate& upper_bounds,
+                                 const Strides& strides,
+                                 const Shape& out_shape)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::slice<T>(static_cast<T*>(arg.get(ctx)),
+                                      static_cast<T*>(out.get(ctx)),
+                                      arg_shape,
+                                      lower_bounds,
+                                      upper_bounds,
+                                      strides,
+                                      out_shape);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_concat(const vector<TensorLocation>& args,
+                                  const TensorLocation& out,
+                                  const vector<Shape>& in_shapes,
+                                  const Shape& out_shape,
+                                  size_t axis)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            vector<const T*> in_args;
+            for (const TensorLocation& arg : args)
+            {
+                in_args.push_back(static_cast<T*>(arg.get(ctx)));
+            }
+            runtime::kernel::concat<T>(
+                in_args, static_cast<T*>(out.get(ctx)), in_shapes, out_shape, axis);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_reduction(void (*kernel)(const T*,
+                                                    T*,
+                                                    const Shape&,
+                                                    const Shape&,
+                                                    const AxisSet&),
+                                     const TensorLocation& arg,
+                                     const TensorLocation& out,
+                                     const Shape& in_shape,
+                                     const Shape& out_shape,
+                                     const AxisSet& axes)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            kernel(static_cast<T*>(arg.get(ctx)),
+                   static_cast<T*>(out.get(ctx)),
+                   in_shape,
+                   out_shape,
+                   axes);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_reverse(const TensorLocation& arg,
+                                   const TensorLocation& out,
+                                   const Shape& arg_shape,
+                                   const Shape& out_shape,
+                                   const AxisSet& reversed_axes)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::reverse<T>(static_cast<T*>(arg.get(ctx)),
+                                        static_cast<T*>(out.get(ctx)),
+                                        arg_shape,
+                                        out_shape,
+                                        reversed_axes);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_one_hot(const TensorLocation& arg,
+                                   const TensorLocation& out,
+                                   const Shape& in_shape,
+                                   const Shape& out_shape,
+                                   size_t one_hot_axis)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::one_hot<T>(static_cast<T*>(arg.get(ctx)),
+                                        static_cast<T*>(out.get(ctx)),
+                                        in_shape,
+                                        out_shape,
+                                        one_hot_axis);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_pad(const TensorLocation& arg0,
+                               const TensorLocation& arg1,
+                               const TensorLocation& out,
+                               const Shape& arg0_shape,
+                               const Shape& out_shape,
+                               const Shape& padding_below,
+                               const Shape& padding_above,
+                               const Shape& padding_interior)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::pad<T>(static_cast<T*>(arg0.get(ctx)),
+                                    static_cast<T*>(arg1.get(ctx)),
+                                    static_cast<T*>(out.get(ctx)),
+                                    arg0_shape,
+                                    out_shape,
+                                    padding_below,
+                                    padding_above,
+                                    padding_interior);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_softmax(const TensorLocation& arg,
+                                   const TensorLocation& out,
+                                   const Shape& shape,
+                                   const AxisSet& axes)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::softmax<T>(
+                static_cast<T*>(arg.get(ctx)), static_cast<T*>(out.get(ctx)), shape, axes);
+        };
+    }
+
+    // Linear algebra and window kernels
+    template <typename T>
+    CPUKernelFunctor build_dot(const TensorLocation& arg0,
+                               const TensorLocation& arg1,
+                               const TensorLocation& out,
+                               const Shape& arg0_shape,
+                               const Shape& arg1_shape,
+                               const Shape& out_shape,
+                               size_t reduction_axes_count)
+    {
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::dot<T>(static_cast<T*>(arg0.get(ctx)),
+                                    static_cast<T*>(arg1.get(ctx)),
+                                    static_cast<T*>(out.get(ctx)),
+                                    arg0_shape,
+                                    arg1_shape,
+                                    out_shape,
+                                    reduction_axes_count);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_convolution(const TensorLocation& arg0,
+                                       const TensorLocation& arg1,
+                                       const TensorLocation& out,
+                                       const Shape& arg0_shape,
+                                       const Shape& arg1_shape,
+                                       const Shape& out_shape,
+                                       const ngraph::op::Convolution* convolution)
+    {
+        Strides window_movement_strides = convolution->get_window_movement_strides();
+        Strides window_dilation_strides = convolution->get_window_dilation_strides();
+        CoordinateDiff padding_below = convolution->get_padding_below();
+        CoordinateDiff padding_above = convolution->get_padding_above();
+        Strides data_dilation_strides = convolution->get_data_dilation_strides();
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::convolution<T>(static_cast<T*>(arg0.get(ctx)),
+                                            static_cast<T*>(arg1.get(ctx)),
+                                            static_cast<T*>(out.get(ctx)),
+                                            arg0_shape,
+                                            arg1_shape,
+                                            out_shape,
+                                            window_movement_strides,
+                                            window_dilation_strides,
+                                            padding_below,
+                                            padding_above,
+                                            data_dilation_strides,
+                                            0,
+                                            1,
+                                            1,
+                                            0,
+                                            0,
+                                            1,
+                                            false);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_max_pool(const TensorLocation& arg,
+                                    const TensorLocation& out,
+                                    const Shape& arg_shape,
+                                    const Shape& out_shape,
+                                    const ngraph::op::MaxPool* max_pool)
+    {
+        Shape window_shape = max_pool->get_window_shape();
+        Strides window_movement_strides = max_pool->get_window_movement_strides();
+        Shape padding_below = max_pool->get_padding_below();
+        Shape padding_above = max_pool->get_padding_above();
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::max_pool<T>(static_cast<T*>(arg.get(ctx)),
+                                         static_cast<T*>(out.get(ctx)),
+                                         arg_shape,
+                                         out_shape,
+                                         window_shape,
+                                         window_movement_strides,
+                                         padding_below,
+                                         padding_above);
+        };
+    }
+
+    template <typename T>
+    CPUKernelFunctor build_avg_pool(const TensorLocation& arg,
+                                    const TensorLocation& out,
+                                    const Shape& arg_shape,
+                                    const Shape& out_shape,
+                                    const ngraph::op::AvgPool* avg_pool)
+    {
+        Shape window_shape = avg_pool->get_window_shape();
+        Strides window_movement_strides = avg_pool->get_window_movement_strides();
+        Shape padding_below = avg_pool->get_padding_below();
+        Shape padding_above = avg_pool->get_padding_above();
+        bool include_padding = avg_pool->get_include_padding_in_avg_computation();
+        return [=](CPURuntimeContext* ctx) {
+            runtime::kernel::avg_pool<T>(static_cast<T*>(arg.get(ctx)),
+                                         static_cast<T*>(out.get(ctx)),
+                                         arg_shape,
+                                         out_shape,
+                                         window_shape,
+                                         window_movement_strides,
+                                         padding_below,
+                                         padding_above,
+                                         include_padding);
+        };
+    }
+}
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Abs)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::abs);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Acos)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::acos);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Asin)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::asin);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Atan)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::atan);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Ceiling)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::ceiling);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Cos)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::cos);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Cosh)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::cosh);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Exp)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::exp);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Floor)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::floor);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Log)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::log);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Negative)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::negate);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Relu)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::relu);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Sign)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::sign);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Sin)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::sin);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Sinh)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::sinh);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Sqrt)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::sqrt);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Tan)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::tan);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Tanh)
+            {
+                BUILD_UNARY_ELEMENTWISE(runtime::kernel::tanh);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Not)
+            {
+                auto& arg = external_function->get_tensor_location(args[0].get_name());
+                auto& result = external_function->get_tensor_location(out[0].get_name());
+                size_t count = out[0].get_size();
+                return [=](CPURuntimeContext* ctx) {
+                    runtime::kernel::logical_not(static_cast<char*>(arg.get(ctx)),
+                                                 static_cast<char*>(result.get(ctx)),
+                                                 count);
+                };
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Add)
+            {
+                BUILD_BINARY_ELEMENTWISE(runtime::kernel::add);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Subtract)
+            {
+                BUILD_BINARY_ELEMENTWISE(runtime::kernel::subtract);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Multiply)
+            {
+                BUILD_BINARY_ELEMENTWISE(runtime::kernel::multiply);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Divide)
+            {
+                BUILD_BINARY_ELEMENTWISE(runtime::kernel::divide);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Maximum)
+            {
+                BUILD_BINARY_ELEMENTWISE(runtime::kernel::maximum);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Minimum)
+            {
+                BUILD_BINARY_ELEMENTWISE(runtime::kernel::minimum);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Power)
+            {
+                BUILD_BINARY_ELEMENTWISE(runtime::kernel::power);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Equal)
+            {
+                BUILD_COMPARISON(runtime::kernel::equal);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::NotEqual)
+            {
+                BUILD_COMPARISON(runtime::kernel::not_equal);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Greater)
+            {
+                BUILD_COMPARISON(runtime::kernel::greater);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::GreaterEq)
+            {
+                BUILD_COMPARISON(runtime::kernel::greater_eq);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Less)
+            {
+                BUILD_COMPARISON(runtime::kernel::less);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::LessEq)
+            {
+                BUILD_COMPARISON(runtime::kernel::less_eq);
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Select)
+            {
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_select,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(args[1].get_name()),
+                               external_function->get_tensor_location(args[2].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               out[0].get_size());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Convert)
+            {
+                SELECT_BUILDER(args[0].get_element_type(),
+                               build_convert,
+                               out[0].get_element_type(),
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               out[0].get_size());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Broadcast)
+            {
+                auto broadcast = static_cast<const ngraph::op::Broadcast*>(node);
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_broadcast,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               args[0].get_shape(),
+                               out[0].get_shape(),
+                               broadcast->get_broadcast_axes());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Reshape)
+            {
+                auto reshape = static_cast<const ngraph::op::Reshape*>(node);
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_reshape,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               args[0].get_shape(),
+                               reshape->get_input_order(),
+                               out[0].get_shape());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Slice)
+            {
+                auto slice = static_cast<const ngraph::op::Slice*>(node);
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_slice,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               args[0].get_shape(),
+                               slice->get_lower_bounds(),
+                               slice->get_upper_bounds(),
+                               slice->get_strides(),
+                               out[0].get_shape());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Concat)
+            {
+                auto concat = static_cast<const ngraph::op::Concat*>(node);
+                vector<TensorLocation> arg_locations;
+                vector<Shape> arg_shapes;
+                for (const TensorViewWrapper& arg : args)
+                {
+                    arg_locations.push_back(external_function->get_tensor_location(arg.get_name()));
+                    arg_shapes.push_back(arg.get_shape());
+                }
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_concat,
+                               arg_locations,
+                               external_function->get_tensor_location(out[0].get_name()),
+                               arg_shapes,
+                               out[0].get_shape(),
+                               concat->get_concatenation_axis());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Sum)
+            {
+                auto sum = static_cast<const ngraph::op::Sum*>(node);
+                SELECT_KERNEL_BUILDER(out[0].get_element_type(),
+                                      build_reduction,
+                                      runtime::kernel::sum,
+                                      external_function->get_tensor_location(args[0].get_name()),
+                                      external_function->get_tensor_location(out[0].get_name()),
+                                      args[0].get_shape(),
+                                      out[0].get_shape(),
+                                      sum->get_reduction_axes());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Product)
+            {
+                auto product = static_cast<const ngraph::op::Product*>(node);
+                SELECT_KERNEL_BUILDER(out[0].get_element_type(),
+                                      build_reduction,
+                                      runtime::kernel::product,
+                                      external_function->get_tensor_location(args[0].get_name()),
+                                      external_function->get_tensor_location(out[0].get_name()),
+                                      args[0].get_shape(),
+                                      out[0].get_shape(),
+                                      product->get_reduction_axes());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Max)
+            {
+                auto max = static_cast<const ngraph::op::Max*>(node);
+                SELECT_KERNEL_BUILDER(out[0].get_element_type(),
+                                      build_reduction,
+                                      runtime::kernel::max,
+                                      external_function->get_tensor_location(args[0].get_name()),
+                                      external_function->get_tensor_location(out[0].get_name()),
+                                      args[0].get_shape(),
+                                      out[0].get_shape(),
+                                      max->get_reduction_axes());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Min)
+            {
+                auto min = static_cast<const ngraph::op::Min*>(node);
+                SELECT_KERNEL_BUILDER(out[0].get_element_type(),
+                                      build_reduction,
+                                      runtime::kernel::min,
+                                      external_function->get_tensor_location(args[0].get_name()),
+                                      external_function->get_tensor_location(out[0].get_name()),
+                                      args[0].get_shape(),
+                                      out[0].get_shape(),
+                                      min->get_reduction_axes());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Reverse)
+            {
+                auto reverse = static_cast<const ngraph::op::Reverse*>(node);
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_reverse,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               args[0].get_shape(),
+                               out[0].get_shape(),
+                               reverse->get_reversed_axes());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::OneHot)
+            {
+                auto one_hot = static_cast<const ngraph::op::OneHot*>(node);
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_one_hot,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               args[0].get_shape(),
+                               out[0].get_shape(),
+                               one_hot->get_one_hot_axis());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Pad)
+            {
+                auto pad = static_cast<const ngraph::op::Pad*>(node);
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_pad,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(args[1].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               args[0].get_shape(),
+                               out[0].get_shape(),
+                               pad->get_padding_below(),
+                               pad->get_padding_above(),
+                               pad->get_padding_interior());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Softmax)
+            {
+                auto softmax = static_cast<const ngraph::op::Softmax*>(node);
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_softmax,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               out[0].get_shape(),
+                               softmax->get_axes());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Dot)
+            {
+                auto dot = static_cast<const ngraph::op::Dot*>(node);
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_dot,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(args[1].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               args[0].get_shape(),
+                               args[1].get_shape(),
+                               out[0].get_shape(),
+                               dot->get_reduction_axes_count());
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Convolution)
+            {
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_convolution,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(args[1].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               args[0].get_shape(),
+                               args[1].get_shape(),
+                               out[0].get_shape(),
+                               static_cast<const ngraph::op::Convolution*>(node));
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::MaxPool)
+            {
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_max_pool,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               args[0].get_shape(),
+                               out[0].get_shape(),
+                               static_cast<const ngraph::op::MaxPool*>(node));
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::AvgPool)
+            {
+                SELECT_BUILDER(out[0].get_element_type(),
+                               build_avg_pool,
+                               external_function->get_tensor_location(args[0].get_name()),
+                               external_function->get_tensor_location(out[0].get_name()),
+                               args[0].get_shape(),
+                               out[0].get_shape(),
+                               static_cast<const ngraph::op::AvgPool*>(node));
+            }
+
+            template <>
+            CPUKernelFunctor CPU_Builder::BUILDER_DECL(ngraph::op::Result)
+            {
+                auto& arg = external_function->get_tensor_location(args[0].get_name());
+                auto& result = external_function->get_tensor_location(out[0].get_name());
+                // Results whose copy was elided write straight into the output
+                if (arg == result)
+                {
+                    return nullptr;
+                }
+                size_t size = out[0].get_size() * out[0].get_element_type().size();
+                return [=](CPURuntimeContext* ctx) { memcpy(result.get(ctx), arg.get(ctx), size); };
+            }
+        }
+    }
+}
@@ -18,8 +18,10 @@
 
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_hw_counters.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
-#include "ngraph/runtime/cpu/cpu_tracing.hpp"
+#include "ngraph/runtime/cpu/mkldnn_emitter.hpp"
+#include "ngraph/util.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -62,13 +64,6 @@ void runtime::cpu::CPU_CallFrame::tensor_call(
 
     // Invoke compiled computation
     m_compiled_function(inputs.data(), outputs.data(), ctx);
-
-    if (runtime::cpu::IsTracingEnabled())
-    {
-        GenerateTimeline(m_external_function->get_op_attrs(),
-                         ctx->op_durations,
-                         m_external_function->get_function_name() + ".timeline.json");
-    }
 }
 
 void runtime::cpu::CPU_CallFrame::call(
@@ -114,23 +109,20 @@ void runtime::cpu::CPU_CallFrame::propagate_layouts(
 vector<runtime::PerformanceCounter> runtime::cpu::CPU_CallFrame::get_performance_data() const
 {
     vector<runtime::PerformanceCounter> rc;
-    auto* engine = m_external_function->m_execution_engine.get();
-    if (engine)
+    const auto& names = m_external_function->get_debug_timer_names();
+    for (size_t i = 0; i < names.size(); i++)
     {
-        auto get_count = engine->find_function<size_t()>("get_debug_timer_count");
-        auto get_name = engine->find_function<const char*(size_t)>("get_debug_timer_name");
-        auto get_microseconds =
-            engine->find_function<size_t(size_t)>("get_debug_timer_microseconds");
-        auto get_call_count = engine->find_function<size_t(size_t)>("get_debug_timer_call_count");
-
-        if (get_count && get_name && get_microseconds && get_call_count)
+        HardwareCounts counts{0, 0, 0};
+        if (m_hw_counters)
         {
-            size_t count = get_count();
-            for (size_t i = 0; i < count; i++)
-            {
-                rc.push_back({get_name(i), get_microseconds(i), get_call_count(i)});
-            }
+            counts = m_hw_counters->get_counts(i);
         }
+        rc.push_back({names[i].c_str(),
+                      m_timers[i].get_total_microseconds(),
+                      m_timers[i].get_call_count(),
+                      counts.cycles,
+                      counts.instructions,
+                      counts.cache_misses});
     }
     return rc;
 }
@@ -139,18 +131,54 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context()
 {
     ctx = new CPURuntimeContext;
 
-    ctx->op_durations = nullptr;
-    if (runtime::cpu::IsTracingEnabled())
+    ctx->tracer = m_external_function->get_trace_buffer();
+    // Each call frame owns its MKLDNN primitives, scratch memory and timers so that
+    // frames of the same function can be called from different threads
+    m_mkldnn_primitives = m_external_function->get_mkldnn_emitter()->build_primitives();
+    ctx->mkldnn_primitives = m_mkldnn_primitives->primitives.data();
+    ctx->mkldnn_workspaces = m_mkldnn_primitives->workspace_bufs.data();
+
+    ctx->timers = nullptr;
+    size_t timer_count = m_external_function->get_debug_timer_names().size();
+    if (timer_count > 0)
     {
-        ctx->op_durations = new int64_t[m_external_function->get_op_attrs().size()];
+        m_timers.reset(new stopwatch[timer_count]);
+        ctx->timers = m_timers.get();
+        if (HardwareCounters::is_enabled())
+        {
+            m_hw_counters.reset(new HardwareCounters(timer_count));
+        }
+    }
+    ctx->hw_counters = m_hw_counters.get();
+    ctx->constants = m_external_function->get_constant_data().data();
+
+    ctx->memory_pool = nullptr;
+    size_t pool_size = m_external_function->get_memory_pool_size();
+    if (pool_size > 0)
+    {
+        m_memory_pool.reset(
+            new AlignedBuffer(pool_size, m_external_function->get_memory_pool_alignment()));
+        ctx->memory_pool = m_memory_pool->get_ptr();
+    }
+
+    ctx->inputs = nullptr;
+    ctx->outputs = nullptr;
+    ctx->flow_graph = nullptr;
+    if (m_external_function->m_make_flow_graph)
+    {
+        ctx->flow_graph = m_external_function->m_make_flow_graph(ctx);
     }
-    const auto& mkldnn_emitter = m_external_function->get_mkldnn_emitter();
-    ctx->mkldnn_primitives = mkldnn_emitter->get_mkldnn_primitives().data();
-    ctx->mkldnn_workspaces = mkldnn_emitter->get_mkldnn_workspaces().data();
 }
 
 void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
 {
-    delete[] ctx->op_durations;
+    if (ctx->flow_graph)
+    {
+        m_external_function->m_free_flow_graph(ctx->flow_graph);
+    }
     delete ctx;
+    m_memory_pool.reset();
+    m_mkldnn_primitives.reset();
+    m_timers.reset();
+    m_hw_counters.reset();
 }
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "ngraph/function.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
 #include "ngraph/runtime/cpu/cpu_runtime_context.hpp"
@@ -28,6 +29,8 @@
 
 namespace ngraph
 {
+    class stopwatch;
+
     namespace runtime
     {
         class PrimaryTensorView;
@@ -36,12 +39,21 @@ namespace ngraph
         {
             class CPU_CallFrame;
             class CPU_ExternalFunction;
+            class MKLDNNPrimitives;
 
             using EntryPoint_t = void(void** inputs, void** outputs, CPURuntimeContext* ctx);
 
             using EntryPoint = std::function<EntryPoint_t>;
 
+            using MakeFlowGraph_t = void*(CPURuntimeContext* ctx);
+            using FreeFlowGraph_t = void(void* flow_graph);
+
             // Compile and execute graphs
+            //
+            // A call frame is not reentrant, but different call frames of the same
+            // CPU_ExternalFunction may be called concurrently. Each frame owns all of
+            // the mutable state of an invocation: temporary memory pool, MKLDNN
+            // primitives and workspaces, debug timers and the TBB flow graph.
             class CPU_CallFrame : public ngraph::runtime::CallFrame
             {
             public:
@@ -74,6 +86,11 @@ namespace ngraph
                 std::shared_ptr<CPU_ExternalFunction> m_external_function;
                 EntryPoint m_compiled_function;
                 CPURuntimeContext* ctx;
+                // Temporary memory pool of the entry point, reused across calls
+                std::unique_ptr<AlignedBuffer> m_memory_pool;
+                std::unique_ptr<MKLDNNPrimitives> m_mkldnn_primitives;
+                std::unique_ptr<stopwatch[]> m_timers;
+                std::unique_ptr<HardwareCounters> m_hw_counters;
             };
         }
     }
@@ -17,6 +17,7 @@
 #include "ngraph/runtime/cpu/cpu_emitter.hpp"
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <numeric>
 #include <string>
 #include <typeindex>
@@ -92,6 +93,7 @@
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 #include "ngraph/runtime/cpu/ops/conv_bias.hpp"
 #include "ngraph/runtime/cpu/ops/convert_layout.hpp"
+#include "ngraph/runtime/cpu/ops/loop_kernel.hpp"
 #include "ngraph/runtime/cpu/ops/matmul_bias.hpp"
 #include "ngraph/runtime/cpu/ops/sigmoid.hpp"
 #include "ngraph/types/element_type.hpp"
@@ -121,6 +123,46 @@ static string eigen_matrix_format(const ngraph::Shape& shape, const ngraph::Stri
     return ss.str();
 }
 
+// Scalar expression for one operation of a LoopKernel body. The formulas mirror the
+// per-op loops emitted below.
+static string emit_loop_kernel_expression(const string& description, const vector<string>& x)
+{
+    static const unordered_map<string, function<string(const vector<string>&)>> expressions{
+        {"Abs", [](const vector<string>& a) { return "std::abs(" + a[0] + ")"; }},
+        {"Add", [](const vector<string>& a) { return a[0] + " + " + a[1]; }},
+        {"Ceiling", [](const vector<string>& a) { return "ceil(" + a[0] + ")"; }},
+        {"Cos", [](const vector<string>& a) { return "cos(" + a[0] + ")"; }},
+        {"Cosh", [](const vector<string>& a) { return "cosh(" + a[0] + ")"; }},
+        {"Divide", [](const vector<string>& a) { return a[0] + " / " + a[1]; }},
+        {"Exp", [](const vector<string>& a) { return "exp(" + a[0] + ")"; }},
+        {"Floor", [](const vector<string>& a) { return "floor(" + a[0] + ")"; }},
+        {"Log", [](const vector<string>& a) { return "log(" + a[0] + ")"; }},
+        {"Maximum",
+         [](const vector<string>& a) { return a[0] + " > " + a[1] + " ? " + a[0] + " : " + a[1]; }},
+        {"Minimum",
+         [](const vector<string>& a) { return a[0] + " < " + a[1] + " ? " + a[0] + " : " + a[1]; }},
+        {"Multiply", [](const vector<string>& a) { return a[0] + " * " + a[1]; }},
+        {"Negative", [](const vector<string>& a) { return "-" + a[0]; }},
+        {"Power", [](const vector<string>& a) { return "pow(" + a[0] + ", " + a[1] + ")"; }},
+        {"Relu", [](const vector<string>& a) { return a[0] + " > 0 ? " + a[0] + " : 0"; }},
+        {"Select", [](const vector<string>& a) { return a[0] + " ? " + a[1] + " : " + a[2]; }},
+        {"Sigmoid", [](const vector<string>& a) { return "1 / (1 + exp(-" + a[0] + "))"; }},
+        {"Sign", [](const vector<string>& a) { return "(0 < " + a[0] + ") - (" + a[0] + " < 0)"; }},
+        {"Sin", [](const vector<string>& a) { return "sin(" + a[0] + ")"; }},
+        {"Sinh", [](const vector<string>& a) { return "sinh(" + a[0] + ")"; }},
+        {"Sqrt", [](const vector<string>& a) { return "sqrt(" + a[0] + ")"; }},
+        {"Subtract", [](const vector<string>& a) { return a[0] + " - " + a[1]; }},
+        {"Tan", [](const vector<string>& a) { return "tan(" + a[0] + ")"; }},
+        {"Tanh", [](const vector<string>& a) { return "tanh(" + a[0] + ")"; }}};
+
+    auto it = expressions.find(description);
+    if (it == expressions.end())
+    {
+        throw ngraph_error("LoopKernel cannot emit op " + description);
+    }
+    return it->second(x);
+}
+
 namespace ngraph
 {
     namespace runtime
@@ -3201,6 +3243,45 @@ namespace ngraph
                        << to_string(reorder_index) << ");\n";
             }
 
+            template <>
+            void CPU_Emitter::EMITTER_DECL(ngraph::runtime::cpu::op::LoopKernel)
+            {
+                auto loop_kernel = static_cast<const ngraph::runtime::cpu::op::LoopKernel*>(node);
+                const auto& operations = loop_kernel->get_operations();
+                auto element_type = out[0].get_element_type().c_type_string();
+
+                writer << "{   // " << node->get_name() << "\n";
+                writer.indent++;
+                writer << "#pragma omp parallel for\n";
+                writer << "for (size_t i = 0; i < " << out[0].get_size() << "; i++)\n";
+                writer << "{\n";
+                writer.indent++;
+                for (size_t k = 0; k < operations.size(); k++)
+                {
+                    vector<string> operands;
+                    for (size_t operand : operations[k].operands)
+                    {
+                        operands.push_back(operand < args.size()
+                                               ? args[operand].get_name() + "[i]"
+                                               : "t" + to_string(operand - args.size()));
+                    }
+                    auto expression =
+                        emit_loop_kernel_expression(operations[k].description, operands);
+                    if (k + 1 < operations.size())
+                    {
+                        writer << element_type << " t" << k << " = " << expression << ";\n";
+                    }
+                    else
+                    {
+                        writer << out[0].get_name() << "[i] = " << expression << ";\n";
+                    }
+                }
+                writer.indent--;
+                writer << "}\n";
+                writer.indent--;
+                writer << "}\n";
+            }
+
             template <>
             void CPU_Emitter::EMITTER_DECL(ngraph::op::ReluBackprop)
             {
@@ -0,0 +1,323 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <dlfcn.h>
+#include <fstream>
+
+#include "ngraph/except.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/runtime/cpu/cpu_exported_function.hpp"
+#include "ngraph/runtime/cpu/cpu_hw_counters.hpp"
+#include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
+#include "ngraph/runtime/cpu/cpu_tracing.hpp"
+#include "ngraph/util.hpp"
+#include "nlohmann/json.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// feature is a name written by export_function, see s_cpu_feature_macros there
+static bool is_cpu_feature_supported(const string& feature)
+{
+    __builtin_cpu_init();
+    if (feature == "sse4.2")
+    {
+        return __builtin_cpu_supports("sse4.2");
+    }
+    if (feature == "avx")
+    {
+        return __builtin_cpu_supports("avx");
+    }
+    if (feature == "avx2")
+    {
+        return __builtin_cpu_supports("avx2");
+    }
+    if (feature == "fma")
+    {
+        return __builtin_cpu_supports("fma");
+    }
+    if (feature == "avx512f")
+    {
+        return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+}
+
+runtime::cpu::CPU_ExportedFunction::CPU_ExportedFunction(const string& directory,
+                                                         const string& function_name)
+    : m_function_name(function_name)
+    , m_library(nullptr)
+    , m_compiled_function(nullptr)
+    , m_make_flow_graph(nullptr)
+    , m_free_flow_graph(nullptr)
+{
+    string manifest_path = file_util::path_join(directory, function_name + ".json");
+    if (!file_util::exists(manifest_path))
+    {
+        throw ngraph_error("Exported function manifest " + manifest_path + " not found");
+    }
+    nlohmann::json manifest = nlohmann::json::parse(file_util::read_file_to_string(manifest_path));
+
+    m_memory_pool_size = manifest.at("memory_pool_size").get<size_t>();
+    m_memory_pool_alignment = manifest.at("memory_pool_alignment").get<size_t>();
+    for (auto& op : manifest.at("traced_ops"))
+    {
+        m_op_attrs.emplace_back(op.at("description").get<string>(),
+                                op.at("outputs").get<vector<string>>(),
+                                op.at("inputs").get<vector<string>>());
+    }
+    if (!m_op_attrs.empty() && IsTracingEnabled())
+    {
+        m_trace_buffer.reset(new TraceBuffer(GetTraceBufferSize()));
+    }
+    for (auto& parameter : manifest.at("parameters"))
+    {
+        m_parameter_shapes.push_back(parameter.at("shape").get<vector<size_t>>());
+        m_parameter_types.push_back(parameter.at("element_type").get<string>());
+    }
+    for (auto& result : manifest.at("results"))
+    {
+        m_result_shapes.push_back(result.at("shape").get<vector<size_t>>());
+        m_result_types.push_back(result.at("element_type").get<string>());
+    }
+
+    // Constants are laid out in the blob on pool alignment, so the blob can be used in
+    // place once it is read into an aligned buffer
+    auto& constants = manifest.at("constants");
+    if (!constants.empty())
+    {
+        string constant_path =
+            file_util::path_join(directory, manifest.at("constant_data").get<string>());
+        size_t blob_size = file_util::get_file_size(constant_path);
+        m_constant_buffer.initialize(blob_size, m_memory_pool_alignment);
+        ifstream in(constant_path, ios::binary);
+        in.read(static_cast<char*>(m_constant_buffer.get_ptr()), blob_size);
+        if (!in)
+        {
+            throw ngraph_error("Unable to read constant data from " + constant_path);
+        }
+        for (auto& constant : constants)
+        {
+            size_t offset = constant.at("offset").get<size_t>();
+            if (offset + constant.at("size").get<size_t>() > blob_size)
+            {
+                throw ngraph_error("Constant data for " + constant.at("name").get<string>() +
+                                   " is truncated");
+            }
+            m_constant_data.push_back(m_constant_buffer.get_ptr(offset));
+        }
+    }
+
+    // Running code built for an ISA the CPU does not implement would die on an illegal
+    // instruction somewhere in the first call
+    for (const string& feature : manifest.at("cpu_features").get<vector<string>>())
+    {
+        if (!is_cpu_feature_supported(feature))
+        {
+            throw ngraph_error("Exported function " + m_function_name + " was built for " +
+                               manifest.at("isa").get<string>() + ", which needs the " +
+                               feature + " instructions this CPU lacks");
+        }
+    }
+
+    string library_path = file_util::path_join(directory, manifest.at("library").get<string>());
+    m_library = dlopen(library_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (m_library == nullptr)
+    {
+        throw ngraph_error("Unable to load " + library_path + ": " + dlerror());
+    }
+    m_compiled_function =
+        reinterpret_cast<EntryPoint_t*>(dlsym(m_library, m_function_name.c_str()));
+    if (m_compiled_function == nullptr)
+    {
+        dlclose(m_library);
+        throw ngraph_error("could not find exported function " + m_function_name);
+    }
+
+    // Present when the function was generated with NGRAPH_CPU_USE_TBB
+    m_make_flow_graph = reinterpret_cast<MakeFlowGraph_t*>(
+        dlsym(m_library, (m_function_name + "_make_flow_graph").c_str()));
+    m_free_flow_graph = reinterpret_cast<FreeFlowGraph_t*>(
+        dlsym(m_library, (m_function_name + "_free_flow_graph").c_str()));
+}
+
+runtime::cpu::CPU_ExportedFunction::~CPU_ExportedFunction()
+{
+    if (m_trace_buffer && m_trace_buffer->get_record_count() > 0)
+    {
+        write_timeline(GetTimelinePath(m_function_name));
+    }
+    if (m_library)
+    {
+        dlclose(m_library);
+    }
+}
+
+void runtime::cpu::CPU_ExportedFunction::write_timeline(const string& file_name) const
+{
+    if (!m_trace_buffer)
+    {
+        throw ngraph_error("Function " + m_function_name +
+                           " is only traced when exported and loaded with NGRAPH_CPU_TRACING");
+    }
+    GenerateTimeline(m_op_attrs, *m_trace_buffer, file_name);
+}
+
+shared_ptr<runtime::CallFrame> runtime::cpu::CPU_ExportedFunction::make_call_frame()
+{
+    return make_shared<runtime::cpu::CPU_ExportedCallFrame>(shared_from_this());
+}
+
+runtime::cpu::CPU_ExportedCallFrame::CPU_ExportedCallFrame(
+    shared_ptr<CPU_ExportedFunction> exported_function)
+    : m_exported_function(exported_function)
+{
+    ctx = new CPURuntimeContext;
+    ctx->tracer = m_exported_function->get_trace_buffer();
+    ctx->mkldnn_primitives = nullptr;
+    ctx->mkldnn_workspaces = nullptr;
+    ctx->constants = m_exported_function->get_constant_data().data();
+    ctx->memory_pool = nullptr;
+    if (m_exported_function->m_memory_pool_size > 0)
+    {
+        m_memory_pool.reset(new AlignedBuffer(m_exported_function->m_memory_pool_size,
+                                              m_exported_function->m_memory_pool_alignment));
+        ctx->memory_pool = m_memory_pool->get_ptr();
+    }
+    ctx->timers = nullptr;
+    m_timer_count = 0;
+    auto get_count = reinterpret_cast<size_t (*)()>(
+        dlsym(m_exported_function->m_library, "get_debug_timer_count"));
+    if (get_count)
+    {
+        m_timer_count = get_count();
+        m_timers.reset(new stopwatch[m_timer_count]);
+        ctx->timers = m_timers.get();
+        if (HardwareCounters::is_enabled())
+        {
+            m_hw_counters.reset(new HardwareCounters(m_timer_count));
+        }
+    }
+    ctx->hw_counters = m_hw_counters.get();
+    ctx->inputs = nullptr;
+    ctx->outputs = nullptr;
+    ctx->flow_graph = nullptr;
+    if (m_exported_function->m_make_flow_graph && m_exported_function->m_free_flow_graph)
+    {
+        ctx->flow_graph = m_exported_function->m_make_flow_graph(ctx);
+    }
+}
+
+runtime::cpu::CPU_ExportedCallFrame::~CPU_ExportedCallFrame()
+{
+    if (ctx->flow_graph)
+    {
+        m_exported_function->m_free_flow_graph(ctx->flow_graph);
+    }
+    delete ctx;
+}
+
+void runtime::cpu::CPU_ExportedCallFrame::check_tensors(
+    const vector<shared_ptr<runtime::TensorView>>& tvs,
+    const vector<Shape>& shapes,
+    const vector<string>& types,
+    vector<void*>& data) const
+{
+    if (tvs.size() != shapes.size())
+    {
+        throw ngraph_error("Exported function " + m_exported_function->get_function_name() +
+                           " called with the wrong number of tensors");
+    }
+    for (size_t i = 0; i < tvs.size(); i++)
+    {
+        if (tvs[i]->get_shape() != shapes[i])
+        {
+            throw ngraph_error("Exported function " + m_exported_function->get_function_name() +
+                               " called with a tensor of the wrong shape");
+        }
+        if (tvs[i]->get_tensor().get_element_type().c_type_string() != types[i])
+        {
+            throw ngraph_error("Exported function " + m_exported_function->get_function_name() +
+                               " called with a tensor of the wrong element type");
+        }
+        data.push_back(static_pointer_cast<runtime::cpu::CPUTensorView>(tvs[i])->get_data_ptr());
+    }
+}
+
+void runtime::cpu::CPU_ExportedCallFrame::tensor_call(
+    const vector<shared_ptr<runtime::TensorView>>& input_tvs,
+    const vector<shared_ptr<runtime::TensorView>>& output_tvs)
+{
+    vector<void*> inputs;
+    vector<void*> outputs;
+    check_tensors(input_tvs,
+                  m_exported_function->m_parameter_shapes,
+                  m_exported_function->m_parameter_types,
+                  inputs);
+    check_tensors(output_tvs,
+                  m_exported_function->m_result_shapes,
+                  m_exported_function->m_result_types,
+                  outputs);
+
+    m_exported_function->m_compiled_function(inputs.data(), outputs.data(), ctx);
+}
+
+void runtime::cpu::CPU_ExportedCallFrame::call(
+    const vector<shared_ptr<runtime::TensorView>>& arguments,
+    const vector<shared_ptr<runtime::TensorView>>& results)
+{
+    vector<shared_ptr<runtime::TensorView>> inputs;
+    for (shared_ptr<runtime::TensorView> argument : arguments)
+    {
+        argument->collect_tensor_views(inputs, argument);
+    }
+
+    vector<shared_ptr<runtime::TensorView>> outputs;
+    for (shared_ptr<runtime::TensorView> result : results)
+    {
+        result->collect_tensor_views(outputs, result);
+    }
+
+    tensor_call(inputs, outputs);
+}
+
+vector<runtime::PerformanceCounter>
+    runtime::cpu::CPU_ExportedCallFrame::get_performance_data() const
+{
+    vector<runtime::PerformanceCounter> rc;
+    void* library = m_exported_function->m_library;
+    auto get_name =
+        reinterpret_cast<const char* (*)(size_t)>(dlsym(library, "get_debug_timer_name"));
+
+    if (m_timers && get_name)
+    {
+        for (size_t i = 0; i < m_timer_count; i++)
+        {
+            HardwareCounts counts{0, 0, 0};
+            if (m_hw_counters)
+            {
+                counts = m_hw_counters->get_counts(i);
+            }
+            rc.push_back({get_name(i),
+                          m_timers[i].get_total_microseconds(),
+                          m_timers[i].get_call_count(),
+                          counts.cycles,
+                          counts.instructions,
+                          counts.cache_misses});
+        }
+    }
+    return rc;
+}
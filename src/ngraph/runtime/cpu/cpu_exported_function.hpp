@@ -0,0 +1,114 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_runtime_context.hpp"
+#include "ngraph/runtime/cpu/cpu_trace_buffer.hpp"
+#include "ngraph/shape.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            class CPU_ExportedFunction;
+            class CPU_ExportedCallFrame;
+
+            /// @brief A function exported by CPU_ExternalFunction::export_function.
+            ///
+            /// Loading only needs the shared library, the manifest and the constant data
+            /// written by the export. No code is generated or compiled at load time, and
+            /// loading fails if this CPU lacks a feature of the ISA the library was built for.
+            class CPU_ExportedFunction : public std::enable_shared_from_this<CPU_ExportedFunction>
+            {
+                friend class CPU_ExportedCallFrame;
+
+            public:
+                CPU_ExportedFunction(const std::string& directory,
+                                     const std::string& function_name);
+                ~CPU_ExportedFunction();
+                std::shared_ptr<ngraph::runtime::CallFrame> make_call_frame();
+
+                const std::string& get_function_name() const { return m_function_name; }
+                const std::vector<void*>& get_constant_data() const { return m_constant_data; }
+                /// @brief Execution trace of all call frames, only set if the function was
+                /// both exported and loaded with NGRAPH_CPU_TRACING
+                TraceBuffer* get_trace_buffer() const { return m_trace_buffer.get(); }
+                /// @brief Writes the ops held by the trace buffer as a Chrome trace. This is
+                /// also done, to GetTimelinePath(), when the function is destroyed.
+                void write_timeline(const std::string& file_name) const;
+
+            private:
+                std::string m_function_name;
+                void* m_library;
+                EntryPoint_t* m_compiled_function;
+                MakeFlowGraph_t* m_make_flow_graph;
+                FreeFlowGraph_t* m_free_flow_graph;
+                std::vector<Shape> m_parameter_shapes;
+                std::vector<Shape> m_result_shapes;
+                std::vector<std::string> m_parameter_types;
+                std::vector<std::string> m_result_types;
+                size_t m_memory_pool_size;
+                size_t m_memory_pool_alignment;
+                std::vector<OpAttributes> m_op_attrs;
+                std::unique_ptr<TraceBuffer> m_trace_buffer;
+
+                AlignedBuffer m_constant_buffer;
+                std::vector<void*> m_constant_data;
+            };
+
+            class CPU_ExportedCallFrame : public ngraph::runtime::CallFrame
+            {
+            public:
+                CPU_ExportedCallFrame(std::shared_ptr<CPU_ExportedFunction> exported_function);
+                ~CPU_ExportedCallFrame();
+
+                void
+                    call(const std::vector<std::shared_ptr<runtime::TensorView>>& inputs,
+                         const std::vector<std::shared_ptr<runtime::TensorView>>& outputs) override;
+
+                void tensor_call(const std::vector<std::shared_ptr<TensorView>>& inputs,
+                                 const std::vector<std::shared_ptr<TensorView>>& outputs) override;
+
+                std::vector<ngraph::runtime::PerformanceCounter>
+                    get_performance_data() const override;
+
+            private:
+                void check_tensors(const std::vector<std::shared_ptr<TensorView>>& tvs,
+                                   const std::vector<Shape>& shapes,
+                                   const std::vector<std::string>& types,
+                                   std::vector<void*>& data) const;
+
+                std::shared_ptr<CPU_ExportedFunction> m_exported_function;
+                CPURuntimeContext* ctx;
+                std::unique_ptr<AlignedBuffer> m_memory_pool;
+                std::unique_ptr<stopwatch[]> m_timers;
+                std::unique_ptr<HardwareCounters> m_hw_counters;
+                size_t m_timer_count;
+            };
+        }
+    }
+}
@@ -14,10 +14,15 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
 #include <fstream>
 #include <memory>
+#include <set>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <typeindex>
 #include <typeinfo>
@@ -32,6 +37,7 @@
 #include "ngraph/file_util.hpp"
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
 #include "ngraph/node.hpp"
 #include "ngraph/ops/abs.hpp"
 #include "ngraph/ops/acos.hpp"
@@ -96,6 +102,7 @@
 #include "ngraph/ops/sum.hpp"
 #include "ngraph/ops/tan.hpp"
 #include "ngraph/ops/tanh.hpp"
+#include "ngraph/pass/constant_folding.hpp"
 #include "ngraph/pass/dump_sorted.hpp"
 #include "ngraph/pass/get_output_element_elimination.hpp"
 #include "ngraph/pass/liveness.hpp"
@@ -104,20 +111,25 @@
 #include "ngraph/pass/result_copy_elimination.hpp"
 #include "ngraph/pattern/core_fusion.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
+#include "ngraph/runtime/cpu/cpu_builder.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_emitter.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_hw_counters.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/cpu_tracing.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 #include "ngraph/runtime/cpu/ops/conv_bias.hpp"
 #include "ngraph/runtime/cpu/ops/convert_layout.hpp"
+#include "ngraph/runtime/cpu/ops/loop_kernel.hpp"
 #include "ngraph/runtime/cpu/ops/matmul_bias.hpp"
 #include "ngraph/runtime/cpu/ops/sigmoid.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_assignment.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_layout.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_loop_kernel_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_nop_elimination.hpp"
+#include "nlohmann/json.hpp"
 
 #ifdef NGRAPH_DISTRIBUTED
 #include "ngraph/ops/allreduce.hpp"
@@ -130,6 +142,10 @@ static const string s_output_dir = "cpu_codegen";
 
 // Temporary Memory Pool alignment
 static const size_t s_memory_pool_alignment = 4096;
+// Generated code is only split into several modules for concurrent compilation
+// when each module gets at least this much code, unless NGRAPH_CPU_MIN_MODULE_SIZE
+// gives another size
+static const size_t s_min_module_size = 64 * 1024;
 
 static void
     generate_isnan_isinf_check(codegen::CodeWriter& writer,
@@ -184,6 +200,56 @@ static string emit_string_array(const vector<string>& s, size_t max_line_length)
     return ss.str();
 }
 
+// Single-quotes s for the shell, so paths with spaces or metacharacters stay one word
+static string shell_quote(const string& s)
+{
+    string quoted = "'";
+    for (char c : s)
+    {
+        if (c == '\'')
+        {
+            quoted += "'\\''";
+        }
+        else
+        {
+            quoted += c;
+        }
+    }
+    return quoted + "'";
+}
+
+// Instruction set extensions an exported library may depend on, by the macro the compiler
+// defines when it may use them. The names are those of __builtin_cpu_supports.
+static const vector<pair<string, string>> s_cpu_feature_macros{{"__SSE4_2__", "sse4.2"},
+                                                                {"__AVX__", "avx"},
+                                                                {"__AVX2__", "avx2"},
+                                                                {"__FMA__", "fma"},
+                                                                {"__AVX512F__", "avx512f"}};
+
+// CPU features that code built by compiler, a command line with its target flags, may use
+static vector<string> get_cpu_features(const string& compiler)
+{
+    string macro_path = file_util::tmp_filename();
+    string command = compiler + " -dM -E -x c++ /dev/null > " + shell_quote(macro_path);
+    if (std::system(command.c_str()) != 0)
+    {
+        file_util::remove_file(macro_path);
+        throw ngraph_error("Failed to query the target of the export compiler: " + command);
+    }
+    string macros = file_util::read_file_to_string(macro_path);
+    file_util::remove_file(macro_path);
+
+    vector<string> features;
+    for (const pair<string, string>& feature : s_cpu_feature_macros)
+    {
+        if (macros.find("#define " + feature.first + " ") != string::npos)
+        {
+            features.push_back(feature.second);
+        }
+    }
+    return features;
+}
+
 static StaticInitializers s_static_initializers;
 
 #define TI(x) type_index(typeid(x))
@@ -249,6 +315,8 @@ static const runtime::cpu::OpMap dispatcher{
      &runtime::cpu::CPU_Emitter::emit<op::ConvolutionBiasBackpropFiltersBias>},
     {TI(ngraph::runtime::cpu::op::ConvertLayout),
      &runtime::cpu::CPU_Emitter::emit<runtime::cpu::op::ConvertLayout>},
+    {TI(ngraph::runtime::cpu::op::LoopKernel),
+     &runtime::cpu::CPU_Emitter::emit<runtime::cpu::op::LoopKernel>},
     {TI(ngraph::op::Not), &runtime::cpu::CPU_Emitter::emit<op::Not>},
     {TI(ngraph::op::MaxPool), &runtime::cpu::CPU_Emitter::emit<op::MaxPool>},
     {TI(ngraph::op::Reverse), &runtime::cpu::CPU_Emitter::emit<op::Reverse>},
@@ -271,18 +339,134 @@ static const runtime::cpu::OpMap dispatcher{
     {TI(ngraph::op::SigmoidBackprop), &runtime::cpu::CPU_Emitter::emit<op::SigmoidBackprop>},
 };
 
+// Ops with a precompiled kernel for direct execution
+static const runtime::cpu::BuildOpMap build_dispatcher{
+    {TI(ngraph::op::Parameter), &runtime::cpu::CPU_Builder::nop},
+    {TI(ngraph::op::Constant), &runtime::cpu::CPU_Builder::nop},
+    {TI(ngraph::op::Abs), &runtime::cpu::CPU_Builder::build<op::Abs>},
+    {TI(ngraph::op::Acos), &runtime::cpu::CPU_Builder::build<op::Acos>},
+    {TI(ngraph::op::Asin), &runtime::cpu::CPU_Builder::build<op::Asin>},
+    {TI(ngraph::op::Atan), &runtime::cpu::CPU_Builder::build<op::Atan>},
+    {TI(ngraph::op::Ceiling), &runtime::cpu::CPU_Builder::build<op::Ceiling>},
+    {TI(ngraph::op::Cos), &runtime::cpu::CPU_Builder::build<op::Cos>},
+    {TI(ngraph::op::Cosh), &runtime::cpu::CPU_Builder::build<op::Cosh>},
+    {TI(ngraph::op::Exp), &runtime::cpu::CPU_Builder::build<op::Exp>},
+    {TI(ngraph::op::Floor), &runtime::cpu::CPU_Builder::build<op::Floor>},
+    {TI(ngraph::op::Log), &runtime::cpu::CPU_Builder::build<op::Log>},
+    {TI(ngraph::op::Negative), &runtime::cpu::CPU_Builder::build<op::Negative>},
+    {TI(ngraph::op::Not), &runtime::cpu::CPU_Builder::build<op::Not>},
+    {TI(ngraph::op::Relu), &runtime::cpu::CPU_Builder::build<op::Relu>},
+    {TI(ngraph::op::Sign), &runtime::cpu::CPU_Builder::build<op::Sign>},
+    {TI(ngraph::op::Sin), &runtime::cpu::CPU_Builder::build<op::Sin>},
+    {TI(ngraph::op::Sinh), &runtime::cpu::CPU_Builder::build<op::Sinh>},
+    {TI(ngraph::op::Sqrt), &runtime::cpu::CPU_Builder::build<op::Sqrt>},
+    {TI(ngraph::op::Tan), &runtime::cpu::CPU_Builder::build<op::Tan>},
+    {TI(ngraph::op::Tanh), &runtime::cpu::CPU_Builder::build<op::Tanh>},
+    {TI(ngraph::op::Add), &runtime::cpu::CPU_Builder::build<op::Add>},
+    {TI(ngraph::op::Subtract), &runtime::cpu::CPU_Builder::build<op::Subtract>},
+    {TI(ngraph::op::Multiply), &runtime::cpu::CPU_Builder::build<op::Multiply>},
+    {TI(ngraph::op::Divide), &runtime::cpu::CPU_Builder::build<op::Divide>},
+    {TI(ngraph::op::Maximum), &runtime::cpu::CPU_Builder::build<op::Maximum>},
+    {TI(ngraph::op::Minimum), &runtime::cpu::CPU_Builder::build<op::Minimum>},
+    {TI(ngraph::op::Power), &runtime::cpu::CPU_Builder::build<op::Power>},
+    {TI(ngraph::op::Equal), &runtime::cpu::CPU_Builder::build<op::Equal>},
+    {TI(ngraph::op::NotEqual), &runtime::cpu::CPU_Builder::build<op::NotEqual>},
+    {TI(ngraph::op::Greater), &runtime::cpu::CPU_Builder::build<op::Greater>},
+    {TI(ngraph::op::GreaterEq), &runtime::cpu::CPU_Builder::build<op::GreaterEq>},
+    {TI(ngraph::op::Less), &runtime::cpu::CPU_Builder::build<op::Less>},
+    {TI(ngraph::op::LessEq), &runtime::cpu::CPU_Builder::build<op::LessEq>},
+    {TI(ngraph::op::Select), &runtime::cpu::CPU_Builder::build<op::Select>},
+    {TI(ngraph::op::Convert), &runtime::cpu::CPU_Builder::build<op::Convert>},
+    {TI(ngraph::op::Broadcast), &runtime::cpu::CPU_Builder::build<op::Broadcast>},
+    {TI(ngraph::op::Reshape), &runtime::cpu::CPU_Builder::build<op::Reshape>},
+    {TI(ngraph::op::Slice), &runtime::cpu::CPU_Builder::build<op::Slice>},
+    {TI(ngraph::op::Concat), &runtime::cpu::CPU_Builder::build<op::Concat>},
+    {TI(ngraph::op::Sum), &runtime::cpu::CPU_Builder::build<op::Sum>},
+    {TI(ngraph::op::Product), &runtime::cpu::CPU_Builder::build<op::Product>},
+    {TI(ngraph::op::Max), &runtime::cpu::CPU_Builder::build<op::Max>},
+    {TI(ngraph::op::Min), &runtime::cpu::CPU_Builder::build<op::Min>},
+    {TI(ngraph::op::Reverse), &runtime::cpu::CPU_Builder::build<op::Reverse>},
+    {TI(ngraph::op::OneHot), &runtime::cpu::CPU_Builder::build<op::OneHot>},
+    {TI(ngraph::op::Pad), &runtime::cpu::CPU_Builder::build<op::Pad>},
+    {TI(ngraph::op::Softmax), &runtime::cpu::CPU_Builder::build<op::Softmax>},
+    {TI(ngraph::op::Dot), &runtime::cpu::CPU_Builder::build<op::Dot>},
+    {TI(ngraph::op::Convolution), &runtime::cpu::CPU_Builder::build<op::Convolution>},
+    {TI(ngraph::op::MaxPool), &runtime::cpu::CPU_Builder::build<op::MaxPool>},
+    {TI(ngraph::op::AvgPool), &runtime::cpu::CPU_Builder::build<op::AvgPool>},
+    {TI(ngraph::op::Result), &runtime::cpu::CPU_Builder::build<op::Result>},
+};
+
+// Distributes the chunks [begin, end) of code over module_count modules of similar size,
+// keeping the original order of the chunks within each module
+static vector<string> split_into_modules(const string& code,
+                                         const vector<pair<size_t, size_t>>& chunks,
+                                         size_t module_count)
+{
+    vector<size_t> order(chunks.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    stable_sort(order.begin(), order.end(), [&chunks](size_t a, size_t b) {
+        return chunks[a].second - chunks[a].first > chunks[b].second - chunks[b].first;
+    });
+
+    vector<size_t> module_size(module_count, 0);
+    vector<vector<size_t>> module_chunks(module_count);
+    for (size_t chunk : order)
+    {
+        size_t smallest = min_element(module_size.begin(), module_size.end()) - module_size.begin();
+        module_chunks[smallest].push_back(chunk);
+        module_size[smallest] += chunks[chunk].second - chunks[chunk].first;
+    }
+
+    vector<string> modules;
+    for (vector<size_t>& indices : module_chunks)
+    {
+        if (indices.empty())
+        {
+            continue;
+        }
+        sort(indices.begin(), indices.end());
+        string module;
+        for (size_t chunk : indices)
+        {
+            module += code.substr(chunks[chunk].first, chunks[chunk].second - chunks[chunk].first);
+        }
+        modules.push_back(module);
+    }
+    return modules;
+}
+
 runtime::cpu::CPU_ExternalFunction::CPU_ExternalFunction(
     const shared_ptr<ngraph::Function>& function, bool release_function)
     : ngraph::runtime::ExternalFunction(function, release_function)
     , m_compiled_function(nullptr)
     , m_emit_timing(false)
     , m_use_tbb(std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
+    , m_direct_execution(std::getenv("NGRAPH_DEX") != nullptr)
+    , m_memory_pool_size(0)
+    , m_module_count(0)
     , m_function_name(function->get_name())
 {
 }
 
 runtime::cpu::CPU_ExternalFunction::~CPU_ExternalFunction()
 {
+    if (m_trace_buffer && m_trace_buffer->get_record_count() > 0)
+    {
+        write_timeline(GetTimelinePath(m_function_name));
+    }
+}
+
+void runtime::cpu::CPU_ExternalFunction::write_timeline(const std::string& file_name) const
+{
+    if (!m_trace_buffer)
+    {
+        throw ngraph_error("Function " + m_function_name +
+                           " was not compiled with NGRAPH_CPU_TRACING");
+    }
+    GenerateTimeline(m_op_attrs, *m_trace_buffer, file_name);
 }
 
 void runtime::cpu::CPU_ExternalFunction::compile()
@@ -293,6 +477,10 @@ void runtime::cpu::CPU_ExternalFunction::compile()
     }
 
     m_emit_timing = m_timing | (std::getenv("NGRAPH_CPU_EMIT_TIMING") != nullptr);
+    if (runtime::cpu::IsTracingEnabled())
+    {
+        m_trace_buffer.reset(new TraceBuffer(GetTraceBufferSize()));
+    }
 
     m_mkldnn_emitter.reset(new MKLDNNEmitter());
 
@@ -301,12 +489,15 @@ void runtime::cpu::CPU_ExternalFunction::compile()
     pass_manager.register_pass<runtime::cpu::pass::CPUNopElimination>();
     pass_manager.register_pass<ngraph::pass::CoreFusion>();
     pass_manager.register_pass<runtime::cpu::pass::CPUFusion>();
+    pass_manager.register_pass<ngraph::pass::ConstantFolding>(m_updatable_constants);
+    pass_manager.register_pass<runtime::cpu::pass::CPULoopKernelFusion>();
     pass_manager.register_pass<runtime::cpu::pass::CPUAssignment>(this);
     pass_manager.register_pass<runtime::cpu::pass::CPULayout>(this);
     pass_manager.register_pass<ngraph::pass::ResultCopyElimination>();
     pass_manager.register_pass<ngraph::pass::GetOutputElementElimination>();
     pass_manager.register_pass<ngraph::pass::Liveness>();
-    pass_manager.register_pass<ngraph::pass::MemoryLayout>(s_memory_pool_alignment);
+    pass_manager.register_pass<ngraph::pass::MemoryLayout>(
+        s_memory_pool_alignment, ngraph::pass::MemoryLayout::allocation_scheme::OFFLINE);
     pass_manager.run_passes(m_function);
 
     codegen::CodeWriter writer;
@@ -317,8 +508,10 @@ void runtime::cpu::CPU_ExternalFunction::compile()
 #include "ngraph/except.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/cpu/cpu_eigen_utils.hpp"
+#include "ngraph/runtime/cpu/cpu_hw_counters.hpp"
 #include "ngraph/runtime/cpu/cpu_kernels.hpp"
 #include "ngraph/runtime/cpu/cpu_runtime_context.hpp"
+#include "ngraph/runtime/cpu/cpu_trace_buffer.hpp"
 #include "ngraph/runtime/cpu/mkldnn_invoke.hpp"
 #include "ngraph/runtime/kernel/avg_pool.hpp"
 #include "ngraph/runtime/kernel/broadcast.hpp"
@@ -367,11 +560,14 @@ using namespace ngraph::runtime;
     // to register cleanup handlers. We use it, and not atexit(), because
     // atexit() happens too late, when the JIT is no longer alive
 
-    writer << "void *__dso_handle = 0;\n\n";
+    // Shared libraries built by export_function get theirs from the linker
+    writer << "#ifndef NGRAPH_CPU_EXPORT\n";
+    writer << "void *__dso_handle = 0;\n";
+    writer << "#endif\n\n";
 
     if (m_emit_timing)
     {
-        writer << "// Declare debug timers\n";
+        writer << "// Debug timer names\n";
         vector<string> names;
         size_t index = 0;
         for (shared_ptr<Function> current_function : pass_manager.get_state().get_functions())
@@ -385,7 +581,8 @@ using namespace ngraph::runtime;
                 }
             }
         }
-        writer << "ngraph::stopwatch timers[" << names.size() << "];\n";
+        // The timers themselves are owned by each call frame and reached through ctx
+        m_debug_timer_names = names;
         writer << "extern \"C\" size_t get_debug_timer_count() { return " << names.size()
                << "; }\n";
         writer << "extern \"C\" const char* get_debug_timer_name(size_t index)\n";
@@ -405,42 +602,31 @@ using namespace ngraph::runtime;
         writer << "return timer_names[index];\n";
         writer.indent--;
         writer << "}\n";
-
-        writer << "extern \"C\" const size_t get_debug_timer_microseconds(size_t index)\n";
-        writer << "{\n";
-        writer.indent++;
-        writer << "return (index < " << names.size()
-               << " ? timers[index].get_total_microseconds() : 0);\n";
-        writer.indent--;
-        writer << "}\n";
-
-        writer << "extern \"C\" const size_t get_debug_timer_call_count(size_t index)\n";
-        writer << "{\n";
-        writer.indent++;
-        writer << "return (index < " << names.size() << " ? timers[index].get_call_count() : 0);\n";
-        writer.indent--;
-        writer << "}\n";
         writer << "\n";
     }
 
-    writer << "// Declare all constants\n";
+    // Constants are not baked into the generated code. They are looked up in
+    // ctx->constants so the generated code only depends on the structure of the
+    // graph, which is what makes the compiled object cacheable.
     for (shared_ptr<Function> current_function : pass_manager.get_state().get_functions())
     {
         for (shared_ptr<Node> node : current_function->get_ordered_ops())
         {
-            const ngraph::op::Constant* c = dynamic_cast<ngraph::op::Constant*>(node.get());
-            if (c)
+            if (node->is_constant())
             {
-                m_active_constants.push_back(node);
+                add_constant(node);
                 shared_ptr<descriptor::TensorView> tv = node->get_outputs()[0].get_tensor_view();
-                string type = tv->get_tensor().get_element_type().c_type_string();
-                writer << "static " << type << "* " << tv->get_tensor().get_name() << " = (("
-                       << type << "*)(" << c->get_data_ptr() << "));\n";
                 m_variable_name_map[tv->get_tensor().get_name()] = tv->get_tensor().get_name();
             }
         }
     }
 
+    // Code between the precompiled header source and the declarations defines globals,
+    // what follows is split into chunks that can be compiled as separate modules
+    size_t declarations_begin = writer.get_code_size();
+    vector<pair<size_t, size_t>> chunks;
+    string op_function_declarations;
+
     writer << "// Declare all functions\n";
     for (shared_ptr<Function> f : pass_manager.get_state().get_functions())
     {
@@ -507,7 +693,11 @@ using namespace ngraph::runtime;
             }
             if (!match_function_name.empty())
             {
-                writer << emit_op_as_function(*op_list[i], match_function_name);
+                string op_function = emit_op_as_function(*op_list[i], match_function_name);
+                op_function_declarations += op_function.substr(0, op_function.find("\n{")) + ";\n";
+                size_t chunk_begin = writer.get_code_size();
+                writer << op_function;
+                chunks.push_back({chunk_begin, writer.get_code_size()});
             }
         }
     }
@@ -530,52 +720,139 @@ using namespace ngraph::runtime;
             }
         }
 
-        writer << "extern \"C\" void " << current_function->get_name();
-        writer << "(void** inputs, void** outputs, cpu::CPURuntimeContext* ctx)\n";
+        // With TBB the entry point's dependency graph is built once per call frame by
+        // <name>_make_flow_graph. The entry point itself only publishes the call's
+        // tensors through ctx and triggers the graph.
+        bool build_flow_graph = m_use_tbb && current_function->get_name() == m_function_name;
+        string flow_graph_type = current_function->get_name() + "_FlowGraph";
+
+        size_t chunk_begin = writer.get_code_size();
+        if (build_flow_graph)
+        {
+            writer << "struct " << flow_graph_type << "\n";
+            writer << "{\n";
+            writer.indent++;
+            writer << "tbb::flow::graph G;\n";
+            writer << "std::vector<std::unique_ptr<tbb::flow::continue_node<"
+                      "tbb::flow::continue_msg>>> nodes;\n";
+            writer << "std::vector<tbb::flow::continue_node<tbb::flow::continue_msg>*> heads;\n";
+            writer.indent--;
+            writer << "};\n\n";
+
+            writer << "extern \"C\" void " << current_function->get_name()
+                   << "_free_flow_graph(void* flow_graph)\n";
+            writer << "{\n";
+            writer << "    delete static_cast<" << flow_graph_type << "*>(flow_graph);\n";
+            writer << "}\n\n";
+
+            writer << "extern \"C\" void " << current_function->get_name();
+            writer << "(void** inputs, void** outputs, cpu::CPURuntimeContext* ctx)\n";
+            writer << "{\n";
+            writer.indent++;
+            writer << flow_graph_type << "* flow_graph = static_cast<" << flow_graph_type
+                   << "*>(ctx->flow_graph);\n";
+            writer << "ctx->inputs = inputs;\n";
+            writer << "ctx->outputs = outputs;\n";
+            writer << "for (auto head : flow_graph->heads)\n";
+            writer << "{\n";
+            writer << "    head->try_put(tbb::flow::continue_msg());\n";
+            writer << "}\n";
+            writer << "try\n";
+            writer << "{\n";
+            writer << "    flow_graph->G.wait_for_all();\n";
+            writer << "}\n";
+            writer << "catch (...)\n";
+            writer << "{\n";
+            writer << "    // An op that threw cancelled the graph, which would leave it unusable\n";
+            writer << "    // for the call frame's later calls\n";
+            writer << "    flow_graph->G.reset();\n";
+            writer << "    throw;\n";
+            writer << "}\n";
+            writer.indent--;
+            writer << "}\n\n";
+
+            writer << "extern \"C\" void* " << current_function->get_name();
+            writer << "_make_flow_graph(cpu::CPURuntimeContext* ctx)\n";
+        }
+        else
+        {
+            writer << "extern \"C\" void " << current_function->get_name();
+            writer << "(void** inputs, void** outputs, cpu::CPURuntimeContext* ctx)\n";
+        }
         writer << "{\n";
         writer.indent++;
 
-        if (m_use_tbb)
+        unordered_map<descriptor::TensorView*, size_t> constant_indices;
+        if (!constants.empty())
+        {
+            writer << "// Declare all constants\n";
+            for (size_t i = 0; i < m_active_constants.size(); i++)
+            {
+                shared_ptr<descriptor::TensorView> tv =
+                    m_active_constants[i]->get_outputs()[0].get_tensor_view();
+                if (constants.count(tv.get()))
+                {
+                    constant_indices[tv.get()] = i;
+                    string type = tv->get_tensor().get_element_type().c_type_string();
+                    writer << type << "* " << tv->get_tensor().get_name() << " = ((" << type
+                           << "*)(ctx->constants[" << i << "]));\n";
+                }
+            }
+            writer << "\n";
+        }
+
+        if (build_flow_graph)
+        {
+            writer << flow_graph_type << "* flow_graph = new " << flow_graph_type << ";\n\n";
+        }
+        else if (m_use_tbb)
         {
-            // TODO: This should be static but we don't codegen statics correctly yet
             writer << "tbb::flow::graph G;\n\n";
         }
 
         // Execution tracing support
-        if (runtime::cpu::IsTracingEnabled() && current_function->get_name() == m_function_name)
+        if (runtime::cpu::IsTracingEnabled() && current_function->get_name() == m_function_name &&
+            !build_flow_graph)
         {
-            writer << "cpu::Timestamp start_ts;\n"
-                   << "int profiler_count = 0;\n\n";
+            writer << "cpu::Timestamp start_ts;\n\n";
         }
 
         bool temporaries_used = false;
         size_t worst_case_tmp_size = 0;
         for (shared_ptr<Node> node : current_function->get_ordered_ops())
         {
-            if (node->liveness_new_list.size() > 0)
+            for (descriptor::Tensor* tensor : node->get_liveness_new_list())
             {
                 temporaries_used = true;
-                for (descriptor::Tensor* tensor : node->liveness_new_list)
-                {
-                    worst_case_tmp_size += tensor->size();
-                }
+                worst_case_tmp_size += tensor->size();
             }
         }
         if (temporaries_used)
         {
             size_t temp_pool_size = current_function->get_temporary_pool_size();
-            writer << "// Allocate the memory pool\n";
             writer << "// Memory pool size is " << temp_pool_size << " bytes\n";
             writer << "// Worst case size is " << worst_case_tmp_size << " bytes\n";
-            writer << "ngraph::runtime::AlignedBuffer memory_handler(" << temp_pool_size << ", "
-                   << s_memory_pool_alignment << ");\n";
-            writer << "size_t pool_base_ptr = (size_t)memory_handler.get_ptr();\n";
+            if (current_function->get_name() == m_function_name)
+            {
+                // The entry point's pool is owned by the call frame so that steady state
+                // calls do not allocate. Nested functions may be invoked concurrently
+                // from within a call and keep allocating their own pool.
+                m_memory_pool_size = temp_pool_size;
+                writer << "size_t pool_base_ptr = (size_t)ctx->memory_pool;\n";
+            }
+            else
+            {
+                writer << "// Allocate the memory pool\n";
+                writer << "ngraph::runtime::AlignedBuffer memory_handler(" << temp_pool_size
+                       << ", " << s_memory_pool_alignment << ");\n";
+                writer << "size_t pool_base_ptr = (size_t)memory_handler.get_ptr();\n";
+            }
             writer << "\n";
 
             // Add temporaries to the variable name map
             for (shared_ptr<Node> node : current_function->get_ordered_ops())
             {
-                for (descriptor::Tensor* tensor : node->liveness_new_list)
+                for (descriptor::Tensor* tensor : node->get_liveness_new_list())
                 {
                     stringstream ss;
                     ss << "((" << tensor->get_element_type().c_type_string()
@@ -678,7 +955,31 @@ using namespace ngraph::runtime;
                     m_op_attrs.emplace_back(
                         node->description(), node_output_names, node_input_names);
                 }
-                if (m_use_tbb)
+                if (build_flow_graph)
+                {
+                    // Nodes outlive this function, so they capture by value and pick up
+                    // the tensors of the current call from ctx
+                    writer << "auto flowgraph_node_" << node->get_name()
+                           << " = new tbb::flow::continue_node<tbb::flow::continue_msg>("
+                              "flow_graph->G, [=](const tbb::flow::continue_msg &msg)\n{\n";
+                    writer.indent++;
+                    writer << "void** inputs = ctx->inputs;\n";
+                    writer << "void** outputs = ctx->outputs;\n";
+                    // Constants may be replaced between calls, see update_constant
+                    set<descriptor::TensorView*> redeclared;
+                    for (const descriptor::Input& input : node->get_inputs())
+                    {
+                        descriptor::TensorView* tv = input.get_output().get_tensor_view().get();
+                        auto it = constant_indices.find(tv);
+                        if (it != constant_indices.end() && redeclared.insert(tv).second)
+                        {
+                            string type = tv->get_tensor().get_element_type().c_type_string();
+                            writer << type << "* " << tv->get_tensor().get_name() << " = (("
+                                   << type << "*)(ctx->constants[" << it->second << "]));\n";
+                        }
+                    }
+                }
+                else if (m_use_tbb)
                 {
                     writer << "tbb::flow::continue_node<tbb::flow::continue_msg> "
                               "flowgraph_node_"
@@ -689,7 +990,8 @@ using namespace ngraph::runtime;
                 if (runtime::cpu::IsTracingEnabled() &&
                     current_function->get_name() == m_function_name)
                 {
-                    writer << "start_ts = cpu::Clock::now();\n";
+                    writer << (build_flow_graph ? "cpu::Timestamp " : "")
+                           << "start_ts = cpu::Clock::now();\n";
                 }
             }
 
@@ -758,15 +1060,23 @@ using namespace ngraph::runtime;
                 if (runtime::cpu::IsTracingEnabled() &&
                     current_function->get_name() == m_function_name)
                 {
-                    writer << "ctx->op_durations[profiler_count++] = "
-                           << "(std::chrono::duration_cast<cpu::Timescale>(cpu::Clock::now() - "
-                              "start_ts)).count();\n";
+                    // Exported code is only traced if it is also loaded with tracing
+                    writer << "if (ctx->tracer)\n";
+                    writer << "{\n";
+                    writer << "    ctx->tracer->record(" << m_op_attrs.size() - 1
+                           << ", start_ts, cpu::Clock::now());\n";
+                    writer << "}\n";
                 }
                 if (m_use_tbb)
                 {
                     writer.indent--;
                     writer << "});\n";
                 }
+                if (build_flow_graph)
+                {
+                    writer << "flow_graph->nodes.emplace_back(flowgraph_node_" << node->get_name()
+                           << ");\n";
+                }
             }
         }
 
@@ -776,8 +1086,10 @@ using namespace ngraph::runtime;
             // Build the flow graph
             vector<Node*> dependence_graph_heads;
 
+            // Nodes of the prebuilt graph are held by pointer
+            string deref = build_flow_graph ? "*" : "";
             traverse_nodes(
-                current_function, [&writer, &dependence_graph_heads](shared_ptr<Node> n) {
+                current_function, [&writer, &dependence_graph_heads, &deref](shared_ptr<Node> n) {
                     if (!n->is_parameter() && !n->is_constant())
                     {
                         bool is_head = true;
@@ -786,8 +1098,9 @@ using namespace ngraph::runtime;
                             if (!arg->is_parameter() && !arg->is_constant())
                             {
                                 is_head = false;
-                                writer << "tbb::flow::make_edge(flowgraph_node_" << arg->get_name()
-                                       << ", flowgraph_node_" << n->get_name() << ");\n";
+                                writer << "tbb::flow::make_edge(" << deref << "flowgraph_node_"
+                                       << arg->get_name() << ", " << deref << "flowgraph_node_"
+                                       << n->get_name() << ");\n";
                             }
                         }
                         if (is_head)
@@ -799,8 +1112,17 @@ using namespace ngraph::runtime;
 
             writer << "\n";
 
+            if (build_flow_graph)
+            {
+                for (Node* n : dependence_graph_heads)
+                {
+                    writer << "flow_graph->heads.push_back(flowgraph_node_" << n->get_name()
+                           << ");\n";
+                }
+                writer << "return flow_graph;\n";
+            }
             // Execute the flow graph
-            if (!dependence_graph_heads.empty())
+            else if (!dependence_graph_heads.empty())
             {
                 for (Node* n : dependence_graph_heads)
                 {
@@ -814,8 +1136,290 @@ using namespace ngraph::runtime;
         writer.indent--;
         // End generated function
         writer += "}\n\n";
+        chunks.push_back({chunk_begin, writer.get_code_size()});
+    }
+
+    store_io_layouts();
+
+    // TODO: Cleanup and make this a utility function
+    file_util::make_directory(s_output_dir);
+    string filename = file_util::path_join(s_output_dir, m_function_name + "_codegen.cpp");
+    ofstream out(filename);
+    string code = writer.get_code();
+    m_generated_code = code;
+    out << code;
+    out.close();
+
+    m_compiler.reset(new codegen::Compiler());
+    m_execution_engine.reset(new codegen::ExecutionEngine());
+
+    const char* cache_dir = std::getenv("NGRAPH_CPU_CACHE_DIR");
+    if (cache_dir != nullptr)
+    {
+        m_execution_engine->enable_object_cache(cache_dir,
+                                                m_compiler->get_header_fingerprint());
+    }
+
+    size_t thread_count = thread::hardware_concurrency();
+    if (const char* env_threads = std::getenv("NGRAPH_CPU_COMPILE_THREADS"))
+    {
+        thread_count = std::strtoul(env_threads, nullptr, 10);
+    }
+    size_t min_module_size = s_min_module_size;
+    if (const char* env_module_size = std::getenv("NGRAPH_CPU_MIN_MODULE_SIZE"))
+    {
+        min_module_size = max<size_t>(std::strtoul(env_module_size, nullptr, 10), 1);
+    }
+    vector<string> module_sources;
+    if (thread_count > 1 && code.size() >= 2 * min_module_size && !chunks.empty())
+    {
+        // Each module gets the header source, declarations of everything it may call and
+        // a share of the chunks. The globals are only defined in the first module.
+        string prefix = code.substr(0, pch_header_source.size());
+        string declarations = code.substr(declarations_begin, chunks[0].first - declarations_begin);
+        declarations += op_function_declarations + "\n";
+        string globals =
+            code.substr(pch_header_source.size(), declarations_begin - pch_header_source.size());
+
+        size_t module_count = min(thread_count, code.size() / min_module_size);
+        module_sources = split_into_modules(code, chunks, module_count);
+        for (size_t i = 0; i < module_sources.size(); i++)
+        {
+            module_sources[i] =
+                prefix + (i == 0 ? globals : "") + declarations + module_sources[i];
+        }
+    }
+    else
+    {
+        module_sources.push_back(code);
+    }
+
+    m_module_count = module_sources.size();
+
+    vector<string> uncached_sources;
+    for (const string& source : module_sources)
+    {
+        if (!m_execution_engine->add_cached_module(source))
+        {
+            uncached_sources.push_back(source);
+        }
+    }
+    if (!uncached_sources.empty())
+    {
+        m_compiler->set_precompiled_header_source(pch_header_source);
+
+        auto codegen_modules = m_compiler->compile(uncached_sources, thread_count);
+
+        for (size_t i = 0; i < codegen_modules.size(); i++)
+        {
+            if (codegen_modules[i] == nullptr)
+            {
+                throw runtime_error("function failed to compile");
+            }
+            m_execution_engine->add_module(codegen_modules[i], uncached_sources[i]);
+        }
+    }
+    m_execution_engine->finalize();
+    m_compiled_function = m_execution_engine->find_function<EntryPoint_t>(m_function_name);
+
+    if (m_compiled_function == nullptr)
+    {
+        throw runtime_error("could not find compiled function");
+    }
+
+    if (m_use_tbb)
+    {
+        m_make_flow_graph = m_execution_engine->find_function<MakeFlowGraph_t>(
+            m_function_name + "_make_flow_graph");
+        m_free_flow_graph = m_execution_engine->find_function<FreeFlowGraph_t>(
+            m_function_name + "_free_flow_graph");
+        if (m_make_flow_graph == nullptr || m_free_flow_graph == nullptr)
+        {
+            throw runtime_error("could not find flow graph construction functions");
+        }
+    }
+
+    m_is_compiled = true;
+    if (m_release_function)
+    {
+        release_function();
+    }
+}
+
+void runtime::cpu::CPU_ExternalFunction::build()
+{
+    if (m_is_compiled)
+    {
+        return;
+    }
+
+    m_emit_timing = m_timing | (std::getenv("NGRAPH_CPU_EMIT_TIMING") != nullptr);
+    if (runtime::cpu::IsTracingEnabled())
+    {
+        m_trace_buffer.reset(new TraceBuffer(GetTraceBufferSize()));
+    }
+
+    // Nothing is emitted, the call frames just get an empty set of primitives
+    m_mkldnn_emitter.reset(new MKLDNNEmitter());
+
+    // Only core ops have precompiled kernels, so the CPU specific fusions and the
+    // MKLDNN op assignment are left out and every tensor keeps its native layout
+    ngraph::pass::Manager pass_manager;
+
+    pass_manager.register_pass<runtime::cpu::pass::CPUNopElimination>();
+    pass_manager.register_pass<ngraph::pass::CoreFusion>();
+    pass_manager.register_pass<ngraph::pass::ConstantFolding>(m_updatable_constants);
+    pass_manager.register_pass<runtime::cpu::pass::CPULayout>(this);
+    pass_manager.register_pass<ngraph::pass::ResultCopyElimination>();
+    pass_manager.register_pass<ngraph::pass::GetOutputElementElimination>();
+    pass_manager.register_pass<ngraph::pass::Liveness>();
+    pass_manager.register_pass<ngraph::pass::MemoryLayout>(
+        s_memory_pool_alignment, ngraph::pass::MemoryLayout::allocation_scheme::OFFLINE);
+    pass_manager.run_passes(m_function);
+
+    if (pass_manager.get_state().get_functions().size() > 1)
+    {
+        throw ngraph_error("Direct execution does not support functions calling other functions");
     }
 
+    // Resolve where every tensor lives: constants, temporaries in the call frame's
+    // memory pool, then inputs and outputs of the call
+    for (shared_ptr<Node> node : m_function->get_ordered_ops())
+    {
+        if (node->is_constant())
+        {
+            shared_ptr<descriptor::TensorView> tv = node->get_outputs()[0].get_tensor_view();
+            m_tensor_locations[tv->get_tensor().get_name()] = {TensorLocation::Kind::Constant,
+                                                               add_constant(node)};
+        }
+        for (descriptor::Tensor* tensor : node->get_liveness_new_list())
+        {
+            m_tensor_locations[tensor->get_name()] = {TensorLocation::Kind::Pool,
+                                                      tensor->get_pool_offset()};
+        }
+    }
+    m_memory_pool_size = m_function->get_temporary_pool_size();
+
+    size_t arg_index = 0;
+    for (shared_ptr<ngraph::op::Parameter> param : m_function->get_parameters())
+    {
+        for (size_t i = 0; i < param->get_output_size(); ++i)
+        {
+            shared_ptr<descriptor::TensorView> tv = param->get_output_tensor_view(i);
+            m_tensor_locations[tv->get_tensor().get_name()] = {TensorLocation::Kind::Input,
+                                                               arg_index++};
+        }
+    }
+
+    for (size_t i = 0; i < m_function->get_output_size(); ++i)
+    {
+        shared_ptr<Node> op = m_function->get_output_op(i);
+        shared_ptr<descriptor::TensorView> tv = op->get_output_tensor_view();
+        TensorLocation location{TensorLocation::Kind::Output, i};
+        m_tensor_locations[tv->get_tensor().get_name()] = location;
+
+        // Same as for generated code, a result that does not need a copy shares
+        // the output with its argument
+        auto res = std::dynamic_pointer_cast<ngraph::op::Result>(op);
+        if (!res->needs_copy())
+        {
+            shared_ptr<descriptor::TensorView> itv =
+                res->get_inputs().at(0).get_output().get_tensor_view();
+            m_tensor_locations[itv->get_tensor().get_name()] = location;
+        }
+    }
+
+    for (shared_ptr<Node> node : m_function->get_ordered_ops())
+    {
+        auto& n = *node; // Work around a compiler warning (*node inside typeid may have effects
+        // with shared pointers, which is fine here but clang doesn't like it.)
+        auto handler = build_dispatcher.find(type_index(typeid(n)));
+        if (handler == build_dispatcher.end())
+        {
+            throw ngraph_error("Unhandled op during direct execution : " + node->description());
+        }
+        vector<TensorViewWrapper> in;
+        vector<string> node_input_names;
+        vector<string> node_output_names;
+        for (const descriptor::Input& input : node->get_inputs())
+        {
+            shared_ptr<descriptor::TensorView> tv = input.get_output().get_tensor_view();
+            in.push_back(TensorViewWrapper(tv, tv->get_tensor().get_name()));
+            node_input_names.emplace_back(tv->get_tensor().get_name());
+        }
+        vector<TensorViewWrapper> out;
+        for (const descriptor::Output& output : node->get_outputs())
+        {
+            shared_ptr<descriptor::TensorView> tv = output.get_tensor_view();
+            out.push_back(TensorViewWrapper(tv, tv->get_tensor().get_name()));
+            node_output_names.emplace_back(tv->get_tensor().get_name());
+        }
+
+        CPUKernelFunctor functor = handler->second(this, node.get(), in, out);
+        if (node->is_parameter() || node->is_constant())
+        {
+            continue;
+        }
+        // Op attributes, timers and functors share their index
+        m_op_attrs.emplace_back(node->description(), node_output_names, node_input_names);
+        if (m_emit_timing)
+        {
+            m_debug_timer_names.push_back(node->get_name());
+        }
+        m_functors.push_back(functor);
+    }
+
+    store_io_layouts();
+
+    vector<CPUKernelFunctor> functors = m_functors;
+    m_compiled_function = [functors](void** inputs, void** outputs, CPURuntimeContext* ctx) {
+        ctx->inputs = inputs;
+        ctx->outputs = outputs;
+        for (size_t i = 0; i < functors.size(); i++)
+        {
+            // Results whose copy was elided have nothing to run
+            if (!functors[i])
+            {
+                continue;
+            }
+            Timestamp start_ts;
+            if (ctx->tracer)
+            {
+                start_ts = Clock::now();
+            }
+            if (ctx->hw_counters)
+            {
+                ctx->hw_counters->start(i);
+            }
+            if (ctx->timers)
+            {
+                ctx->timers[i].start();
+            }
+            functors[i](ctx);
+            if (ctx->timers)
+            {
+                ctx->timers[i].stop();
+            }
+            if (ctx->hw_counters)
+            {
+                ctx->hw_counters->stop(i);
+            }
+            if (ctx->tracer)
+            {
+                ctx->tracer->record(i, start_ts, Clock::now());
+            }
+        }
+    };
+
+    m_is_compiled = true;
+    if (m_release_function)
+    {
+        release_function();
+    }
+}
+
+void runtime::cpu::CPU_ExternalFunction::store_io_layouts()
+{
     // Store layouts assigned for arguments
     for (const auto& parameter : m_function->get_parameters())
     {
@@ -850,49 +1454,268 @@ using namespace ngraph::runtime;
                 static_pointer_cast<runtime::cpu::LayoutDescriptor>(tv->get_tensor_view_layout()));
         }
     }
+}
 
-    // TODO: Cleanup and make this a utility function
-    file_util::make_directory(s_output_dir);
-    string filename = file_util::path_join(s_output_dir, m_function_name + "_codegen.cpp");
-    ofstream out(filename);
-    string code = writer.get_code();
-    out << code;
-    out.close();
-
-    m_compiler.reset(new codegen::Compiler());
-    m_execution_engine.reset(new codegen::ExecutionEngine());
+size_t runtime::cpu::CPU_ExternalFunction::add_constant(const shared_ptr<Node>& node)
+{
+    const ngraph::op::Constant* c = static_cast<ngraph::op::Constant*>(node.get());
+    size_t index = m_constant_data.size();
+    m_active_constants.push_back(node);
+    m_constant_data.push_back(const_cast<void*>(c->get_data_ptr()));
+    m_constant_buffers.emplace_back();
+    m_bound_constants.emplace_back();
+    m_constant_indices[node->get_friendly_name()].push_back(index);
+    return index;
+}
 
-    m_compiler->set_precompiled_header_source(pch_header_source);
+const vector<size_t>&
+    runtime::cpu::CPU_ExternalFunction::get_constant_indices(const string& name) const
+{
+    if (!m_is_compiled)
+    {
+        throw ngraph_error("Constants can only be replaced once the function is compiled");
+    }
+    auto it = m_constant_indices.find(name);
+    if (it == m_constant_indices.end())
+    {
+        throw ngraph_error("Constant " + name +
+                           " is not used by the compiled function. It may have been folded, "
+                           "see set_updatable_constants.");
+    }
+    return it->second;
+}
 
-    auto codegen_module = m_compiler->compile(code);
+void runtime::cpu::CPU_ExternalFunction::set_updatable_constants(const set<string>& names)
+{
+    if (m_is_compiled)
+    {
+        throw ngraph_error("Updatable constants must be set before the function is compiled");
+    }
+    m_updatable_constants = names;
+}
 
-    if (codegen_module == nullptr)
+void runtime::cpu::CPU_ExternalFunction::update_constant(const string& name,
+                                                         const void* data,
+                                                         size_t size)
+{
+    for (size_t index : get_constant_indices(name))
     {
-        throw runtime_error("function failed to compile");
+        const descriptor::Tensor& tensor = m_active_constants[index]->get_output_tensor(0);
+        if (size != tensor.size())
+        {
+            throw ngraph_error("Constant " + name + " holds " + to_string(tensor.size()) +
+                               " bytes, not " + to_string(size));
+        }
+        // The Function may be shared with other backends, so its constants are left alone
+        if (!m_constant_buffers[index])
+        {
+            m_constant_buffers[index].reset(new AlignedBuffer(size, s_memory_pool_alignment));
+        }
+        memcpy(m_constant_buffers[index]->get_ptr(), data, size);
+        m_constant_data[index] = m_constant_buffers[index]->get_ptr();
+        m_bound_constants[index] = nullptr;
     }
-    m_execution_engine->add_module(codegen_module);
-    m_execution_engine->finalize();
-    m_compiled_function = m_execution_engine->find_function<EntryPoint_t>(m_function_name);
+}
 
-    if (m_compiled_function == nullptr)
+void runtime::cpu::CPU_ExternalFunction::bind_constant(
+    const string& name, const shared_ptr<runtime::TensorView>& tensor)
+{
+    auto tv = dynamic_pointer_cast<runtime::cpu::CPUTensorView>(tensor);
+    if (!tv)
     {
-        throw runtime_error("could not find compiled function");
+        throw ngraph_error("Only CPU tensors can be bound to constants");
     }
+    for (size_t index : get_constant_indices(name))
+    {
+        const shared_ptr<Node>& constant = m_active_constants[index];
+        if (tv->get_element_type() != constant->get_element_type() ||
+            tv->get_shape() != constant->get_shape())
+        {
+            throw ngraph_error("Tensor bound to constant " + name +
+                               " does not match its element type and shape");
+        }
+        m_constant_data[index] = tv->get_data_ptr();
+        m_bound_constants[index] = tensor;
+        m_constant_buffers[index].reset();
+    }
+}
 
-    m_is_compiled = true;
-    if (m_release_function)
+const runtime::cpu::TensorLocation&
+    runtime::cpu::CPU_ExternalFunction::get_tensor_location(const string& name) const
+{
+    auto it = m_tensor_locations.find(name);
+    if (it == m_tensor_locations.end())
     {
-        release_function();
+        throw ngraph_error("No location for tensor " + name);
     }
+    return it->second;
 }
 
-shared_ptr<ngraph::runtime::CallFrame> runtime::cpu::CPU_ExternalFunction::make_call_frame()
+void runtime::cpu::CPU_ExternalFunction::export_function(const string& directory)
 {
+    if (m_direct_execution)
+    {
+        throw ngraph_error("Direct execution functions have no code to export");
+    }
     if (!m_is_compiled)
     {
         compile();
     }
 
+    // MKLDNN primitives are created by each call frame and only exist in this process
+    if (m_mkldnn_emitter->get_primitive_count() > 0)
+    {
+        throw ngraph_error("Exporting functions that use MKLDNN primitives is not supported");
+    }
+
+    // The library may be loaded on another machine, so it targets a portable ISA unless
+    // NGRAPH_CPU_EXPORT_ISA names another -march value. The loader checks that the CPU has
+    // the features the ISA implies.
+    const char* env_isa = std::getenv("NGRAPH_CPU_EXPORT_ISA");
+    const char* env_cxx = std::getenv("NGRAPH_CPU_EXPORT_CXX");
+    const char* env_cxx_flags = std::getenv("NGRAPH_CPU_EXPORT_CXXFLAGS");
+    string isa = env_isa ? env_isa : "x86-64";
+    stringstream compiler;
+    compiler << (env_cxx ? env_cxx : "c++") << " -std=c++11 -O3 -march=" << shell_quote(isa);
+    if (env_cxx_flags)
+    {
+        compiler << " " << env_cxx_flags;
+    }
+
+    nlohmann::json manifest;
+    manifest["function"] = m_function_name;
+    manifest["library"] = "lib" + m_function_name + ".so";
+    manifest["isa"] = isa;
+    manifest["cpu_features"] = get_cpu_features(compiler.str());
+    manifest["memory_pool_size"] = m_memory_pool_size;
+    manifest["memory_pool_alignment"] = s_memory_pool_alignment;
+    // Trace records are indexed by op, so the loader can write timelines like we do
+    nlohmann::json traced_ops = nlohmann::json::array();
+    if (runtime::cpu::IsTracingEnabled())
+    {
+        for (const OpAttributes& op_attrs : m_op_attrs)
+        {
+            traced_ops.push_back({{"description", op_attrs.Description},
+                                  {"outputs", op_attrs.Outputs},
+                                  {"inputs", op_attrs.Inputs}});
+        }
+    }
+    manifest["traced_ops"] = traced_ops;
+
+    auto write_tensors = [](const LayoutDescriptorPtrs& layouts) {
+        nlohmann::json tensors = nlohmann::json::array();
+        for (auto& layout : layouts)
+        {
+            if (layout->get_mkldnn_format() != mkldnn::memory::format::format_undef &&
+                !mkldnn_utils::compare_mkldnn_formats(
+                    layout->get_mkldnn_format(), mkldnn_utils::CreateNativeDataFormat(*layout)))
+            {
+                throw ngraph_error("Exporting functions with non-native tensor layouts is not "
+                                   "supported");
+            }
+            nlohmann::json tensor;
+            tensor["element_type"] = layout->get_element_type().c_type_string();
+            tensor["shape"] = layout->get_shape();
+            tensor["size"] = layout->get_size() * layout->get_element_type().size();
+            tensors.push_back(tensor);
+        }
+        return tensors;
+    };
+    manifest["parameters"] = write_tensors(parameter_layout_descriptors);
+    manifest["results"] = write_tensors(result_layout_descriptors);
+
+    // All constant data goes into one blob, in the order of ctx->constants
+    string constant_file = m_function_name + ".constants";
+    manifest["constant_data"] = constant_file;
+    nlohmann::json constants = nlohmann::json::array();
+    size_t offset = 0;
+    file_util::make_directory(directory);
+    ofstream constant_out(file_util::path_join(directory, constant_file), ios::binary);
+    for (size_t i = 0; i < m_active_constants.size(); i++)
+    {
+        const descriptor::Tensor& tensor = m_active_constants[i]->get_output_tensor(0);
+        offset = round_up(offset, s_memory_pool_alignment);
+        constant_out.seekp(offset);
+        constant_out.write(static_cast<const char*>(m_constant_data[i]), tensor.size());
+
+        nlohmann::json constant;
+        constant["name"] = m_active_constants[i]->get_name();
+        constant["offset"] = offset;
+        constant["size"] = tensor.size();
+        constants.push_back(constant);
+        offset += tensor.size();
+    }
+    constant_out.close();
+    if (!constant_out)
+    {
+        throw ngraph_error("Unable to write constant data to " + directory);
+    }
+    manifest["constants"] = constants;
+
+    string source_path = file_util::path_join(directory, m_function_name + ".cpp");
+    ofstream source_out(source_path);
+    source_out << m_generated_code;
+    source_out.close();
+
+    ofstream manifest_out(file_util::path_join(directory, m_function_name + ".json"));
+    manifest_out << manifest.dump(4);
+    manifest_out.close();
+
+    // The library links against the runtime kernels of the libngraph we are part of
+    Dl_info info;
+    dladdr(reinterpret_cast<void*>(&runtime::cpu::IsTracingEnabled), &info);
+    string ngraph_library_dir = file_util::get_directory(info.dli_fname);
+
+    stringstream command;
+    command << compiler.str() << " -shared -fPIC -fopenmp -DEIGEN_MPL2_ONLY -DNGRAPH_CPU_EXPORT";
+    for (const string& path : {string(NGRAPH_HEADERS_PATH),
+                               string(INSTALLED_HEADERS_PATH),
+                               string(EIGEN_HEADERS_PATH),
+                               string(MKLDNN_HEADERS_PATH)})
+    {
+        command << " -isystem " << shell_quote(path);
+    }
+#ifdef NGRAPH_TBB_ENABLE
+    command << " -isystem " << shell_quote(TBB_HEADERS_PATH);
+#endif
+    string library_path = file_util::path_join(directory, manifest["library"]);
+    command << " -o " << shell_quote(library_path) << " " << shell_quote(source_path);
+    command << " -L" << shell_quote(ngraph_library_dir) << " "
+            << shell_quote("-Wl,-rpath," + ngraph_library_dir) << " -lngraph";
+    if (m_use_tbb)
+    {
+        command << " -ltbb";
+    }
+    NGRAPH_DEBUG << command.str();
+    if (std::system(command.str().c_str()) != 0)
+    {
+        throw ngraph_error("Failed to build exported function: " + command.str());
+    }
+}
+
+size_t runtime::cpu::CPU_ExternalFunction::get_memory_pool_alignment() const
+{
+    return s_memory_pool_alignment;
+}
+
+shared_ptr<ngraph::runtime::CallFrame> runtime::cpu::CPU_ExternalFunction::make_call_frame()
+{
+    {
+        // Call frames may be created from several threads
+        lock_guard<mutex> lock(m_compile_mutex);
+        if (!m_is_compiled)
+        {
+            if (m_direct_execution)
+            {
+                build();
+            }
+            else
+            {
+                compile();
+            }
+        }
+    }
+
     return make_shared<ngraph::runtime::cpu::CPU_CallFrame>(shared_from_this(),
                                                             m_compiled_function);
 }
@@ -917,7 +1740,12 @@ void runtime::cpu::CPU_ExternalFunction::emit_debug_function_entry(
 {
     if (m_emit_timing)
     {
-        writer << "timers[" << m_name_index_map[node->get_name()] << "].start();\n";
+        size_t index = m_name_index_map[node->get_name()];
+        writer << "if (ctx->hw_counters)\n";
+        writer << "{\n";
+        writer << "    ctx->hw_counters->start(" << index << ");\n";
+        writer << "}\n";
+        writer << "ctx->timers[" << index << "].start();\n";
     }
 }
 
@@ -929,7 +1757,12 @@ void runtime::cpu::CPU_ExternalFunction::emit_debug_function_exit(
 {
     if (m_emit_timing)
     {
-        writer << "timers[" << m_name_index_map[node->get_name()] << "].stop();\n";
+        size_t index = m_name_index_map[node->get_name()];
+        writer << "ctx->timers[" << index << "].stop();\n";
+        writer << "if (ctx->hw_counters)\n";
+        writer << "{\n";
+        writer << "    ctx->hw_counters->stop(" << index << ");\n";
+        writer << "}\n";
     }
 }
 
@@ -943,7 +1776,8 @@ string runtime::cpu::CPU_ExternalFunction::emit_op_as_function(const Node& node,
                                                                const string& function_name)
 {
     codegen::CodeWriter writer;
-    writer << "static void " << function_name << "(";
+    // Not static since the function may be called from other modules
+    writer << "void " << function_name << "(";
     writer.indent++;
     // Work around a compiler warning (*node inside typeid may have effects
     // with shared pointers, which is fine here but clang doesn't like it.)
@@ -19,6 +19,8 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <typeindex>
 #include <typeinfo>
@@ -32,6 +34,7 @@
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view_wrapper.hpp"
+#include "ngraph/runtime/cpu/cpu_trace_buffer.hpp"
 #include "ngraph/runtime/cpu/mkldnn_emitter.hpp"
 #include "ngraph/runtime/external_function.hpp"
 
@@ -53,6 +56,51 @@ namespace ngraph
 
             using OpMap = std::unordered_map<std::type_index, OpFunction>;
 
+            // Runs one op of a direct execution (NGRAPH_DEX) function
+            using CPUKernelFunctor = std::function<void(CPURuntimeContext* ctx)>;
+
+            using BuildOpFunction =
+                std::function<CPUKernelFunctor(CPU_ExternalFunction* external_function,
+                                               const ngraph::Node*,
+                                               const std::vector<TensorViewWrapper>& inputs,
+                                               const std::vector<TensorViewWrapper>& outputs)>;
+
+            using BuildOpMap = std::unordered_map<std::type_index, BuildOpFunction>;
+
+            // Where the data of a tensor lives during a direct execution call. Resolved
+            // against the call's context so that call frames can run concurrently.
+            struct TensorLocation
+            {
+                enum class Kind
+                {
+                    Input,
+                    Output,
+                    Constant,
+                    Pool
+                };
+
+                Kind kind;
+                // Input, output or constant index, or the offset into the memory pool
+                size_t index;
+
+                void* get(CPURuntimeContext* ctx) const
+                {
+                    switch (kind)
+                    {
+                    case Kind::Input: return ctx->inputs[index];
+                    case Kind::Output: return ctx->outputs[index];
+                    case Kind::Constant: return ctx->constants[index];
+                    case Kind::Pool: return static_cast<char*>(ctx->memory_pool) + index;
+                    }
+                    return nullptr;
+                }
+
+                bool operator==(const TensorLocation& other) const
+                {
+                    return kind == other.kind && index == other.index;
+                }
+            };
+
             struct OpAttributes
             {
                 std::string Description;
@@ -89,12 +137,73 @@ namespace ngraph
                 }
 
                 const std::string& get_function_name() const { return m_function_name; }
+                const std::vector<void*>& get_constant_data() const { return m_constant_data; }
+                /// @brief Names of the ops timed with NGRAPH_CPU_EMIT_TIMING, indexed like
+                /// CPURuntimeContext::timers
+                const std::vector<std::string>& get_debug_timer_names() const
+                {
+                    return m_debug_timer_names;
+                }
+                /// @brief Size of the temporary memory pool each call frame must provide
+                /// to the entry point through CPURuntimeContext::memory_pool
+                size_t get_memory_pool_size() const { return m_memory_pool_size; }
+                size_t get_memory_pool_alignment() const;
+                /// @brief Whether the entry point runs its ops on a TBB flow graph, which
+                /// only orders an op after the producers of its inputs
+                bool is_using_tbb() const { return m_use_tbb; }
+                /// @brief Whether the function was compiled for direct execution (NGRAPH_DEX)
+                bool is_direct_execution() const { return m_direct_execution; }
+                /// @brief Number of modules the generated code was split into for concurrent
+                /// compilation
+                size_t get_module_count() const { return m_module_count; }
+
+                /// @brief Keeps the constants with these friendly names out of constant folding
+                /// so that their data can still be replaced once the function is compiled.
+                /// Must be called before the first call frame is made.
+                void set_updatable_constants(const std::set<std::string>& names);
+                /// @brief Replaces the data of the constants with the given friendly name.
+                ///
+                /// The new data is used by the next call of every call frame of this function,
+                /// so it must not be updated while one of them is running.
+                void update_constant(const std::string& name, const void* data, size_t size);
+                /// @brief Makes the constants with the given friendly name read their data from
+                /// tensor, which the caller may then write between calls.
+                void bind_constant(const std::string& name,
+                                   const std::shared_ptr<runtime::TensorView>& tensor);
+
+                /// @brief Execution trace of all call frames of this function, only set with
+                /// NGRAPH_CPU_TRACING. Records are indexed like get_op_attrs().
+                TraceBuffer* get_trace_buffer() const { return m_trace_buffer.get(); }
+                /// @brief Writes the ops held by the trace buffer as a Chrome trace. This is
+                /// also done, to GetTimelinePath(), when the function is destroyed.
+                void write_timeline(const std::string& file_name) const;
+
+                /// @brief Location of a tensor of the direct execution function, by tensor name
+                const TensorLocation& get_tensor_location(const std::string& name) const;
+
+                /// @brief Writes the generated code, a JSON manifest describing the function's
+                /// interface and the constant data to directory, and builds the code into
+                /// lib<function name>.so for CPU_ExportedFunction to load without the JIT.
+                /// The library targets -march=x86-64, or the ISA named by
+                /// NGRAPH_CPU_EXPORT_ISA, which is recorded in the manifest.
+                void export_function(const std::string& directory);
             protected:
                 void compile();
+                // Direct execution: binds every op to a precompiled kernel instead of
+                // generating and JIT compiling code
+                void build();
 
                 EntryPoint m_compiled_function;
+                // Only set with NGRAPH_CPU_USE_TBB
+                std::function<MakeFlowGraph_t> m_make_flow_graph;
+                std::function<FreeFlowGraph_t> m_free_flow_graph;
 
             private:
+                // Adds a constant to ctx->constants and returns its index
+                size_t add_constant(const std::shared_ptr<Node>& node);
+                const std::vector<size_t>& get_constant_indices(const std::string& name) const;
+                // Keeps the layouts assigned to the function's parameters and results
+                void store_io_layouts();
                 void emit_debug_function_entry(codegen::CodeWriter& writer,
                                                Node* node,
                                                const std::vector<TensorViewWrapper>& in,
@@ -119,21 +228,40 @@ namespace ngraph
                 std::unique_ptr<codegen::ExecutionEngine> m_execution_engine;
                 bool m_emit_timing;
                 bool m_use_tbb;
+                bool m_direct_execution;
+                size_t m_memory_pool_size;
+                size_t m_module_count;
                 std::unordered_map<std::string, std::string> m_variable_name_map;
                 std::map<std::string, size_t> m_name_index_map;
+                std::vector<std::string> m_debug_timer_names;
+                std::mutex m_compile_mutex;
 
                 // Because we are directly accessing the constant data stored in the
                 // Constant ops we need to keep a list of shared_ptr to each Constant
                 // so they don't get freed before we are done with them
                 std::vector<std::shared_ptr<Node>> m_active_constants;
+                // Data pointers of m_active_constants, indexed like ctx->constants
+                std::vector<void*> m_constant_data;
+                std::set<std::string> m_updatable_constants;
+                std::unordered_map<std::string, std::vector<size_t>> m_constant_indices;
+                // Storage of updated constants, so the Function's own constants are never
+                // written, and tensors bound to constants, indexed like ctx->constants
+                std::vector<std::unique_ptr<AlignedBuffer>> m_constant_buffers;
+                std::vector<std::shared_ptr<runtime::TensorView>> m_bound_constants;
 
                 LayoutDescriptorPtrs parameter_layout_descriptors;
                 LayoutDescriptorPtrs result_layout_descriptors;
                 std::vector<OpAttributes> m_op_attrs;
+                std::unique_ptr<TraceBuffer> m_trace_buffer;
+
+                // Only set with NGRAPH_DEX
+                std::unordered_map<std::string, TensorLocation> m_tensor_locations;
+                std::vector<CPUKernelFunctor> m_functors;
 
                 std::unique_ptr<MKLDNNEmitter> m_mkldnn_emitter;
 
                 std::string m_function_name;
+                std::string m_generated_code;
             };
         }
     }
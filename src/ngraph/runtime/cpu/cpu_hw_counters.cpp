@@ -0,0 +1,156 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ngraph/runtime/cpu/cpu_hw_counters.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // The counters of one thread, opened the first time the thread reads them
+    class ThreadCounters
+    {
+    public:
+        ThreadCounters()
+        {
+#ifdef __linux__
+            // Events are opened one by one since inherited events cannot be read as a group
+            // on older kernels
+            const uint64_t configs[] = {PERF_COUNT_HW_CPU_CYCLES,
+                                        PERF_COUNT_HW_INSTRUCTIONS,
+                                        PERF_COUNT_HW_CACHE_MISSES};
+            for (size_t i = 0; i < 3; i++)
+            {
+                m_fds[i] = open_counter(configs[i]);
+                if (m_fds[i] < 0)
+                {
+                    close_all();
+                    return;
+                }
+            }
+#endif
+        }
+
+        ~ThreadCounters() { close_all(); }
+        bool is_open() const { return m_fds[0] >= 0; }
+        bool read_counts(runtime::cpu::HardwareCounts& counts)
+        {
+            return is_open() && read_counter(m_fds[0], counts.cycles) &&
+                   read_counter(m_fds[1], counts.instructions) &&
+                   read_counter(m_fds[2], counts.cache_misses);
+        }
+
+    private:
+#ifdef __linux__
+        static int open_counter(uint64_t config)
+        {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            // Also count the threads this one starts from now on, such as OpenMP workers
+            attr.inherit = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+
+        static bool read_counter(int fd, uint64_t& count)
+        {
+#ifdef __linux__
+            // The count, then how long the event was enabled and how long it was actually
+            // counting. The two differ when the PMU multiplexes more events than it has
+            // counters, and the count is then extrapolated to the enabled time.
+            uint64_t values[3];
+            if (read(fd, values, sizeof(values)) == sizeof(values))
+            {
+                double scale = values[2] == 0 ? 0.0 : static_cast<double>(values[1]) / values[2];
+                count = static_cast<uint64_t>(values[0] * scale);
+                return true;
+            }
+#endif
+            return false;
+        }
+
+        void close_all()
+        {
+            for (int& fd : m_fds)
+            {
+                if (fd >= 0)
+                {
+#ifdef __linux__
+                    close(fd);
+#endif
+                    fd = -1;
+                }
+            }
+        }
+
+        int m_fds[3] = {-1, -1, -1};
+    };
+
+    ThreadCounters& get_thread_counters()
+    {
+        static thread_local ThreadCounters counters;
+        return counters;
+    }
+}
+
+runtime::cpu::HardwareCounters::HardwareCounters(size_t op_count)
+    : m_start(op_count, HardwareCounts{0, 0, 0})
+    , m_totals(op_count, HardwareCounts{0, 0, 0})
+{
+}
+
+void runtime::cpu::HardwareCounters::start(size_t op)
+{
+    get_thread_counters().read_counts(m_start[op]);
+}
+
+void runtime::cpu::HardwareCounters::stop(size_t op)
+{
+    HardwareCounts end;
+    if (get_thread_counters().read_counts(end))
+    {
+        m_totals[op].cycles += end.cycles - m_start[op].cycles;
+        m_totals[op].instructions += end.instructions - m_start[op].instructions;
+        m_totals[op].cache_misses += end.cache_misses - m_start[op].cache_misses;
+    }
+}
+
+bool runtime::cpu::HardwareCounters::is_available()
+{
+    return get_thread_counters().is_open();
+}
+
+bool runtime::cpu::HardwareCounters::is_enabled()
+{
+    return std::getenv("NGRAPH_CPU_PERF_COUNTERS") != nullptr;
+}
@@ -0,0 +1,67 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            struct HardwareCounts
+            {
+                uint64_t cycles;
+                uint64_t instructions;
+                uint64_t cache_misses;
+            };
+
+            // Per op CPU cycle, instruction and last level cache miss counts, read from
+            // Linux perf_event_open around each op timed with NGRAPH_CPU_EMIT_TIMING.
+            //
+            // Each thread that runs an op opens its own counters on first use. The counters
+            // are inherited by the threads it starts afterwards, so the OpenMP workers of a
+            // kernel are counted with its op as long as the pool was started after the
+            // counters were opened. Ops that other inherited threads run concurrently, such
+            // as TBB workers, are then mixed in. When the PMU multiplexes events the counts
+            // are scaled up from the time they were actually counting, so they are estimates.
+            // Where the counters cannot be opened (non Linux hosts, or restricted by
+            // perf_event_paranoid) all counts stay zero.
+            class HardwareCounters
+            {
+            public:
+                HardwareCounters(size_t op_count);
+
+                void start(size_t op);
+                void stop(size_t op);
+
+                const HardwareCounts& get_counts(size_t op) const { return m_totals[op]; }
+                /// @brief True if the counters of the calling thread could be opened
+                static bool is_available();
+                /// @brief NGRAPH_CPU_PERF_COUNTERS is set
+                static bool is_enabled();
+
+            private:
+                std::vector<HardwareCounts> m_start;
+                std::vector<HardwareCounts> m_totals;
+            };
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+
+#include "ngraph/op_cost.hpp"
+#include "ngraph/runtime/cpu/ops/conv_bias.hpp"
+#include "ngraph/runtime/cpu/ops/loop_kernel.hpp"
+#include "ngraph/runtime/cpu/ops/matmul_bias.hpp"
+#include "ngraph/runtime/cpu/ops/sigmoid.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#define TI(x) type_index(typeid(x))
+
+// exp, add and divide per element
+static const size_t s_sigmoid_flops = 3;
+
+// FLOPs of the CPU backend's fused ops, counted as the ops they replace
+class CPUFlopsCounters
+{
+public:
+    CPUFlopsCounters()
+    {
+        register_flops_counter(TI(op::MatmulBias), [](const Node& node) {
+            auto& matmul = static_cast<const op::MatmulBias&>(node);
+            size_t reduction_size =
+                matmul.get_arg0_shape().at(matmul.get_is_arg0_transposed() ? 0 : 1);
+            size_t flops = 2 * shape_size(node.get_shape()) * reduction_size;
+            if (node.get_input_size() == 3)
+            {
+                flops += shape_size(node.get_shape());
+            }
+            return flops;
+        });
+        register_flops_counter(TI(op::ConvolutionBias), [](const Node& node) {
+            const Shape& filters_shape = node.get_input_shape(1);
+            size_t output_size = shape_size(node.get_shape());
+            return 2 * output_size * shape_size(filters_shape) / filters_shape[0] + output_size;
+        });
+        register_flops_counter(TI(op::ConvolutionBiasBackpropFiltersBias), [](const Node& node) {
+            auto& backprop = static_cast<const op::ConvolutionBiasBackpropFiltersBias&>(node);
+            const Shape& filters_shape = backprop.get_filters_shape();
+            size_t delta_size = shape_size(node.get_input_shape(1));
+            // Filters backprop, then summing the deltas for the bias
+            return 2 * delta_size * shape_size(filters_shape) / filters_shape[0] + delta_size;
+        });
+        register_flops_counter(TI(op::Sigmoid), [](const Node& node) {
+            return s_sigmoid_flops * shape_size(node.get_shape());
+        });
+        register_flops_counter(TI(op::SigmoidBackprop), [](const Node& node) {
+            // The forward sigmoid, then delta * s * (1 - s)
+            return (s_sigmoid_flops + 3) * shape_size(node.get_shape());
+        });
+        register_flops_counter(TI(runtime::cpu::op::LoopKernel), [](const Node& node) {
+            auto& kernel = static_cast<const runtime::cpu::op::LoopKernel&>(node);
+            size_t flops_per_element = 0;
+            for (const runtime::cpu::op::LoopKernel::Operation& operation :
+                 kernel.get_operations())
+            {
+                if (operation.description == "Sigmoid")
+                {
+                    flops_per_element += s_sigmoid_flops;
+                }
+                else if (operation.description != "Select")
+                {
+                    flops_per_element++;
+                }
+            }
+            return flops_per_element * shape_size(node.get_shape());
+        });
+    }
+};
+
+static CPUFlopsCounters s_cpu_flops_counters;
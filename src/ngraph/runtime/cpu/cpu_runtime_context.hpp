@@ -26,10 +26,15 @@ namespace mkldnn
 
 namespace ngraph
 {
+    class stopwatch;
+
     namespace runtime
     {
         namespace cpu
         {
+            class HardwareCounters;
+            class TraceBuffer;
+
             typedef std::chrono::high_resolution_clock Clock;
             typedef std::chrono::time_point<Clock> Timestamp;
             typedef std::chrono::microseconds Timescale;
@@ -37,9 +42,22 @@ namespace ngraph
             extern "C" {
             struct CPURuntimeContext
             {
-                int64_t* op_durations;
+                // Execution trace (NGRAPH_CPU_TRACING), shared by the function's call frames
+                TraceBuffer* tracer;
                 mkldnn::primitive* const* mkldnn_primitives;
                 char* const* mkldnn_workspaces;
+                void* const* constants;
+                void* memory_pool;
+                // Tensors of the current call, for code that outlives a single invocation
+                void** inputs;
+                void** outputs;
+                // Prebuilt TBB dependency graph of the entry point, owned by the call frame
+                void* flow_graph;
+                // Debug timers (NGRAPH_CPU_EMIT_TIMING), one per op
+                ngraph::stopwatch* timers;
+                // Hardware counters of the timed ops (NGRAPH_CPU_PERF_COUNTERS), indexed
+                // like timers
+                HardwareCounters* hw_counters;
             };
             }
         }
@@ -0,0 +1,122 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+
+#include "ngraph/runtime/cpu/cpu_trace_buffer.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static atomic<size_t> s_next_buffer_id(1);
+
+// The ring of the buffer this thread recorded to last, so recording only locks the buffer
+// when a thread starts recording to it
+static thread_local size_t s_cached_buffer_id = 0;
+static thread_local void* s_cached_ring = nullptr;
+
+runtime::cpu::TraceBuffer::TraceBuffer(size_t capacity)
+    : m_id(s_next_buffer_id++)
+{
+    size_t size = 1;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    m_mask = size - 1;
+}
+
+runtime::cpu::TraceBuffer::ThreadRing& runtime::cpu::TraceBuffer::get_thread_ring()
+{
+    if (s_cached_buffer_id == m_id)
+    {
+        return *static_cast<ThreadRing*>(s_cached_ring);
+    }
+
+    lock_guard<mutex> lock(m_mutex);
+    thread::id id = this_thread::get_id();
+    ThreadRing* ring = nullptr;
+    for (const unique_ptr<ThreadRing>& r : m_rings)
+    {
+        if (r->thread == id)
+        {
+            ring = r.get();
+            break;
+        }
+    }
+    if (ring == nullptr)
+    {
+        m_rings.emplace_back(new ThreadRing());
+        ring = m_rings.back().get();
+        ring->thread = id;
+        ring->records.reset(new TraceRecord[m_mask + 1]);
+        ring->next.store(0);
+    }
+    s_cached_buffer_id = m_id;
+    s_cached_ring = ring;
+    return *ring;
+}
+
+void runtime::cpu::TraceBuffer::record(size_t op, const Timestamp& start, const Timestamp& end)
+{
+    ThreadRing& ring = get_thread_ring();
+    size_t next = ring.next.load(memory_order_relaxed);
+    TraceRecord& rec = ring.records[next & m_mask];
+    rec.op = op;
+    rec.thread = ring.thread;
+    rec.start = start;
+    rec.end = end;
+    ring.next.store(next + 1, memory_order_release);
+}
+
+size_t runtime::cpu::TraceBuffer::get_record_count() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    size_t count = 0;
+    for (const unique_ptr<ThreadRing>& ring : m_rings)
+    {
+        count += ring->next.load(memory_order_acquire);
+    }
+    return count;
+}
+
+vector<runtime::cpu::TraceRecord> runtime::cpu::TraceBuffer::get_records() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    vector<TraceRecord> records;
+    for (const unique_ptr<ThreadRing>& ring : m_rings)
+    {
+        size_t next = ring->next.load(memory_order_acquire);
+        size_t count = min(next, get_capacity());
+        for (size_t i = next - count; i < next; i++)
+        {
+            records.push_back(ring->records[i & m_mask]);
+        }
+    }
+    stable_sort(records.begin(), records.end(), [](const TraceRecord& a, const TraceRecord& b) {
+        return a.start < b.start;
+    });
+    return records;
+}
+
+void runtime::cpu::TraceBuffer::clear()
+{
+    lock_guard<mutex> lock(m_mutex);
+    for (const unique_ptr<ThreadRing>& ring : m_rings)
+    {
+        ring->next.store(0);
+    }
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ngraph/runtime/cpu/cpu_runtime_context.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            // One execution of an op, indexed like CPU_ExternalFunction::get_op_attrs()
+            struct TraceRecord
+            {
+                size_t op;
+                std::thread::id thread;
+                Timestamp start;
+                Timestamp end;
+            };
+
+            // The most recent op executions of a function, shared by all of its call frames.
+            // Every thread records into a fixed size ring of its own, so ops run by concurrent
+            // call frames or TBB workers neither contend on a shared cursor nor write to the
+            // same records. Once a thread's ring is full its oldest records are overwritten.
+            class TraceBuffer
+            {
+            public:
+                // capacity, the number of records kept per thread, is rounded up to a power
+                // of two
+                TraceBuffer(size_t capacity);
+
+                void record(size_t op, const Timestamp& start, const Timestamp& end);
+
+                size_t get_capacity() const { return m_mask + 1; }
+                // Number of records made since the last clear, including overwritten ones
+                size_t get_record_count() const;
+                // The records still held by all threads, oldest first. No call may be running.
+                std::vector<TraceRecord> get_records() const;
+                // No call may be running.
+                void clear();
+
+            private:
+                struct ThreadRing
+                {
+                    std::thread::id thread;
+                    std::unique_ptr<TraceRecord[]> records;
+                    // Only written by the ring's thread
+                    std::atomic<size_t> next;
+                };
+
+                ThreadRing& get_thread_ring();
+
+                // Distinguishes this buffer from all others, including destroyed ones
+                size_t m_id;
+                size_t m_mask;
+                mutable std::mutex m_mutex;
+                std::vector<std::unique_ptr<ThreadRing>> m_rings;
+            };
+        }
+    }
+}
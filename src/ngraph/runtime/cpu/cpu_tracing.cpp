@@ -14,10 +14,13 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <map>
 
 #include "cpu_tracing.hpp"
+#include "ngraph/file_util.hpp"
 
 void ngraph::runtime::cpu::to_json(nlohmann::json& json, const TraceEvent& event)
 {
@@ -42,29 +45,47 @@ void ngraph::runtime::cpu::to_json(nlohmann::json& json, const TraceEvent& event
 }
 
 void ngraph::runtime::cpu::GenerateTimeline(const std::vector<OpAttributes>& op_attrs,
-                                            int64_t* op_durations,
+                                            const TraceBuffer& trace,
                                             const std::string& file_name)
 {
     nlohmann::json timeline;
-    std::list<TraceEvent> trace;
+    std::list<TraceEvent> events;
     std::ofstream out(file_name);
 
-    int64_t ts = 0;
-    for (size_t i = 0; i < op_attrs.size(); i++)
+    std::vector<TraceRecord> records = trace.get_records();
+    Timestamp origin;
+    if (!records.empty())
     {
-        trace.emplace_back("X",
-                           "Op",
-                           op_attrs[i].Description,
-                           0,
-                           0,
-                           ts,
-                           op_durations[i],
-                           op_attrs[i].Outputs,
-                           op_attrs[i].Inputs);
-        ts += op_durations[i];
+        origin = records.front().start;
+        for (const TraceRecord& record : records)
+        {
+            origin = std::min(origin, record.start);
+        }
     }
 
-    timeline["traceEvents"] = trace;
+    // Chrome tracing wants small integer thread ids
+    std::map<std::thread::id, unsigned int> thread_ids;
+    for (const TraceRecord& record : records)
+    {
+        if (record.op >= op_attrs.size())
+        {
+            continue;
+        }
+        auto tid = thread_ids.insert({record.thread, thread_ids.size()}).first->second;
+        auto ts = std::chrono::duration_cast<Timescale>(record.start - origin).count();
+        auto dur = std::chrono::duration_cast<Timescale>(record.end - record.start).count();
+        events.emplace_back("X",
+                            "Op",
+                            op_attrs[record.op].Description,
+                            0,
+                            tid,
+                            ts,
+                            dur,
+                            op_attrs[record.op].Outputs,
+                            op_attrs[record.op].Inputs);
+    }
+
+    timeline["traceEvents"] = events;
     out << timeline;
     out.close();
 
@@ -75,3 +96,16 @@ bool ngraph::runtime::cpu::IsTracingEnabled()
 {
     return (std::getenv("NGRAPH_CPU_TRACING") != nullptr);
 }
+
+size_t ngraph::runtime::cpu::GetTraceBufferSize()
+{
+    const char* env = std::getenv("NGRAPH_CPU_TRACE_BUFFER_SIZE");
+    return env ? std::strtoul(env, nullptr, 10) : (1 << 16);
+}
+
+std::string ngraph::runtime::cpu::GetTimelinePath(const std::string& function_name)
+{
+    std::string file_name = function_name + ".timeline.json";
+    const char* env = std::getenv("NGRAPH_CPU_TRACE_DIR");
+    return env ? file_util::path_join(env, file_name) : file_name;
+}
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_trace_buffer.hpp"
 #include "nlohmann/json.hpp"
 
 namespace ngraph
@@ -68,9 +69,16 @@ namespace ngraph
 
             void to_json(nlohmann::json& json, const TraceEvent& event);
 
+            // Writes the records held by trace as a Chrome trace (chrome://tracing), one
+            // row per thread, with timestamps relative to the oldest record
             void GenerateTimeline(const std::vector<OpAttributes>& op_attrs,
-                                  int64_t* op_durations,
+                                  const TraceBuffer& trace,
                                   const std::string& file_name);
+            // Number of records kept per function and thread, NGRAPH_CPU_TRACE_BUFFER_SIZE
+            size_t GetTraceBufferSize();
+            // Where the timeline of a traced function is written when it is destroyed:
+            // <function name>.timeline.json in NGRAPH_CPU_TRACE_DIR or the working directory
+            std::string GetTimelinePath(const std::string& function_name);
             bool IsTracingEnabled();
         }
     }
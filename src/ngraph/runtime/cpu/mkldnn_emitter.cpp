@@ -27,33 +27,42 @@
 
 using namespace ngraph::runtime::cpu;
 
-MKLDNNEmitter::~MKLDNNEmitter()
+MKLDNNPrimitives::~MKLDNNPrimitives()
 {
-    for (auto p : m_mkldnn_primitives)
+    for (auto p : primitives)
         delete p;
 }
 
-const std::vector<mkldnn::primitive*>& MKLDNNEmitter::get_mkldnn_primitives() const
+size_t MKLDNNEmitter::insert_primitive(const PrimitiveFactory& factory)
 {
-    return m_mkldnn_primitives;
+    m_primitive_factories.push_back(factory);
+    return (m_primitive_factories.size() - 1);
 }
 
-const std::vector<char*>& MKLDNNEmitter::get_mkldnn_workspaces()
+size_t MKLDNNEmitter::insert_workspace(size_t size)
 {
-    return m_workspace_bufs;
+    m_workspace_sizes.push_back(size);
+    return (m_workspace_sizes.size() - 1);
 }
 
-size_t MKLDNNEmitter::insert_primitive(mkldnn::primitive* primitive)
+size_t MKLDNNEmitter::get_primitive_count() const
 {
-    m_mkldnn_primitives.emplace_back(primitive);
-    return (m_mkldnn_primitives.size() - 1);
+    return m_primitive_factories.size();
 }
 
-size_t MKLDNNEmitter::insert_workspace(std::unique_ptr<MKLDNNWorkspace>& workspace)
+std::unique_ptr<MKLDNNPrimitives> MKLDNNEmitter::build_primitives() const
 {
-    m_workspace_bufs.push_back(workspace.get()->buf);
-    m_workspaces.push_back(std::move(workspace));
-    return (m_workspaces.size() - 1);
+    std::unique_ptr<MKLDNNPrimitives> instance(new MKLDNNPrimitives);
+    for (const auto& factory : m_primitive_factories)
+    {
+        instance->primitives.emplace_back(factory(instance->primitives));
+    }
+    for (size_t size : m_workspace_sizes)
+    {
+        instance->workspaces.emplace_back(new MKLDNNWorkspace(size));
+        instance->workspace_bufs.push_back(instance->workspaces.back()->buf);
+    }
+    return instance;
 }
 
 const std::vector<size_t>& MKLDNNEmitter::get_primitive_deps(size_t index) const
@@ -98,8 +107,10 @@ size_t MKLDNNEmitter::build_memory_primitive(const mkldnn::memory::desc& desc)
     // with a non-null pointer (unlike the C API)
     // Primitives are initialized at runtime so we use a known-invalid address here
     // to bypass this check
-    return insert_primitive(
-        new mkldnn::memory({desc, mkldnn_utils::global_cpu_engine}, reinterpret_cast<void*>(0x42)));
+    return insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::memory({desc, mkldnn_utils::global_cpu_engine},
+                                  reinterpret_cast<void*>(0x42));
+    });
 }
 
 size_t MKLDNNEmitter::build_convolution_forward(const mkldnn::memory::desc& input_data_desc,
@@ -114,21 +125,23 @@ size_t MKLDNNEmitter::build_convolution_forward(const mkldnn::memory::desc& inpu
     size_t weights_index = build_memory_primitive(weights_desc);
     size_t result_index = build_memory_primitive(result_desc);
 
-    size_t conv_index = insert_primitive(new mkldnn::convolution_forward(
-        {{mkldnn::prop_kind::forward,
-          mkldnn::algorithm::convolution_direct,
-          input_data_desc,
-          weights_desc,
-          result_desc,
-          mkldnn::memory::dims(strides.begin(), strides.end()),
-          mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
-          mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
-          mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
-          mkldnn::padding_kind::zero},
-         mkldnn_utils::global_cpu_engine},
-        *m_mkldnn_primitives[input_data_index],
-        *m_mkldnn_primitives[weights_index],
-        *m_mkldnn_primitives[result_index]));
+    size_t conv_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::convolution_forward(
+            {{mkldnn::prop_kind::forward,
+              mkldnn::algorithm::convolution_direct,
+              input_data_desc,
+              weights_desc,
+              result_desc,
+              mkldnn::memory::dims(strides.begin(), strides.end()),
+              mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
+              mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
+              mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
+              mkldnn::padding_kind::zero},
+             mkldnn_utils::global_cpu_engine},
+            *p[input_data_index],
+            *p[weights_index],
+            *p[result_index]);
+    });
 
     m_primitive_deps[conv_index] = {input_data_index, weights_index, result_index};
     return conv_index;
@@ -148,23 +161,25 @@ size_t MKLDNNEmitter::build_convolution_forward(const mkldnn::memory::desc& inpu
     const size_t bias_index = build_memory_primitive(bias_desc);
     const size_t result_index = build_memory_primitive(result_desc);
 
-    const size_t conv_index = insert_primitive(new mkldnn::convolution_forward(
-        {{mkldnn::prop_kind::forward,
-          mkldnn::algorithm::convolution_direct,
-          input_data_desc,
-          weights_desc,
-          bias_desc,
-          result_desc,
-          mkldnn::memory::dims(strides.begin(), strides.end()),
-          mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
-          mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
-          mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
-          mkldnn::padding_kind::zero},
-         mkldnn_utils::global_cpu_engine},
-        *m_mkldnn_primitives[input_data_index],
-        *m_mkldnn_primitives[weights_index],
-        *m_mkldnn_primitives[bias_index],
-        *m_mkldnn_primitives[result_index]));
+    const size_t conv_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::convolution_forward(
+            {{mkldnn::prop_kind::forward,
+              mkldnn::algorithm::convolution_direct,
+              input_data_desc,
+              weights_desc,
+              bias_desc,
+              result_desc,
+              mkldnn::memory::dims(strides.begin(), strides.end()),
+              mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
+              mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
+              mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
+              mkldnn::padding_kind::zero},
+             mkldnn_utils::global_cpu_engine},
+            *p[input_data_index],
+            *p[weights_index],
+            *p[bias_index],
+            *p[result_index]);
+    });
 
     m_primitive_deps[conv_index] = {input_data_index, weights_index, bias_index, result_index};
     return conv_index;
@@ -216,12 +231,13 @@ size_t MKLDNNEmitter::build_convolution_backward_weights_bias(
         mkldnn_utils::global_cpu_engine,
         fwd_pd};
 
-    const size_t conv_index = insert_primitive(
-        new mkldnn::convolution_backward_weights(bwd_pd,
-                                                 *m_mkldnn_primitives[in_data_index],
-                                                 *m_mkldnn_primitives[in_delta_index],
-                                                 *m_mkldnn_primitives[out_weights_delta_index],
-                                                 *m_mkldnn_primitives[out_bias_delta_index]));
+    const size_t conv_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::convolution_backward_weights(bwd_pd,
+                                                        *p[in_data_index],
+                                                        *p[in_delta_index],
+                                                        *p[out_weights_delta_index],
+                                                        *p[out_bias_delta_index]);
+    });
 
     m_primitive_deps[conv_index] = {
         in_data_index, in_delta_index, out_weights_delta_index, out_bias_delta_index};
@@ -241,32 +257,34 @@ size_t
     size_t delta_index = build_memory_primitive(delta_desc);
     size_t result_index = build_memory_primitive(result_desc);
 
-    size_t primitive_index = insert_primitive(new mkldnn::convolution_backward_weights(
-        {{mkldnn::algorithm::convolution_direct,
-          input_desc,
-          result_desc,
-          delta_desc,
-          mkldnn::memory::dims(strides.begin(), strides.end()),
-          mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
-          mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
-          mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
-          mkldnn::padding_kind::zero},
-         mkldnn_utils::global_cpu_engine,
-         // Forward primitive descriptor corresponding to this backward weights descriptor
-         {{mkldnn::prop_kind::forward,
-           mkldnn::algorithm::convolution_direct,
-           input_desc,
-           result_desc,
-           delta_desc,
-           mkldnn::memory::dims(strides.begin(), strides.end()),
-           mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
-           mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
-           mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
-           mkldnn::padding_kind::zero},
-          mkldnn_utils::global_cpu_engine}},
-        *m_mkldnn_primitives[input_index],
-        *m_mkldnn_primitives[delta_index],
-        *m_mkldnn_primitives[result_index]));
+    size_t primitive_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::convolution_backward_weights(
+            {{mkldnn::algorithm::convolution_direct,
+              input_desc,
+              result_desc,
+              delta_desc,
+              mkldnn::memory::dims(strides.begin(), strides.end()),
+              mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
+              mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
+              mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
+              mkldnn::padding_kind::zero},
+             mkldnn_utils::global_cpu_engine,
+             // Forward primitive descriptor corresponding to this backward weights descriptor
+             {{mkldnn::prop_kind::forward,
+               mkldnn::algorithm::convolution_direct,
+               input_desc,
+               result_desc,
+               delta_desc,
+               mkldnn::memory::dims(strides.begin(), strides.end()),
+               mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
+               mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
+               mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
+               mkldnn::padding_kind::zero},
+              mkldnn_utils::global_cpu_engine}},
+            *p[input_index],
+            *p[delta_index],
+            *p[result_index]);
+    });
 
     m_primitive_deps[primitive_index] = {input_index, delta_index, result_index};
     return primitive_index;
@@ -284,32 +302,34 @@ size_t MKLDNNEmitter::build_convolution_backward_data(const mkldnn::memory::desc
     size_t delta_index = build_memory_primitive(delta_desc);
     size_t result_index = build_memory_primitive(result_desc);
 
-    size_t primitive_index = insert_primitive(new mkldnn::convolution_backward_data(
-        {{mkldnn::algorithm::convolution_direct,
-          result_desc,
-          weights_desc,
-          delta_desc,
-          mkldnn::memory::dims(strides.begin(), strides.end()),
-          mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
-          mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
-          mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
-          mkldnn::padding_kind::zero},
-         mkldnn_utils::global_cpu_engine,
-         // Forward primitive descriptor corresponding to this backward data descriptor
-         {{mkldnn::prop_kind::forward,
-           mkldnn::algorithm::convolution_direct,
-           result_desc,
-           weights_desc,
-           delta_desc,
-           mkldnn::memory::dims(strides.begin(), strides.end()),
-           mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
-           mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
-           mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
-           mkldnn::padding_kind::zero},
-          mkldnn_utils::global_cpu_engine}},
-        *m_mkldnn_primitives[delta_index],
-        *m_mkldnn_primitives[weights_index],
-        *m_mkldnn_primitives[result_index]));
+    size_t primitive_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::convolution_backward_data(
+            {{mkldnn::algorithm::convolution_direct,
+              result_desc,
+              weights_desc,
+              delta_desc,
+              mkldnn::memory::dims(strides.begin(), strides.end()),
+              mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
+              mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
+              mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
+              mkldnn::padding_kind::zero},
+             mkldnn_utils::global_cpu_engine,
+             // Forward primitive descriptor corresponding to this backward data descriptor
+             {{mkldnn::prop_kind::forward,
+               mkldnn::algorithm::convolution_direct,
+               result_desc,
+               weights_desc,
+               delta_desc,
+               mkldnn::memory::dims(strides.begin(), strides.end()),
+               mkldnn::memory::dims(dilation_strides.begin(), dilation_strides.end()),
+               mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
+               mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
+               mkldnn::padding_kind::zero},
+              mkldnn_utils::global_cpu_engine}},
+            *p[delta_index],
+            *p[weights_index],
+            *p[result_index]);
+    });
 
     m_primitive_deps[primitive_index] = {weights_index, delta_index, result_index};
     return primitive_index;
@@ -326,19 +346,21 @@ size_t MKLDNNEmitter::build_pooling_forward(mkldnn::algorithm pooling_algorithm,
     size_t input_index = build_memory_primitive(input_desc);
     size_t result_index = build_memory_primitive(result_desc);
 
-    size_t primitive_index = insert_primitive(new mkldnn::pooling_forward(
-        {{mkldnn::prop_kind::forward_inference,
-          pooling_algorithm,
-          input_desc,
-          result_desc,
-          mkldnn::memory::dims(window_strides.begin(), window_strides.end()),
-          mkldnn::memory::dims(window_shape.begin(), window_shape.end()),
-          mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
-          mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
-          mkldnn::padding_kind::zero},
-         mkldnn_utils::global_cpu_engine},
-        *m_mkldnn_primitives[input_index],
-        *m_mkldnn_primitives[result_index]));
+    size_t primitive_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::pooling_forward(
+            {{mkldnn::prop_kind::forward_inference,
+              pooling_algorithm,
+              input_desc,
+              result_desc,
+              mkldnn::memory::dims(window_strides.begin(), window_strides.end()),
+              mkldnn::memory::dims(window_shape.begin(), window_shape.end()),
+              mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
+              mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
+              mkldnn::padding_kind::zero},
+             mkldnn_utils::global_cpu_engine},
+            *p[input_index],
+            *p[result_index]);
+    });
 
     m_primitive_deps[primitive_index] = {input_index, result_index};
     return primitive_index;
@@ -355,28 +377,30 @@ size_t MKLDNNEmitter::build_pooling_backward(mkldnn::algorithm pooling_algorithm
     size_t input_index = build_memory_primitive(diff_dst_desc);
     size_t result_index = build_memory_primitive(diff_src_desc);
 
-    size_t primitive_index = insert_primitive(new mkldnn::pooling_backward(
-        {{pooling_algorithm,
-          diff_src_desc,
-          diff_dst_desc,
-          mkldnn::memory::dims(window_strides.begin(), window_strides.end()),
-          mkldnn::memory::dims(window_shape.begin(), window_shape.end()),
-          mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
-          mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
-          mkldnn::padding_kind::zero},
-         mkldnn_utils::global_cpu_engine,
-         {{mkldnn::prop_kind::forward_training,
-           pooling_algorithm,
-           diff_src_desc,
-           diff_dst_desc,
-           mkldnn::memory::dims(window_strides.begin(), window_strides.end()),
-           mkldnn::memory::dims(window_shape.begin(), window_shape.end()),
-           mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
-           mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
-           mkldnn::padding_kind::zero},
-          mkldnn_utils::global_cpu_engine}},
-        *m_mkldnn_primitives[input_index],
-        *m_mkldnn_primitives[result_index]));
+    size_t primitive_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::pooling_backward(
+            {{pooling_algorithm,
+              diff_src_desc,
+              diff_dst_desc,
+              mkldnn::memory::dims(window_strides.begin(), window_strides.end()),
+              mkldnn::memory::dims(window_shape.begin(), window_shape.end()),
+              mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
+              mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
+              mkldnn::padding_kind::zero},
+             mkldnn_utils::global_cpu_engine,
+             {{mkldnn::prop_kind::forward_training,
+               pooling_algorithm,
+               diff_src_desc,
+               diff_dst_desc,
+               mkldnn::memory::dims(window_strides.begin(), window_strides.end()),
+               mkldnn::memory::dims(window_shape.begin(), window_shape.end()),
+               mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
+               mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
+               mkldnn::padding_kind::zero},
+              mkldnn_utils::global_cpu_engine}},
+            *p[input_index],
+            *p[result_index]);
+    });
 
     m_primitive_deps[primitive_index] = {input_index, result_index};
     return primitive_index;
@@ -408,33 +432,34 @@ size_t MKLDNNEmitter::build_max_pooling_backward(mkldnn::algorithm pooling_algor
         mkldnn_utils::global_cpu_engine};
 
     auto ws_index = build_memory_primitive(fwd_pd.workspace_primitive_desc().desc());
-    // Allocate workspace
+    // Each call frame allocates its own workspace
     // TODO (jbobba): Might need to align memory
-    auto ws = std::unique_ptr<MKLDNNWorkspace>(
-        new MKLDNNWorkspace(fwd_pd.workspace_primitive_desc().get_size()));
-    auto ws_buf_index = insert_workspace(ws);
-
-    size_t fwd_primitive_index = insert_primitive(new mkldnn::pooling_forward(
-        fwd_pd,
-        *m_mkldnn_primitives[fprop_src_index],
-        *m_mkldnn_primitives
-            [diff_src_index], // HACK - Uses diff_src buffer. Safe since diff_src > fprop_dst
-        *m_mkldnn_primitives[ws_index]));
-
-    size_t bwd_primitive_index = insert_primitive(new mkldnn::pooling_backward(
-        {{pooling_algorithm,
-          diff_src_desc,
-          diff_dst_desc,
-          mkldnn::memory::dims(window_strides.begin(), window_strides.end()),
-          mkldnn::memory::dims(window_shape.begin(), window_shape.end()),
-          mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
-          mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
-          mkldnn::padding_kind::zero},
-         mkldnn_utils::global_cpu_engine,
-         fwd_pd},
-        *m_mkldnn_primitives[diff_dst_index],
-        *m_mkldnn_primitives[ws_index],
-        *m_mkldnn_primitives[diff_src_index]));
+    auto ws_buf_index = insert_workspace(fwd_pd.workspace_primitive_desc().get_size());
+
+    size_t fwd_primitive_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::pooling_forward(
+            fwd_pd,
+            *p[fprop_src_index],
+            *p[diff_src_index], // HACK - Uses diff_src buffer. Safe since diff_src > fprop_dst
+            *p[ws_index]);
+    });
+
+    size_t bwd_primitive_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::pooling_backward(
+            {{pooling_algorithm,
+              diff_src_desc,
+              diff_dst_desc,
+              mkldnn::memory::dims(window_strides.begin(), window_strides.end()),
+              mkldnn::memory::dims(window_shape.begin(), window_shape.end()),
+              mkldnn::memory::dims(padding_below.begin(), padding_below.end()),
+              mkldnn::memory::dims(padding_above.begin(), padding_above.end()),
+              mkldnn::padding_kind::zero},
+             mkldnn_utils::global_cpu_engine,
+             fwd_pd},
+            *p[diff_dst_index],
+            *p[ws_index],
+            *p[diff_src_index]);
+    });
 
     m_primitive_deps[fwd_primitive_index] = {
         fprop_src_index, diff_src_index, ws_index, ws_buf_index};
@@ -449,8 +474,9 @@ size_t MKLDNNEmitter::build_reorder(const mkldnn::memory::desc& input_desc,
     size_t input_index = build_memory_primitive(input_desc);
     size_t result_index = build_memory_primitive(result_desc);
 
-    size_t primitive_index = insert_primitive(
-        new mkldnn::reorder(*m_mkldnn_primitives[input_index], *m_mkldnn_primitives[result_index]));
+    size_t primitive_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::reorder(*p[input_index], *p[result_index]);
+    });
 
     m_primitive_deps[primitive_index] = {input_index, result_index};
     return primitive_index;
@@ -462,11 +488,17 @@ size_t MKLDNNEmitter::build_relu_forward(const mkldnn::memory::desc& input_desc,
     size_t input_index = build_memory_primitive(input_desc);
     size_t result_index = build_memory_primitive(result_desc);
 
-    size_t primitive_index = insert_primitive(new mkldnn::relu_forward(
-        {{mkldnn::prop_kind::forward_training, mkldnn::algorithm::eltwise_relu, input_desc, 0, 0},
-         mkldnn_utils::global_cpu_engine},
-        *m_mkldnn_primitives[input_index],
-        *m_mkldnn_primitives[result_index]));
+    size_t primitive_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::relu_forward(
+            {{mkldnn::prop_kind::forward_training,
+              mkldnn::algorithm::eltwise_relu,
+              input_desc,
+              0,
+              0},
+             mkldnn_utils::global_cpu_engine},
+            *p[input_index],
+            *p[result_index]);
+    });
 
     m_primitive_deps[primitive_index] = {input_index, result_index};
     return primitive_index;
@@ -480,14 +512,16 @@ size_t MKLDNNEmitter::build_relu_backward(const mkldnn::memory::desc& input_desc
     size_t delta_index = build_memory_primitive(delta_desc);
     size_t result_index = build_memory_primitive(result_desc);
 
-    size_t primitive_index = insert_primitive(new mkldnn::relu_backward(
-        {{mkldnn::algorithm::eltwise_relu, delta_desc, input_desc, 0, 0},
-         mkldnn_utils::global_cpu_engine,
-         {{mkldnn::prop_kind::forward, mkldnn::algorithm::eltwise_relu, input_desc, 0, 0},
-          mkldnn_utils::global_cpu_engine}},
-        *m_mkldnn_primitives[input_index],
-        *m_mkldnn_primitives[delta_index],
-        *m_mkldnn_primitives[result_index]));
+    size_t primitive_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::relu_backward(
+            {{mkldnn::algorithm::eltwise_relu, delta_desc, input_desc, 0, 0},
+             mkldnn_utils::global_cpu_engine,
+             {{mkldnn::prop_kind::forward, mkldnn::algorithm::eltwise_relu, input_desc, 0, 0},
+              mkldnn_utils::global_cpu_engine}},
+            *p[input_index],
+            *p[delta_index],
+            *p[result_index]);
+    });
 
     m_primitive_deps[primitive_index] = {input_index, delta_index, result_index};
     return primitive_index;
@@ -499,15 +533,16 @@ size_t MKLDNNEmitter::build_sigmoid_forward(const mkldnn::memory::desc& input_de
     size_t input_index = build_memory_primitive(input_desc);
     size_t result_index = build_memory_primitive(result_desc);
 
-    size_t primitive_index =
-        insert_primitive(new mkldnn::eltwise_forward({{mkldnn::prop_kind::forward_training,
-                                                       mkldnn::algorithm::eltwise_logistic,
-                                                       input_desc,
-                                                       0,
-                                                       0},
-                                                      mkldnn_utils::global_cpu_engine},
-                                                     *m_mkldnn_primitives[input_index],
-                                                     *m_mkldnn_primitives[result_index]));
+    size_t primitive_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::eltwise_forward({{mkldnn::prop_kind::forward_training,
+                                             mkldnn::algorithm::eltwise_logistic,
+                                             input_desc,
+                                             0,
+                                             0},
+                                            mkldnn_utils::global_cpu_engine},
+                                           *p[input_index],
+                                           *p[result_index]);
+    });
 
     m_primitive_deps[primitive_index] = {input_index, result_index};
     return primitive_index;
@@ -527,13 +562,15 @@ size_t MKLDNNEmitter::build_sigmoid_backward(const mkldnn::memory::desc& input_d
             {mkldnn::prop_kind::forward, mkldnn::algorithm::eltwise_logistic, input_desc, 0, 0},
             mkldnn_utils::global_cpu_engine);
 
-    size_t primitive_index = insert_primitive(new mkldnn::eltwise_backward(
-        {{mkldnn::algorithm::eltwise_logistic, delta_desc, input_desc, 0, 0},
-         mkldnn_utils::global_cpu_engine,
-         sigmoid_fwd_pd},
-        *m_mkldnn_primitives[input_index],
-        *m_mkldnn_primitives[delta_index],
-        *m_mkldnn_primitives[result_index]));
+    size_t primitive_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::eltwise_backward(
+            {{mkldnn::algorithm::eltwise_logistic, delta_desc, input_desc, 0, 0},
+             mkldnn_utils::global_cpu_engine,
+             sigmoid_fwd_pd},
+            *p[input_index],
+            *p[delta_index],
+            *p[result_index]);
+    });
 
     m_primitive_deps[primitive_index] = {input_index, delta_index, result_index};
     return primitive_index;
@@ -547,21 +584,20 @@ size_t MKLDNNEmitter::build_elementwise_add(
     const std::vector<mkldnn::memory::primitive_desc>& inputs_pd)
 
 {
-    std::vector<mkldnn::memory::primitive::at> inputs_primitive;
-
     size_t input0_data_index = build_memory_primitive(input0_data_desc);
     size_t input1_data_index = build_memory_primitive(input1_data_desc);
     size_t result_index = build_memory_primitive(result_desc);
 
-    inputs_primitive.push_back(*m_mkldnn_primitives[input0_data_index]);
-    inputs_primitive.push_back(*m_mkldnn_primitives[input1_data_index]);
-
     // elementwise sum primtive descriptor
     mkldnn::sum::primitive_desc sum_pd =
         mkldnn::sum::primitive_desc(result_desc, scale_vector, inputs_pd);
     // sum primitive
-    size_t add_index = insert_primitive(
-        new mkldnn::sum(sum_pd, inputs_primitive, *m_mkldnn_primitives[result_index]));
+    size_t add_index =
+        insert_primitive([=](const std::vector<mkldnn::primitive*>& p) -> mkldnn::primitive* {
+            std::vector<mkldnn::memory::primitive::at> inputs_primitive{*p[input0_data_index],
+                                                                        *p[input1_data_index]};
+            return new mkldnn::sum(sum_pd, inputs_primitive, *p[result_index]);
+        });
 
     m_primitive_deps[add_index] = {input0_data_index, input1_data_index, result_index};
     return add_index;
@@ -580,17 +616,19 @@ size_t MKLDNNEmitter::build_batchnorm_forward(const mkldnn::memory::desc& input_
     size_t mean_index = build_memory_primitive(mean_desc);
     size_t variance_index = build_memory_primitive(variance_desc);
 
-    size_t batchnorm_index = insert_primitive(new mkldnn::batch_normalization_forward(
-        {{mkldnn::prop_kind::forward_training,
-          input_desc,
-          eps,
-          mkldnn::batch_normalization_flag::use_scale_shift},
-         mkldnn_utils::global_cpu_engine},
-        mkldnn::primitive::at(*m_mkldnn_primitives[input_index]),
-        mkldnn::primitive::at(*m_mkldnn_primitives[weights_index]),
-        static_cast<mkldnn::memory>(*m_mkldnn_primitives[result_index]),
-        *m_mkldnn_primitives[mean_index],
-        *m_mkldnn_primitives[variance_index]));
+    size_t batchnorm_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::batch_normalization_forward(
+            {{mkldnn::prop_kind::forward_training,
+              input_desc,
+              eps,
+              mkldnn::batch_normalization_flag::use_scale_shift},
+             mkldnn_utils::global_cpu_engine},
+            mkldnn::primitive::at(*p[input_index]),
+            mkldnn::primitive::at(*p[weights_index]),
+            static_cast<mkldnn::memory>(*p[result_index]),
+            *p[mean_index],
+            *p[variance_index]);
+    });
 
     m_primitive_deps[batchnorm_index] = {
         input_index, weights_index, result_index, mean_index, variance_index};
@@ -614,25 +652,27 @@ size_t MKLDNNEmitter::build_batchnorm_backward(const mkldnn::memory::desc& weigh
     size_t dinput_index = build_memory_primitive(dinput_desc);
     size_t dweights_index = build_memory_primitive(dweights_desc);
 
-    size_t batchnorm_index = insert_primitive(new mkldnn::batch_normalization_backward(
-        {{mkldnn::prop_kind::backward,
-          delta_desc,
-          input_desc,
-          eps,
-          mkldnn::batch_normalization_flag::use_scale_shift},
-         mkldnn_utils::global_cpu_engine,
-         {{mkldnn::prop_kind::forward_training,
-           input_desc,
-           eps,
-           mkldnn::batch_normalization_flag::use_scale_shift},
-          mkldnn_utils::global_cpu_engine}},
-        *m_mkldnn_primitives[input_index],
-        *m_mkldnn_primitives[mean_index],
-        *m_mkldnn_primitives[variance_index],
-        *m_mkldnn_primitives[delta_index],
-        *m_mkldnn_primitives[weights_index],
-        *m_mkldnn_primitives[dinput_index],
-        *m_mkldnn_primitives[dweights_index]));
+    size_t batchnorm_index = insert_primitive([=](const std::vector<mkldnn::primitive*>& p) {
+        return new mkldnn::batch_normalization_backward(
+            {{mkldnn::prop_kind::backward,
+              delta_desc,
+              input_desc,
+              eps,
+              mkldnn::batch_normalization_flag::use_scale_shift},
+             mkldnn_utils::global_cpu_engine,
+             {{mkldnn::prop_kind::forward_training,
+               input_desc,
+               eps,
+               mkldnn::batch_normalization_flag::use_scale_shift},
+              mkldnn_utils::global_cpu_engine}},
+            *p[input_index],
+            *p[mean_index],
+            *p[variance_index],
+            *p[delta_index],
+            *p[weights_index],
+            *p[dinput_index],
+            *p[dweights_index]);
+    });
 
     m_primitive_deps[batchnorm_index] = {weights_index,
                                          input_index,
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -39,24 +40,50 @@ namespace ngraph
             class MKLDNNWorkspace
             {
             public:
-                MKLDNNWorkspace(size_t size) { buf = reinterpret_cast<char*>(malloc(size)); }
+                MKLDNNWorkspace(size_t size)
+                    : size(size)
+                {
+                    buf = reinterpret_cast<char*>(malloc(size));
+                }
                 ~MKLDNNWorkspace() { free(buf); }
+                size_t size;
                 char* buf;
             };
 
+            // MKLDNN primitives and workspaces of a single call frame. Memory primitives
+            // have their data handles patched on every call, so call frames that may run
+            // concurrently can't share them.
+            class MKLDNNPrimitives
+            {
+            public:
+                ~MKLDNNPrimitives();
+
+                std::vector<mkldnn::primitive*> primitives;
+                std::vector<std::unique_ptr<MKLDNNWorkspace>> workspaces;
+                std::vector<char*> workspace_bufs;
+            };
+
             class MKLDNNEmitter
             {
             public:
                 MKLDNNEmitter() {}
-                ~MKLDNNEmitter();
 
-                const std::vector<mkldnn::primitive*>& get_mkldnn_primitives() const;
-                const std::vector<char*>& get_mkldnn_workspaces();
+                // Creates a primitive from the primitives it depends on, which are
+                // looked up by index in the given vector
+                using PrimitiveFactory =
+                    std::function<mkldnn::primitive*(const std::vector<mkldnn::primitive*>&)>;
 
-                size_t insert_primitive(mkldnn::primitive* primitive);
-                size_t insert_workspace(std::unique_ptr<MKLDNNWorkspace>& workspace);
+                // Only the factories and workspace sizes are kept here. The primitives and
+                // workspaces themselves are made for each call frame by build_primitives().
+                size_t insert_primitive(const PrimitiveFactory& factory);
+                size_t insert_workspace(size_t size);
+                size_t get_primitive_count() const;
                 const std::vector<size_t>& get_primitive_deps(size_t index) const;
 
+                /// @brief Instantiates a fresh copy of every primitive and workspace built
+                /// so far, using the same indices as the generated code
+                std::unique_ptr<MKLDNNPrimitives> build_primitives() const;
+
                 // TODO(jmenon): Get rid of TensorViewWrappers at some point
                 mkldnn::memory::desc build_memory_descriptor(const TensorViewWrapper& tvw,
                                                              mkldnn::memory::format fmt) const;
@@ -181,11 +208,10 @@ namespace ngraph
                                                 const double eps);
 
             private:
-                std::vector<mkldnn::primitive*> m_mkldnn_primitives;
+                std::vector<PrimitiveFactory> m_primitive_factories;
                 std::vector<mkldnn::stream> m_mkldnn_streams;
                 std::unordered_map<size_t, std::vector<size_t>> m_primitive_deps;
-                std::vector<std::unique_ptr<MKLDNNWorkspace>> m_workspaces;
-                std::vector<char*> m_workspace_bufs;
+                std::vector<size_t> m_workspace_sizes;
             };
         }
     }
@@ -0,0 +1,63 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "ngraph/runtime/cpu/ops/loop_kernel.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::cpu::op::LoopKernel::LoopKernel(const NodeVector& args,
+                                         const vector<Operation>& operations,
+                                         const element::Type& element_type)
+    : RequiresTensorViewArgs("LoopKernel", args)
+    , m_operations(operations)
+{
+    if (m_operations.empty())
+    {
+        throw ngraph_error("LoopKernel requires at least one operation");
+    }
+
+    const auto& shape = args.at(0)->get_shape();
+    for (const auto& arg : args)
+    {
+        if (arg->get_shape() != shape)
+        {
+            throw ngraph_error("LoopKernel arguments must all have the same shape");
+        }
+    }
+
+    for (size_t i = 0; i < m_operations.size(); i++)
+    {
+        for (size_t operand : m_operations[i].operands)
+        {
+            if (operand >= args.size() + i)
+            {
+                throw ngraph_error("LoopKernel operand does not refer to an earlier value");
+            }
+        }
+    }
+
+    add_output(element_type, shape);
+}
+
+shared_ptr<Node> runtime::cpu::op::LoopKernel::copy_with_new_args(const NodeVector& new_args) const
+{
+    if (new_args.size() != get_input_size())
+    {
+        throw ngraph_error("Incorrect number of new arguments");
+    }
+    return make_shared<LoopKernel>(new_args, m_operations, get_element_type());
+}
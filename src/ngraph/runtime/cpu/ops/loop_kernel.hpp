@@ -0,0 +1,62 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ngraph/ops/util/requires_tensor_view_args.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace op
+            {
+                /// \brief Fused elementwise loop
+                ///
+                /// Computes a connected subgraph of elementwise operations in a single loop
+                /// over the output elements. The body is a list of operations in evaluation
+                /// order; operand indices below get_arguments().size() refer to the kernel's
+                /// arguments and the remaining ones to the results of earlier operations.
+                /// The last operation produces the kernel's output.
+                class LoopKernel : public ngraph::op::util::RequiresTensorViewArgs
+                {
+                public:
+                    struct Operation
+                    {
+                        std::string description;
+                        std::vector<size_t> operands;
+                    };
+
+                    LoopKernel(const NodeVector& args,
+                               const std::vector<Operation>& operations,
+                               const element::Type& element_type);
+
+                    const std::vector<Operation>& get_operations() const { return m_operations; }
+                    virtual std::shared_ptr<Node>
+                        copy_with_new_args(const NodeVector& new_args) const override;
+
+                protected:
+                    std::vector<Operation> m_operations;
+                };
+            }
+        }
+    }
+}
@@ -21,16 +21,41 @@
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <mkldnn.hpp>
 
 #include "ngraph/descriptor/output.hpp"
+#include "ngraph/ops/abs.hpp"
+#include "ngraph/ops/acos.hpp"
 #include "ngraph/ops/add.hpp"
+#include "ngraph/ops/asin.hpp"
+#include "ngraph/ops/atan.hpp"
 #include "ngraph/ops/avg_pool.hpp"
 #include "ngraph/ops/batch_norm.hpp"
+#include "ngraph/ops/ceiling.hpp"
+#include "ngraph/ops/convert.hpp"
 #include "ngraph/ops/convolution.hpp"
+#include "ngraph/ops/cos.hpp"
+#include "ngraph/ops/cosh.hpp"
+#include "ngraph/ops/divide.hpp"
+#include "ngraph/ops/exp.hpp"
+#include "ngraph/ops/floor.hpp"
+#include "ngraph/ops/log.hpp"
 #include "ngraph/ops/max_pool.hpp"
+#include "ngraph/ops/maximum.hpp"
+#include "ngraph/ops/minimum.hpp"
+#include "ngraph/ops/multiply.hpp"
+#include "ngraph/ops/negative.hpp"
+#include "ngraph/ops/power.hpp"
 #include "ngraph/ops/relu.hpp"
+#include "ngraph/ops/sign.hpp"
+#include "ngraph/ops/sin.hpp"
+#include "ngraph/ops/sinh.hpp"
+#include "ngraph/ops/sqrt.hpp"
+#include "ngraph/ops/subtract.hpp"
+#include "ngraph/ops/tan.hpp"
+#include "ngraph/ops/tanh.hpp"
 #include "ngraph/runtime/cpu/cpu_op_annotations.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 #include "ngraph/runtime/cpu/ops/conv_bias.hpp"
@@ -417,6 +442,35 @@ static const runtime::cpu::pass::AssignOpMap s_dispatcher{
      &runtime::cpu::pass::CPUAssignment::assign<ngraph::op::SigmoidBackprop>},
 };
 
+// The emitters of these ops compute each output element only from the input elements at the
+// same index, so their output may overwrite an input that is not used afterwards
+static const unordered_set<type_index> s_in_place_ops{
+    TI(ngraph::op::Abs), TI(ngraph::op::Acos), TI(ngraph::op::Add), TI(ngraph::op::Asin),
+    TI(ngraph::op::Atan), TI(ngraph::op::Ceiling), TI(ngraph::op::Convert), TI(ngraph::op::Cos),
+    TI(ngraph::op::Cosh), TI(ngraph::op::Divide), TI(ngraph::op::Exp), TI(ngraph::op::Floor),
+    TI(ngraph::op::Log), TI(ngraph::op::Maximum), TI(ngraph::op::Minimum), TI(ngraph::op::Multiply),
+    TI(ngraph::op::Negative), TI(ngraph::op::Power), TI(ngraph::op::Relu), TI(ngraph::op::Sign),
+    TI(ngraph::op::Sin), TI(ngraph::op::Sinh), TI(ngraph::op::Sqrt), TI(ngraph::op::Subtract),
+    TI(ngraph::op::Tan), TI(ngraph::op::Tanh)};
+
+static void assign_in_place(ngraph::Node* node)
+{
+    auto op = static_cast<ngraph::op::Op*>(node);
+    auto op_annotations = op->get_op_annotations();
+    if (!op_annotations)
+    {
+        op_annotations = std::make_shared<ngraph::runtime::cpu::CPUOpAnnotations>();
+        op->set_op_annotations(op_annotations);
+    }
+    for (size_t i = 0; i < node->get_input_size(); i++)
+    {
+        if (node->get_input_element_type(i).size() == node->get_element_type().size())
+        {
+            op_annotations->add_in_place_oi_pair({0, i});
+        }
+    }
+}
+
 bool runtime::cpu::pass::CPUAssignment::run_on_call_graph(
     const std::list<std::shared_ptr<Node>>& nodes)
 {
@@ -428,6 +482,13 @@ bool runtime::cpu::pass::CPUAssignment::run_on_call_graph(
         {
             handler->second(m_external_function, node.get());
         }
+        // MKLDNN kernels may use different layouts for their inputs and outputs. With TBB
+        // another reader of the input may still be running when the op overwrites it.
+        if (s_in_place_ops.count(TI(n)) && !m_external_function->is_using_tbb() &&
+            !runtime::cpu::mkldnn_utils::use_mkldnn_kernel(node.get()))
+        {
+            assign_in_place(node.get());
+        }
     }
 
     return false;
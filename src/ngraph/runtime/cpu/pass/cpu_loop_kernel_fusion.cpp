@@ -0,0 +1,200 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <map>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "cpu_loop_kernel_fusion.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/ops/abs.hpp"
+#include "ngraph/ops/add.hpp"
+#include "ngraph/ops/ceiling.hpp"
+#include "ngraph/ops/cos.hpp"
+#include "ngraph/ops/cosh.hpp"
+#include "ngraph/ops/divide.hpp"
+#include "ngraph/ops/exp.hpp"
+#include "ngraph/ops/floor.hpp"
+#include "ngraph/ops/log.hpp"
+#include "ngraph/ops/maximum.hpp"
+#include "ngraph/ops/minimum.hpp"
+#include "ngraph/ops/multiply.hpp"
+#include "ngraph/ops/negative.hpp"
+#include "ngraph/ops/power.hpp"
+#include "ngraph/ops/relu.hpp"
+#include "ngraph/ops/select.hpp"
+#include "ngraph/ops/sign.hpp"
+#include "ngraph/ops/sin.hpp"
+#include "ngraph/ops/sinh.hpp"
+#include "ngraph/ops/sqrt.hpp"
+#include "ngraph/ops/subtract.hpp"
+#include "ngraph/ops/tan.hpp"
+#include "ngraph/ops/tanh.hpp"
+#include "ngraph/runtime/cpu/ops/loop_kernel.hpp"
+#include "ngraph/runtime/cpu/ops/sigmoid.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#define TI(x) type_index(typeid(x))
+
+// Ops the LoopKernel emitter knows how to express as a scalar expression
+static const unordered_set<type_index> s_fusible_ops{
+    TI(op::Abs),      TI(op::Add),     TI(op::Ceiling),  TI(op::Cos),      TI(op::Cosh),
+    TI(op::Divide),   TI(op::Exp),     TI(op::Floor),    TI(op::Log),      TI(op::Maximum),
+    TI(op::Minimum),  TI(op::Multiply), TI(op::Negative), TI(op::Power),   TI(op::Relu),
+    TI(op::Select),   TI(op::Sigmoid), TI(op::Sign),     TI(op::Sin),      TI(op::Sinh),
+    TI(op::Sqrt),     TI(op::Subtract), TI(op::Tan),     TI(op::Tanh)};
+
+static bool is_fusible(const shared_ptr<Node>& node)
+{
+    const Node& n = *node;
+    if (s_fusible_ops.count(TI(n)) == 0)
+    {
+        return false;
+    }
+
+    // Only floating point kernels are fused; integer ops keep their dedicated emitters
+    auto& et = node->get_element_type();
+    if (et != element::f32 && et != element::f64)
+    {
+        return false;
+    }
+
+    for (const auto& input : node->get_inputs())
+    {
+        if (input.get_shape() != node->get_shape())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool runtime::cpu::pass::CPULoopKernelFusion::run_on_function(shared_ptr<Function> function)
+{
+    auto ops = function->get_ordered_ops();
+
+    unordered_map<Node*, size_t> order;
+    for (const auto& n : ops)
+    {
+        size_t index = order.size();
+        order[n.get()] = index;
+    }
+
+    bool clobbered = false;
+    unordered_set<Node*> absorbed;
+
+    for (auto it = ops.rbegin(); it != ops.rend(); ++it)
+    {
+        auto root = *it;
+        if (absorbed.count(root.get()) != 0 || !is_fusible(root))
+        {
+            continue;
+        }
+
+        // Grow the group from the root towards its producers, visiting candidates in
+        // decreasing topological order so that all users of a candidate have been
+        // considered before the candidate itself.
+        unordered_set<Node*> group{root.get()};
+        vector<shared_ptr<Node>> members{root};
+        map<size_t, shared_ptr<Node>> candidates;
+        for (const auto& arg : root->get_input_ops())
+        {
+            candidates[order.at(arg.get())] = arg;
+        }
+
+        while (!candidates.empty())
+        {
+            auto candidate = prev(candidates.end())->second;
+            candidates.erase(prev(candidates.end()));
+
+            if (absorbed.count(candidate.get()) != 0 || !is_fusible(candidate) ||
+                candidate->get_element_type() != root->get_element_type() ||
+                candidate->get_shape() != root->get_shape())
+            {
+                continue;
+            }
+
+            auto& users = candidate->users();
+            if (!all_of(begin(users), end(users), [&group](Node* user) {
+                    return group.count(user) != 0;
+                }))
+            {
+                continue;
+            }
+
+            group.insert(candidate.get());
+            members.push_back(candidate);
+            for (const auto& arg : candidate->get_input_ops())
+            {
+                candidates[order.at(arg.get())] = arg;
+            }
+        }
+
+        if (members.size() < 2)
+        {
+            continue;
+        }
+
+        sort(begin(members), end(members), [&order](const shared_ptr<Node>& a,
+                                                     const shared_ptr<Node>& b) {
+            return order.at(a.get()) < order.at(b.get());
+        });
+
+        NodeVector args;
+        unordered_map<Node*, size_t> arg_index;
+        for (const auto& member : members)
+        {
+            for (const auto& arg : member->get_input_ops())
+            {
+                if (group.count(arg.get()) == 0 && arg_index.count(arg.get()) == 0)
+                {
+                    arg_index[arg.get()] = args.size();
+                    args.push_back(arg);
+                }
+            }
+        }
+
+        vector<runtime::cpu::op::LoopKernel::Operation> operations;
+        unordered_map<Node*, size_t> value_index;
+        for (const auto& member : members)
+        {
+            runtime::cpu::op::LoopKernel::Operation operation;
+            operation.description = member->description();
+            for (const auto& arg : member->get_input_ops())
+            {
+                auto value = value_index.find(arg.get());
+                operation.operands.push_back(value != value_index.end() ? value->second
+                                                                        : arg_index.at(arg.get()));
+            }
+            value_index[member.get()] = args.size() + operations.size();
+            operations.push_back(operation);
+        }
+
+        auto kernel = make_shared<runtime::cpu::op::LoopKernel>(
+            args, operations, root->get_element_type());
+        function->replace_node(root, kernel);
+
+        absorbed.insert(begin(group), end(group));
+        clobbered = true;
+    }
+
+    return clobbered;
+}
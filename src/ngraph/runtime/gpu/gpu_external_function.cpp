@@ -537,13 +537,10 @@ using namespace std;
         size_t worst_case_tmp_size = 0;
         for (shared_ptr<Node> node : current_function->get_ordered_ops())
         {
-            if (node->liveness_new_list.size() > 0)
+            for (descriptor::Tensor* tensor : node->get_liveness_new_list())
             {
                 temporaries_used = true;
-                for (descriptor::Tensor* tensor : node->liveness_new_list)
-                {
-                    worst_case_tmp_size += tensor->size();
-                }
+                worst_case_tmp_size += tensor->size();
             }
         }
         if (temporaries_used)
@@ -557,7 +554,7 @@ using namespace std;
             // Add temporaries to the variable name map
             for (shared_ptr<Node> node : current_function->get_ordered_ops())
             {
-                for (descriptor::Tensor* tensor : node->liveness_new_list)
+                for (descriptor::Tensor* tensor : node->get_liveness_new_list())
                 {
                     stringstream ss;
                     ss << "((" << tensor->get_element_type().c_type_string()
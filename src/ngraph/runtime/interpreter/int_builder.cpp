@@ -0,0 +1,790 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ngraph/except.hpp"
+#include "ngraph/ops/avg_pool.hpp"
+#include "ngraph/ops/broadcast.hpp"
+#include "ngraph/ops/concat.hpp"
+#include "ngraph/ops/constant.hpp"
+#include "ngraph/ops/convolution.hpp"
+#include "ngraph/ops/dot.hpp"
+#include "ngraph/ops/max.hpp"
+#include "ngraph/ops/max_pool.hpp"
+#include "ngraph/ops/min.hpp"
+#include "ngraph/ops/one_hot.hpp"
+#include "ngraph/ops/pad.hpp"
+#include "ngraph/ops/product.hpp"
+#include "ngraph/ops/reduce.hpp"
+#include "ngraph/ops/reduce_window.hpp"
+#include "ngraph/ops/replace_slice.hpp"
+#include "ngraph/ops/reshape.hpp"
+#include "ngraph/ops/result.hpp"
+#include "ngraph/ops/reverse.hpp"
+#include "ngraph/ops/select_and_scatter.hpp"
+#include "ngraph/ops/slice.hpp"
+#include "ngraph/ops/softmax.hpp"
+#include "ngraph/ops/sum.hpp"
+#include "ngraph/runtime/interpreter/int_builder.hpp"
+#include "ngraph/runtime/interpreter/int_call_frame.hpp"
+#include "ngraph/runtime/interpreter/int_external_function.hpp"
+#include "ngraph/runtime/kernel/abs.hpp"
+#include "ngraph/runtime/kernel/acos.hpp"
+#include "ngraph/runtime/kernel/add.hpp"
+#include "ngraph/runtime/kernel/asin.hpp"
+#include "ngraph/runtime/kernel/atan.hpp"
+#include "ngraph/runtime/kernel/avg_pool.hpp"
+#include "ngraph/runtime/kernel/broadcast.hpp"
+#include "ngraph/runtime/kernel/ceiling.hpp"
+#include "ngraph/runtime/kernel/concat.hpp"
+#include "ngraph/runtime/kernel/constant.hpp"
+#include "ngraph/runtime/kernel/convert.hpp"
+#include "ngraph/runtime/kernel/convolution.hpp"
+#include "ngraph/runtime/kernel/copy.hpp"
+#include "ngraph/runtime/kernel/cos.hpp"
+#include "ngraph/runtime/kernel/cosh.hpp"
+#include "ngraph/runtime/kernel/divide.hpp"
+#include "ngraph/runtime/kernel/dot.hpp"
+#include "ngraph/runtime/kernel/equal.hpp"
+#include "ngraph/runtime/kernel/exp.hpp"
+#include "ngraph/runtime/kernel/floor.hpp"
+#include "ngraph/runtime/kernel/greater.hpp"
+#include "ngraph/runtime/kernel/greater_eq.hpp"
+#include "ngraph/runtime/kernel/less.hpp"
+#include "ngraph/runtime/kernel/less_eq.hpp"
+#include "ngraph/runtime/kernel/log.hpp"
+#include "ngraph/runtime/kernel/max.hpp"
+#include "ngraph/runtime/kernel/max_pool.hpp"
+#include "ngraph/runtime/kernel/maximum.hpp"
+#include "ngraph/runtime/kernel/min.hpp"
+#include "ngraph/runtime/kernel/minimum.hpp"
+#include "ngraph/runtime/kernel/multiply.hpp"
+#include "ngraph/runtime/kernel/negate.hpp"
+#include "ngraph/runtime/kernel/not.hpp"
+#include "ngraph/runtime/kernel/not_equal.hpp"
+#include "ngraph/runtime/kernel/one_hot.hpp"
+#include "ngraph/runtime/kernel/pad.hpp"
+#include "ngraph/runtime/kernel/power.hpp"
+#include "ngraph/runtime/kernel/product.hpp"
+#include "ngraph/runtime/kernel/reduce.hpp"
+#include "ngraph/runtime/kernel/reduce_window.hpp"
+#include "ngraph/runtime/kernel/relu.hpp"
+#include "ngraph/runtime/kernel/replace_slice.hpp"
+#include "ngraph/runtime/kernel/reshape.hpp"
+#include "ngraph/runtime/kernel/result.hpp"
+#include "ngraph/runtime/kernel/reverse.hpp"
+#include "ngraph/runtime/kernel/select.hpp"
+#include "ngraph/runtime/kernel/select_and_scatter.hpp"
+#include "ngraph/runtime/kernel/sign.hpp"
+#include "ngraph/runtime/kernel/sin.hpp"
+#include "ngraph/runtime/kernel/sinh.hpp"
+#include "ngraph/runtime/kernel/slice.hpp"
+#include "ngraph/runtime/kernel/softmax.hpp"
+#include "ngraph/runtime/kernel/sqrt.hpp"
+#include "ngraph/runtime/kernel/subtract.hpp"
+#include "ngraph/runtime/kernel/sum.hpp"
+#include "ngraph/runtime/kernel/tan.hpp"
+#include "ngraph/runtime/kernel/tanh.hpp"
+#include "ngraph/util.hpp"
+
+#ifdef NGRAPH_DISTRIBUTED
+#include "ngraph/runtime/kernel/allreduce.hpp"
+#endif
+
+using namespace std;
+using namespace ngraph;
+
+using runtime::interpreter::ExternalFunction;
+using runtime::interpreter::INT_CallFrame;
+using runtime::interpreter::INT_Kernel;
+using runtime::interpreter::INT_Plan;
+
+#define SELECT_BY_TYPE(ET, BUILDER, ...)                                                           \
+    if (ET == element::boolean)                                                                    \
+    {                                                                                              \
+        return BUILDER<char>(__VA_ARGS__);                                                         \
+    }                                                                                              \
+    else if (ET == element::f32)                                                                   \
+    {                                                                                              \
+        return BUILDER<float>(__VA_ARGS__);                                                        \
+    }                                                                                              \
+    else if (ET == element::f64)                                                                   \
+    {                                                                                              \
+        return BUILDER<double>(__VA_ARGS__);                                                       \
+    }                                                                                              \
+    else if (ET == element::i8)                                                                    \
+    {                                                                                              \
+        return BUILDER<int8_t>(__VA_ARGS__);                                                       \
+    }                                                                                              \
+    else if (ET == element::i16)                                                                   \
+    {                                                                                              \
+        return BUILDER<int16_t>(__VA_ARGS__);                                                      \
+    }                                                                                              \
+    else if (ET == element::i32)                                                                   \
+    {                                                                                              \
+        return BUILDER<int32_t>(__VA_ARGS__);                                                      \
+    }                                                                                              \
+    else if (ET == element::i64)                                                                   \
+    {                                                                                              \
+        return BUILDER<int64_t>(__VA_ARGS__);                                                      \
+    }                                                                                              \
+    else if (ET == element::u8)                                                                    \
+    {                                                                                              \
+        return BUILDER<uint8_t>(__VA_ARGS__);                                                      \
+    }                                                                                              \
+    else if (ET == element::u16)                                                                   \
+    {                                                                                              \
+        return BUILDER<uint16_t>(__VA_ARGS__);                                                     \
+    }                                                                                              \
+    else if (ET == element::u32)                                                                   \
+    {                                                                                              \
+        return BUILDER<uint32_t>(__VA_ARGS__);                                                     \
+    }                                                                                              \
+    else if (ET == element::u64)                                                                   \
+    {                                                                                              \
+        return BUILDER<uint64_t>(__VA_ARGS__);                                                     \
+    }                                                                                              \
+    throw ngraph_error("Unsupported element type " + ET.c_type_string() + " in interpreter");
+
+#define ARG(i, T) static_cast<T*>(args[i])
+#define OUT(i, T) static_cast<T*>(out[i])
+
+#define BUILD_UNARY_ELEMENTWISE(KERNEL)                                                            \
+    return [count](INT_CallFrame&, void* const* args, void* const* out) {                          \
+        KERNEL<T>(ARG(0, T), OUT(0, T), count);                                                    \
+    }
+
+#define BUILD_BINARY_ELEMENTWISE(KERNEL)                                                           \
+    return [count](INT_CallFrame&, void* const* args, void* const* out) {                          \
+        KERNEL<T>(ARG(0, T), ARG(1, T), OUT(0, T), count);                                         \
+    }
+
+#define BUILD_COMPARISON(KERNEL)                                                                   \
+    return [count](INT_CallFrame&, void* const* args, void* const* out) {                          \
+        KERNEL<T>(ARG(0, T), ARG(1, T), OUT(0, char), count);                                      \
+    }
+
+#define BUILD_REDUCTION(KERNEL, OP)                                                                \
+    {                                                                                              \
+        AxisSet axes = static_cast<const OP&>(node).get_reduction_axes();                          \
+        return [arg0_shape, out_shape, axes](                                                      \
+            INT_CallFrame&, void* const* args, void* const* out) {                                 \
+            KERNEL<T>(ARG(0, T), OUT(0, T), arg0_shape, out_shape, axes);                          \
+        };                                                                                         \
+    }
+
+namespace
+{
+    // Runs plan, which takes two scalars of type T and returns one of type R, for each
+    // element visited by Reduce, ReduceWindow and SelectAndScatter
+    template <typename T, typename R>
+    R call_scalar_function(INT_CallFrame& frame, const INT_Plan& plan, T x, T y)
+    {
+        R r;
+        void* args[] = {&x, &y};
+        void* out[] = {&r};
+        frame.call(plan, args, out);
+        return r;
+    }
+
+    template <typename TI>
+    struct ConvertBuilder
+    {
+        template <typename TO>
+        static INT_Kernel build(size_t count)
+        {
+            return [count](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::convert<TI, TO>(ARG(0, TI), OUT(0, TO), count);
+            };
+        }
+    };
+
+    template <typename T>
+    INT_Kernel build_typed(ExternalFunction* external_function, const Node& node)
+    {
+        const string node_op = node.description();
+        const Shape arg0_shape = node.get_inputs().empty() ? Shape{} : node.get_input_shape(0);
+        const Shape out_shape = node.get_output_size() == 0 ? Shape{} : node.get_output_shape(0);
+        const size_t count = shape_size(out_shape);
+
+        if (node_op == "Abs")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::abs);
+        }
+        else if (node_op == "Acos")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::acos);
+        }
+        else if (node_op == "Add")
+        {
+            BUILD_BINARY_ELEMENTWISE(runtime::kernel::add);
+        }
+#ifdef NGRAPH_DISTRIBUTED
+        else if (node_op == "AllReduce")
+        {
+            element::Type type = node.get_input_element_type(0);
+            return [type, count](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::allreduce<T>(
+                    ARG(0, T), OUT(0, T), type, static_cast<int>(count));
+            };
+        }
+#endif
+        else if (node_op == "Asin")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::asin);
+        }
+        else if (node_op == "Atan")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::atan);
+        }
+        else if (node_op == "AvgPool")
+        {
+            auto avg_pool = static_cast<const op::AvgPool*>(&node);
+            Shape window_shape = avg_pool->get_window_shape();
+            Strides window_movement_strides = avg_pool->get_window_movement_strides();
+            Shape padding_below = avg_pool->get_padding_below();
+            Shape padding_above = avg_pool->get_padding_above();
+            bool include_padding = avg_pool->get_include_padding_in_avg_computation();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::avg_pool<T>(ARG(0, T),
+                                             OUT(0, T),
+                                             arg0_shape,
+                                             out_shape,
+                                             window_shape,
+                                             window_movement_strides,
+                                             padding_below,
+                                             padding_above,
+                                             include_padding);
+            };
+        }
+        else if (node_op == "AvgPoolBackprop")
+        {
+            auto apb = static_cast<const op::AvgPoolBackprop*>(&node);
+            Shape window_shape = apb->get_window_shape();
+            Strides window_movement_strides = apb->get_window_movement_strides();
+            Shape padding_below = apb->get_padding_below();
+            Shape padding_above = apb->get_padding_above();
+            bool include_padding = apb->get_include_padding_in_avg_computation();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::avg_pool_backprop<T>(ARG(0, T),
+                                                      OUT(0, T),
+                                                      arg0_shape,
+                                                      out_shape,
+                                                      window_shape,
+                                                      window_movement_strides,
+                                                      padding_below,
+                                                      padding_above,
+                                                      include_padding);
+            };
+        }
+        else if (node_op == "Broadcast")
+        {
+            AxisSet broadcast_axes = static_cast<const op::Broadcast&>(node).get_broadcast_axes();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::broadcast<T>(
+                    ARG(0, T), OUT(0, T), arg0_shape, out_shape, broadcast_axes);
+            };
+        }
+        else if (node_op == "Ceiling")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::ceiling);
+        }
+        else if (node_op == "Concat")
+        {
+            size_t axis = static_cast<const op::Concat&>(node).get_concatenation_axis();
+            vector<Shape> in_shapes;
+            for (const descriptor::Input& input : node.get_inputs())
+            {
+                in_shapes.push_back(input.get_shape());
+            }
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                vector<const T*> in_args;
+                for (size_t i = 0; i < in_shapes.size(); i++)
+                {
+                    in_args.push_back(ARG(i, T));
+                }
+                runtime::kernel::concat<T>(in_args, OUT(0, T), in_shapes, out_shape, axis);
+            };
+        }
+        else if (node_op == "Constant")
+        {
+            // Copy the value so the plan does not keep the graph alive
+            const T* p =
+                static_cast<const T*>(static_cast<const op::Constant&>(node).get_data_ptr());
+            vector<T> data(p, p + count);
+            return [data, count](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::constant<T>(data.data(), OUT(0, T), count);
+            };
+        }
+        else if (node_op == "Convert")
+        {
+            const element::Type& out_type = node.get_output_element_type(0);
+            SELECT_BY_TYPE(out_type, ConvertBuilder<T>::template build, count);
+        }
+        else if (node_op == "Convolution")
+        {
+            auto c = static_cast<const op::Convolution*>(&node);
+            Shape arg1_shape = node.get_input_shape(1);
+            Strides window_movement_strides = c->get_window_movement_strides();
+            Strides window_dilation_strides = c->get_window_dilation_strides();
+            CoordinateDiff padding_below = c->get_padding_below();
+            CoordinateDiff padding_above = c->get_padding_above();
+            Strides data_dilation_strides = c->get_data_dilation_strides();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::convolution<T>(ARG(0, T),
+                                                ARG(1, T),
+                                                OUT(0, T),
+                                                arg0_shape,
+                                                arg1_shape,
+                                                out_shape,
+                                                window_movement_strides,
+                                                window_dilation_strides,
+                                                padding_below,
+                                                padding_above,
+                                                data_dilation_strides,
+                                                0,
+                                                1,
+                                                1,
+                                                0,
+                                                0,
+                                                1,
+                                                false);
+            };
+        }
+        else if (node_op == "ConvolutionBackpropFilters")
+        {
+            auto c = static_cast<const op::ConvolutionBackpropFilters*>(&node);
+            Shape arg1_shape = node.get_input_shape(1);
+            Strides window_movement_strides = c->get_window_movement_strides_backward();
+            Strides window_dilation_strides = c->get_window_dilation_strides_backward();
+            CoordinateDiff padding_below = c->get_padding_below_backward();
+            CoordinateDiff padding_above = c->get_padding_above_backward();
+            Strides data_dilation_strides = c->get_data_dilation_strides_backward();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::convolution<T>(ARG(0, T),
+                                                ARG(1, T),
+                                                OUT(0, T),
+                                                arg0_shape,
+                                                arg1_shape,
+                                                out_shape,
+                                                window_movement_strides,
+                                                window_dilation_strides,
+                                                padding_below,
+                                                padding_above,
+                                                data_dilation_strides,
+                                                1,
+                                                0,
+                                                0,
+                                                1,
+                                                1,
+                                                0,
+                                                false);
+            };
+        }
+        else if (node_op == "ConvolutionBackpropData")
+        {
+            // Note that args[1] and args[0] are switched here from the usual order.
+            auto c = static_cast<const op::ConvolutionBackpropData*>(&node);
+            Shape arg1_shape = node.get_input_shape(1);
+            Strides window_movement_strides = c->get_window_movement_strides_backward();
+            Strides window_dilation_strides = c->get_window_dilation_strides_backward();
+            CoordinateDiff padding_below = c->get_padding_below_backward();
+            CoordinateDiff padding_above = c->get_padding_above_backward();
+            Strides data_dilation_strides = c->get_data_dilation_strides_backward();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::convolution<T>(ARG(1, T),
+                                                ARG(0, T),
+                                                OUT(0, T),
+                                                arg1_shape,
+                                                arg0_shape,
+                                                out_shape,
+                                                window_movement_strides,
+                                                window_dilation_strides,
+                                                padding_below,
+                                                padding_above,
+                                                data_dilation_strides,
+                                                0,
+                                                1,
+                                                0,
+                                                1,
+                                                0,
+                                                1,
+                                                true);
+            };
+        }
+        else if (node_op == "Cos")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::cos);
+        }
+        else if (node_op == "Cosh")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::cosh);
+        }
+        else if (node_op == "Divide")
+        {
+            BUILD_BINARY_ELEMENTWISE(runtime::kernel::divide);
+        }
+        else if (node_op == "Dot")
+        {
+            Shape arg1_shape = node.get_input_shape(1);
+            size_t reduction_axes_count =
+                static_cast<const op::Dot&>(node).get_reduction_axes_count();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::dot<T>(ARG(0, T),
+                                        ARG(1, T),
+                                        OUT(0, T),
+                                        arg0_shape,
+                                        arg1_shape,
+                                        out_shape,
+                                        reduction_axes_count);
+            };
+        }
+        else if (node_op == "Equal")
+        {
+            BUILD_COMPARISON(runtime::kernel::equal);
+        }
+        else if (node_op == "Exp")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::exp);
+        }
+        else if (node_op == "Floor")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::floor);
+        }
+        else if (node_op == "FunctionCall")
+        {
+            const INT_Plan* plan = external_function->get_plan(node.get_functions()[0]);
+            return [plan](INT_CallFrame& frame, void* const* args, void* const* out) {
+                frame.call(*plan, args, out);
+            };
+        }
+        else if (node_op == "Greater")
+        {
+            BUILD_COMPARISON(runtime::kernel::greater);
+        }
+        else if (node_op == "GreaterEq")
+        {
+            BUILD_COMPARISON(runtime::kernel::greater_eq);
+        }
+        else if (node_op == "Less")
+        {
+            BUILD_COMPARISON(runtime::kernel::less);
+        }
+        else if (node_op == "LessEq")
+        {
+            BUILD_COMPARISON(runtime::kernel::less_eq);
+        }
+        else if (node_op == "Log")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::log);
+        }
+        else if (node_op == "Max")
+        {
+            BUILD_REDUCTION(runtime::kernel::max, op::Max);
+        }
+        else if (node_op == "Maximum")
+        {
+            BUILD_BINARY_ELEMENTWISE(runtime::kernel::maximum);
+        }
+        else if (node_op == "MaxPool")
+        {
+            auto max_pool = static_cast<const op::MaxPool*>(&node);
+            Shape window_shape = max_pool->get_window_shape();
+            Strides window_movement_strides = max_pool->get_window_movement_strides();
+            Shape padding_below = max_pool->get_padding_below();
+            Shape padding_above = max_pool->get_padding_above();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::max_pool<T>(ARG(0, T),
+                                             OUT(0, T),
+                                             arg0_shape,
+                                             out_shape,
+                                             window_shape,
+                                             window_movement_strides,
+                                             padding_below,
+                                             padding_above);
+            };
+        }
+        else if (node_op == "MaxPoolBackprop")
+        {
+            auto mpb = static_cast<const op::MaxPoolBackprop*>(&node);
+            Shape delta_shape = node.get_input_shape(1);
+            Shape window_shape = mpb->get_window_shape();
+            Strides window_movement_strides = mpb->get_window_movement_strides();
+            Shape padding_below = mpb->get_padding_below();
+            Shape padding_above = mpb->get_padding_above();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::max_pool_backprop<T>(ARG(0, T),
+                                                      ARG(1, T),
+                                                      OUT(0, T),
+                                                      delta_shape,
+                                                      out_shape,
+                                                      window_shape,
+                                                      window_movement_strides,
+                                                      padding_below,
+                                                      padding_above);
+            };
+        }
+        else if (node_op == "Min")
+        {
+            BUILD_REDUCTION(runtime::kernel::min, op::Min);
+        }
+        else if (node_op == "Minimum")
+        {
+            BUILD_BINARY_ELEMENTWISE(runtime::kernel::minimum);
+        }
+        else if (node_op == "Multiply")
+        {
+            BUILD_BINARY_ELEMENTWISE(runtime::kernel::multiply);
+        }
+        else if (node_op == "Negative")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::negate);
+        }
+        else if (node_op == "Not")
+        {
+            return [count](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::logical_not(ARG(0, char), OUT(0, char), count);
+            };
+        }
+        else if (node_op == "NotEqual")
+        {
+            BUILD_COMPARISON(runtime::kernel::not_equal);
+        }
+        else if (node_op == "OneHot")
+        {
+            size_t one_hot_axis = static_cast<const op::OneHot&>(node).get_one_hot_axis();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::one_hot<T>(
+                    ARG(0, T), OUT(0, T), arg0_shape, out_shape, one_hot_axis);
+            };
+        }
+        else if (node_op == "Pad")
+        {
+            auto pad = static_cast<const op::Pad*>(&node);
+            Shape padding_below = pad->get_padding_below();
+            Shape padding_above = pad->get_padding_above();
+            Shape padding_interior = pad->get_padding_interior();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::pad<T>(ARG(0, T),
+                                        ARG(1, T),
+                                        OUT(0, T),
+                                        arg0_shape,
+                                        out_shape,
+                                        padding_below,
+                                        padding_above,
+                                        padding_interior);
+            };
+        }
+        else if (node_op == "Power")
+        {
+            BUILD_BINARY_ELEMENTWISE(runtime::kernel::power);
+        }
+        else if (node_op == "Product")
+        {
+            BUILD_REDUCTION(runtime::kernel::product, op::Product);
+        }
+        else if (node_op == "Reduce")
+        {
+            AxisSet reduction_axes = static_cast<const op::Reduce&>(node).get_reduction_axes();
+            const INT_Plan* plan = external_function->get_plan(node.get_functions()[0]);
+            return [=](INT_CallFrame& frame, void* const* args, void* const* out) {
+                function<T(T, T)> f = [&frame, plan](T x, T y) -> T {
+                    return call_scalar_function<T, T>(frame, *plan, x, y);
+                };
+                runtime::kernel::reduce<T>(
+                    ARG(0, T), ARG(1, T), OUT(0, T), arg0_shape, out_shape, reduction_axes, f);
+            };
+        }
+        else if (node_op == "ReduceWindow")
+        {
+            auto reduce_window = static_cast<const op::ReduceWindow*>(&node);
+            Shape window_shape = reduce_window->get_window_shape();
+            Strides window_movement_strides = reduce_window->get_window_movement_strides();
+            const INT_Plan* plan = external_function->get_plan(node.get_functions()[0]);
+            return [=](INT_CallFrame& frame, void* const* args, void* const* out) {
+                function<T(T, T)> f = [&frame, plan](T x, T y) -> T {
+                    return call_scalar_function<T, T>(frame, *plan, x, y);
+                };
+                runtime::kernel::reduce_window<T>(ARG(0, T),
+                                                  ARG(1, T),
+                                                  OUT(0, T),
+                                                  arg0_shape,
+                                                  out_shape,
+                                                  f,
+                                                  window_shape,
+                                                  window_movement_strides);
+            };
+        }
+        else if (node_op == "Relu")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::relu);
+        }
+        else if (node_op == "ReluBackprop")
+        {
+            BUILD_BINARY_ELEMENTWISE(runtime::kernel::relu_backprop);
+        }
+        else if (node_op == "ReplaceSlice")
+        {
+            auto slice = static_cast<const op::ReplaceSlice*>(&node);
+            Shape arg1_shape = node.get_input_shape(1);
+            Coordinate lower_bounds = slice->get_lower_bounds();
+            Coordinate upper_bounds = slice->get_upper_bounds();
+            Strides strides = slice->get_strides();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::replace_slice<T>(ARG(0, T),
+                                                  ARG(1, T),
+                                                  OUT(0, T),
+                                                  arg1_shape,
+                                                  lower_bounds,
+                                                  upper_bounds,
+                                                  strides,
+                                                  out_shape);
+            };
+        }
+        else if (node_op == "Reshape")
+        {
+            AxisVector input_order = static_cast<const op::Reshape&>(node).get_input_order();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::reshape<T>(
+                    ARG(0, T), OUT(0, T), arg0_shape, input_order, out_shape);
+            };
+        }
+        else if (node_op == "Result")
+        {
+            return [count](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::result<T>(ARG(0, T), OUT(0, T), count);
+            };
+        }
+        else if (node_op == "Reverse")
+        {
+            AxisSet reversed_axes = static_cast<const op::Reverse&>(node).get_reversed_axes();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::reverse<T>(
+                    ARG(0, T), OUT(0, T), arg0_shape, out_shape, reversed_axes);
+            };
+        }
+        else if (node_op == "Select")
+        {
+            return [count](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::select<T>(ARG(0, char), ARG(1, T), ARG(2, T), OUT(0, T), count);
+            };
+        }
+        else if (node_op == "SelectAndScatter")
+        {
+            auto select_and_scatter = static_cast<const op::SelectAndScatter*>(&node);
+            Shape arg1_shape = node.get_input_shape(1);
+            Shape window_shape = select_and_scatter->get_window_shape();
+            Strides window_movement_strides = select_and_scatter->get_window_movement_strides();
+            const INT_Plan* selection_plan =
+                external_function->get_plan(node.get_functions()[0]);
+            const INT_Plan* scatter_plan = external_function->get_plan(node.get_functions()[1]);
+            return [=](INT_CallFrame& frame, void* const* args, void* const* out) {
+                function<char(T, T)> f_selection = [&frame, selection_plan](T x, T y) -> char {
+                    return call_scalar_function<T, char>(frame, *selection_plan, x, y);
+                };
+                function<T(T, T)> f_scatter = [&frame, scatter_plan](T x, T y) -> T {
+                    return call_scalar_function<T, T>(frame, *scatter_plan, x, y);
+                };
+                runtime::kernel::select_and_scatter<T>(ARG(0, T),
+                                                       ARG(1, T),
+                                                       ARG(2, T),
+                                                       OUT(0, T),
+                                                       arg0_shape,
+                                                       arg1_shape,
+                                                       out_shape,
+                                                       f_selection,
+                                                       f_scatter,
+                                                       window_shape,
+                                                       window_movement_strides);
+            };
+        }
+        else if (node_op == "Sign")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::sign);
+        }
+        else if (node_op == "Sin")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::sin);
+        }
+        else if (node_op == "Sinh")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::sinh);
+        }
+        else if (node_op == "Slice")
+        {
+            auto slice = static_cast<const op::Slice*>(&node);
+            Coordinate lower_bounds = slice->get_lower_bounds();
+            Coordinate upper_bounds = slice->get_upper_bounds();
+            Strides strides = slice->get_strides();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::slice<T>(ARG(0, T),
+                                          OUT(0, T),
+                                          arg0_shape,
+                                          lower_bounds,
+                                          upper_bounds,
+                                          strides,
+                                          out_shape);
+            };
+        }
+        else if (node_op == "Softmax")
+        {
+            AxisSet axes = static_cast<const op::Softmax&>(node).get_axes();
+            return [=](INT_CallFrame&, void* const* args, void* const* out) {
+                runtime::kernel::softmax<T>(ARG(0, T), OUT(0, T), out_shape, axes);
+            };
+        }
+        else if (node_op == "Sqrt")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::sqrt);
+        }
+        else if (node_op == "Subtract")
+        {
+            BUILD_BINARY_ELEMENTWISE(runtime::kernel::subtract);
+        }
+        else if (node_op == "Sum")
+        {
+            BUILD_REDUCTION(runtime::kernel::sum, op::Sum);
+        }
+        else if (node_op == "Tan")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::tan);
+        }
+        else if (node_op == "Tanh")
+        {
+            BUILD_UNARY_ELEMENTWISE(runtime::kernel::tanh);
+        }
+
+        throw ngraph_error("Unsupported op in interpreter: " + node_op);
+    }
+}
+
+INT_Kernel runtime::interpreter::build_kernel(ExternalFunction* external_function,
+                                              const Node& node)
+{
+    // Kernels are instantiated for the type of their first argument, except for ops
+    // with no arguments and for Select, whose first argument is the boolean mask
+    element::Type type = node.get_inputs().empty() ? node.get_output_element_type(0)
+                                                   : node.get_input_element_type(0);
+    if (node.description() == "Select")
+    {
+        type = node.get_input_element_type(1);
+    }
+    SELECT_BY_TYPE(type, build_typed, external_function, node);
+}
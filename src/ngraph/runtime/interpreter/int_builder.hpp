@@ -0,0 +1,37 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include "ngraph/node.hpp"
+#include "ngraph/runtime/interpreter/int_plan.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace interpreter
+        {
+            class ExternalFunction;
+
+            /// @brief Bind node to the reference kernel for its op and element types.
+            ///
+            /// Ops that call other functions (Reduce, FunctionCall, ...) get the plans of
+            /// those functions from external_function.
+            INT_Kernel build_kernel(ExternalFunction* external_function, const Node& node);
+        }
+    }
+}
@@ -15,198 +15,132 @@
 *******************************************************************************/
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <iomanip>
 
-#include "ngraph/ops/result.hpp"
+#include "ngraph/except.hpp"
 #include "ngraph/runtime/host_tensor_view.hpp"
 #include "ngraph/runtime/interpreter/int_call_frame.hpp"
+#include "ngraph/runtime/interpreter/int_external_function.hpp"
 
 using namespace std;
 using namespace ngraph;
 
-runtime::interpreter::INT_CallFrame::INT_CallFrame(shared_ptr<ExternalFunction> external_function,
-                                                   shared_ptr<Function> func)
+runtime::interpreter::INT_CallFrame::INT_CallFrame(shared_ptr<ExternalFunction> external_function)
     : m_external_function(external_function)
-    , m_function(func)
+    , m_main_plan(external_function->get_main_plan())
     , m_emit_timing(std::getenv("NGRAPH_INTERPRETER_EMIT_TIMING") != nullptr)
     , m_nan_check(std::getenv("NGRAPH_INTERPRETER_NAN_CHECK") != nullptr)
 {
-}
-
-void runtime::interpreter::INT_CallFrame::call(
-    std::shared_ptr<Function> function,
-    const vector<shared_ptr<runtime::HostTensorView>>& input_tvs,
-    const vector<shared_ptr<runtime::HostTensorView>>& output_tvs)
-{
-    if (m_nan_check)
-    {
-        perform_nan_check(input_tvs);
-    }
-    unordered_map<descriptor::TensorView*, shared_ptr<runtime::HostTensorView>> tensor_map;
-    size_t arg_index = 0;
-    for (shared_ptr<op::Parameter> param : function->get_parameters())
-    {
-        for (size_t i = 0; i < param->get_output_size(); ++i)
-        {
-            descriptor::TensorView* tv = param->get_output_tensor_view(i).get();
-            tensor_map.insert({tv, input_tvs[arg_index++]});
-        }
-    }
-
-    for (size_t i = 0; i < function->get_output_size(); i++)
+    for (const unique_ptr<INT_Plan>& plan : external_function->get_plans())
     {
-        auto output_op = function->get_output_op(i);
-        if (!std::dynamic_pointer_cast<op::Result>(output_op))
+        size_t max_args = 0;
+        size_t max_outputs = 0;
+        for (const INT_Step& step : plan->steps)
         {
-            throw ngraph_error("One of function's outputs isn't op::Result");
+            max_args = max(max_args, step.args.size());
+            max_outputs = max(max_outputs, step.outputs.size());
         }
-        descriptor::TensorView* tv = function->get_output_op(i)->get_output_tensor_view(0).get();
-        tensor_map.insert({tv, output_tvs[i]});
-    }
 
-    // Invoke computation
-    for (shared_ptr<Node> op : function->get_ordered_ops())
-    {
-        if (op->description() == "Parameter")
+        PlanState state;
+        state.plan = plan.get();
+        if (plan->pool_size > 0)
         {
-            continue;
+            state.pool.reset(new runtime::AlignedBuffer(plan->pool_size, runtime::alignment));
         }
-
-        vector<shared_ptr<runtime::HostTensorView>> inputs;
-        vector<shared_ptr<runtime::HostTensorView>> outputs;
-        for (const descriptor::Input& input : op->get_inputs())
+        state.tensors.resize(plan->tensors.size(), nullptr);
+        for (size_t i = 0; i < plan->tensors.size(); i++)
         {
-            descriptor::TensorView* tv = input.get_output().get_tensor_view().get();
-            string name = tv->get_tensor().get_name();
-            inputs.push_back(tensor_map.at(tv));
-        }
-        for (size_t i = 0; i < op->get_output_size(); ++i)
-        {
-            descriptor::TensorView* tv = op->get_output_tensor_view(i).get();
-            string name = tv->get_tensor().get_name();
-            shared_ptr<runtime::HostTensorView> itv;
-            if (!contains_key(tensor_map, tv))
-            {
-                // The output tensor is not in the tensor map so create a new tensor
-                const Shape& shape = op->get_output_shape(i);
-                const element::Type& element_type = op->get_output_element_type(i);
-                string tensor_name = op->get_output_tensor(i).get_name();
-                itv = make_shared<runtime::HostTensorView>(element_type, shape, tensor_name);
-                tensor_map.insert({tv, itv});
-            }
-            else
+            const INT_TensorInfo& info = plan->tensors[i];
+            if (!info.is_bound)
             {
-                itv = tensor_map.at(tv);
+                state.tensors[i] = state.pool->get_ptr(info.pool_offset);
             }
-            outputs.push_back(itv);
-        }
-
-        element::Type base_type;
-        element::Type secondary_type;
-        if (op->get_inputs().empty())
-        {
-            base_type = op->get_element_type();
-        }
-        else
-        {
-            base_type = op->get_inputs().at(0).get_tensor().get_element_type();
-        }
-        secondary_type = op->get_element_type();
-
-        // Some ops have unusual intput/output types so handle those special cases here
-        if (op->description() == "Select")
-        {
-            base_type = op->get_inputs().at(1).get_tensor().get_element_type();
-            secondary_type = op->get_inputs().at(0).get_tensor().get_element_type();
-        }
-
-        if (m_emit_timing)
-        {
-            m_timer_map[op.get()].start();
-        }
-        generate_calls(base_type, secondary_type, *op, inputs, outputs);
-        if (m_emit_timing)
-        {
-            stopwatch& timer = m_timer_map[op.get()];
-            timer.stop();
-        }
-        if (m_nan_check)
-        {
-            perform_nan_check(outputs, op.get());
         }
+        state.args.resize(max_args, nullptr);
+        state.outputs.resize(max_outputs, nullptr);
+        state.timers.resize(plan->steps.size());
+        m_plan_states.push_back(move(state));
+    }
 
-        // Delete any obsolete tensors
-        for (const descriptor::Tensor* t : op->liveness_free_list)
-        {
-            for (auto it = tensor_map.begin(); it != tensor_map.end(); ++it)
-            {
-                if (it->second->get_tensor().get_name() == t->get_name())
-                {
-                    tensor_map.erase(it);
-                    break;
-                }
-            }
-        }
+    if (const char* env_threads = std::getenv("NGRAPH_INTERPRETER_THREADS"))
+    {
+        set_thread_count(std::strtoul(env_threads, nullptr, 10));
     }
 }
 
-void runtime::interpreter::INT_CallFrame::generate_calls(
-    const element::Type& base_type,
-    const element::Type& secondary_type,
-    ngraph::Node& op,
-    const std::vector<std::shared_ptr<HostTensorView>>& args,
-    const std::vector<std::shared_ptr<HostTensorView>>& out)
+void runtime::interpreter::INT_CallFrame::set_thread_count(size_t thread_count)
 {
-    if (base_type == element::boolean)
-    {
-        generate_calls<char>(secondary_type, op, args, out);
-    }
-    else if (base_type == element::f32)
+    m_scheduler.reset();
+    m_worker_args.clear();
+    m_worker_outputs.clear();
+    if (thread_count > 1)
     {
-        generate_calls<float>(secondary_type, op, args, out);
+        m_external_function->prepare_parallel_execution();
+        const PlanState& state = m_plan_states[m_main_plan->index];
+        m_scheduler.reset(new INT_Scheduler(thread_count));
+        m_worker_args.resize(thread_count, state.args);
+        m_worker_outputs.resize(thread_count, state.outputs);
     }
-    else if (base_type == element::f64)
-    {
-        generate_calls<double>(secondary_type, op, args, out);
-    }
-    else if (base_type == element::i8)
+}
+
+void runtime::interpreter::INT_CallFrame::bind(const INT_Plan& plan,
+                                               PlanState& state,
+                                               void* const* inputs,
+                                               void* const* outputs)
+{
+    if (m_nan_check)
     {
-        generate_calls<int8_t>(secondary_type, op, args, out);
+        perform_nan_check(plan, plan.parameters, inputs);
     }
-    else if (base_type == element::i16)
+    for (size_t i = 0; i < plan.parameters.size(); i++)
     {
-        generate_calls<int16_t>(secondary_type, op, args, out);
+        state.tensors[plan.parameters[i]] = inputs[i];
     }
-    else if (base_type == element::i32)
+    for (size_t i = 0; i < plan.results.size(); i++)
     {
-        generate_calls<int32_t>(secondary_type, op, args, out);
+        state.tensors[plan.results[i]] = outputs[i];
     }
-    else if (base_type == element::i64)
+}
+
+void runtime::interpreter::INT_CallFrame::run_step(
+    const INT_Plan& plan, PlanState& state, size_t step_index, void** args, void** outputs)
+{
+    const INT_Step& step = plan.steps[step_index];
+    for (size_t i = 0; i < step.args.size(); i++)
     {
-        generate_calls<int64_t>(secondary_type, op, args, out);
+        args[i] = state.tensors[step.args[i]];
     }
-    else if (base_type == element::u8)
+    for (size_t i = 0; i < step.outputs.size(); i++)
     {
-        generate_calls<uint8_t>(secondary_type, op, args, out);
+        outputs[i] = state.tensors[step.outputs[i]];
     }
-    else if (base_type == element::u16)
+
+    if (m_emit_timing)
     {
-        generate_calls<uint16_t>(secondary_type, op, args, out);
+        state.timers[step_index].start();
     }
-    else if (base_type == element::u32)
+    step.kernel(*this, args, outputs);
+    if (m_emit_timing)
     {
-        generate_calls<uint32_t>(secondary_type, op, args, out);
+        state.timers[step_index].stop();
     }
-    else if (base_type == element::u64)
+    if (m_nan_check)
     {
-        generate_calls<uint64_t>(secondary_type, op, args, out);
+        perform_nan_check(plan, step.outputs, outputs, &step);
     }
-    else
+}
+
+void runtime::interpreter::INT_CallFrame::call(const INT_Plan& plan,
+                                               void* const* inputs,
+                                               void* const* outputs)
+{
+    PlanState& state = m_plan_states[plan.index];
+    bind(plan, state, inputs, outputs);
+    for (size_t s = 0; s < plan.steps.size(); s++)
     {
-        stringstream ss;
-        ss << "unsupported element type " << base_type << " op " << op.get_name();
-        throw runtime_error(ss.str());
+        run_step(plan, state, s, state.args.data(), state.outputs.data());
     }
 }
 
@@ -214,7 +148,44 @@ void runtime::interpreter::INT_CallFrame::tensor_call(
     const vector<shared_ptr<runtime::HostTensorView>>& input_tvs,
     const vector<shared_ptr<runtime::HostTensorView>>& output_tvs)
 {
-    call(m_function, input_tvs, output_tvs);
+    if (input_tvs.size() != m_main_plan->parameters.size() ||
+        output_tvs.size() != m_main_plan->results.size())
+    {
+        throw ngraph_error("Function called with the wrong number of arguments or results");
+    }
+
+    m_inputs.clear();
+    for (const shared_ptr<runtime::HostTensorView>& tv : input_tvs)
+    {
+        m_inputs.push_back(tv->get_data_ptr());
+    }
+    m_outputs.clear();
+    for (const shared_ptr<runtime::HostTensorView>& tv : output_tvs)
+    {
+        m_outputs.push_back(tv->get_data_ptr());
+    }
+    if (!m_scheduler)
+    {
+        call(*m_main_plan, m_inputs.data(), m_outputs.data());
+        return;
+    }
+
+    const INT_Plan& plan = *m_main_plan;
+    PlanState& state = m_plan_states[plan.index];
+    bind(plan, state, m_inputs.data(), m_outputs.data());
+    m_scheduler->run(plan, [&](size_t step, size_t worker) {
+        void** args = m_worker_args[worker].data();
+        void** outputs = m_worker_outputs[worker].data();
+        if (plan.steps[step].calls_functions)
+        {
+            lock_guard<mutex> lock(m_nested_call_mutex);
+            run_step(plan, state, step, args, outputs);
+        }
+        else
+        {
+            run_step(plan, state, step, args, outputs);
+        }
+    });
 }
 
 void runtime::interpreter::INT_CallFrame::tensor_call(
@@ -257,61 +228,53 @@ vector<runtime::PerformanceCounter>
     runtime::interpreter::INT_CallFrame::get_performance_data() const
 {
     vector<runtime::PerformanceCounter> rc;
-    for (const pair<const Node*, stopwatch> p : m_timer_map)
+    for (const PlanState& state : m_plan_states)
     {
-        rc.emplace_back(p.first->get_name().c_str(),
-                        p.second.get_total_microseconds(),
-                        p.second.get_call_count());
+        for (size_t s = 0; s < state.timers.size(); s++)
+        {
+            const stopwatch& timer = state.timers[s];
+            if (timer.get_call_count() > 0)
+            {
+                rc.emplace_back(state.plan->steps[s].name.c_str(),
+                                timer.get_total_microseconds(),
+                                timer.get_call_count());
+            }
+        }
     }
     return rc;
 }
 
-void runtime::interpreter::INT_CallFrame::perform_nan_check(
-    const vector<shared_ptr<HostTensorView>>& tvs, const Node* op)
+void runtime::interpreter::INT_CallFrame::perform_nan_check(const INT_Plan& plan,
+                                                            const vector<size_t>& tensors,
+                                                            void* const* data,
+                                                            const INT_Step* step)
 {
-    size_t arg_number = 1;
-    for (shared_ptr<HostTensorView> tv : tvs)
+    for (size_t arg = 0; arg < tensors.size(); arg++)
     {
-        const element::Type& type = tv->get_tensor().get_element_type();
-        if (type == element::f32)
+        const INT_TensorInfo& info = plan.tensors[tensors[arg]];
+        bool has_nan = false;
+        if (info.element_type == element::f32)
         {
-            const float* data = reinterpret_cast<float*>(tv->get_data_ptr());
-            for (size_t i = 0; i < tv->get_element_count(); i++)
-            {
-                if (std::isnan(data[i]))
-                {
-                    if (op)
-                    {
-                        throw runtime_error("nan found in op '" + op->get_name() + "' output");
-                    }
-                    else
-                    {
-                        throw runtime_error("nan found in function's input tensor number " +
-                                            to_string(arg_number));
-                    }
-                }
-            }
+            const float* p = static_cast<const float*>(data[arg]);
+            has_nan = any_of(p, p + info.element_count, [](float x) { return std::isnan(x); });
         }
-        else if (type == element::f64)
+        else if (info.element_type == element::f64)
         {
-            const double* data = reinterpret_cast<double*>(tv->get_data_ptr());
-            for (size_t i = 0; i < tv->get_element_count(); i++)
+            const double* p = static_cast<const double*>(data[arg]);
+            has_nan = any_of(p, p + info.element_count, [](double x) { return std::isnan(x); });
+        }
+        if (has_nan)
+        {
+            if (step)
+            {
+                throw runtime_error("nan found in op '" + step->name + "' output");
+            }
+            else
             {
-                if (std::isnan(data[i]))
-                {
-                    if (op)
-                    {
-                        throw runtime_error("nan found in op '" + op->get_name() + "' output");
-                    }
-                    else
-                    {
-                        throw runtime_error("nan found in function's input tensor number " +
-                                            to_string(arg_number));
-                    }
-                }
+                throw runtime_error("nan found in function's input tensor number " +
+                                    to_string(arg + 1));
             }
         }
-        arg_number++;
     }
 }
 
@@ -14,8 +14,10 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
+#include <set>
 #include <string>
 #include <tuple>
 #include <typeindex>
@@ -55,10 +57,12 @@
 #include "ngraph/ops/multiply.hpp"
 #include "ngraph/ops/negative.hpp"
 #include "ngraph/ops/not_equal.hpp"
+#include "ngraph/ops/parameter.hpp"
 #include "ngraph/ops/power.hpp"
 #include "ngraph/ops/reduce.hpp"
 #include "ngraph/ops/relu.hpp"
 #include "ngraph/ops/reshape.hpp"
+#include "ngraph/ops/result.hpp"
 #include "ngraph/ops/select.hpp"
 #include "ngraph/ops/sign.hpp"
 #include "ngraph/ops/sin.hpp"
@@ -74,6 +78,7 @@
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/memory_layout.hpp"
 #include "ngraph/runtime/interpreter/int_backend.hpp"
+#include "ngraph/runtime/interpreter/int_builder.hpp"
 #include "ngraph/runtime/interpreter/int_call_frame.hpp"
 #include "ngraph/runtime/interpreter/int_external_function.hpp"
 
@@ -81,6 +86,7 @@ using namespace std;
 using namespace ngraph;
 
 static const string s_output_dir = "cpu_codegen";
+static const size_t s_memory_pool_alignment = 64;
 
 class StaticInitializers
 {
@@ -95,7 +101,7 @@ using descriptor::layout::DenseTensorViewLayout;
 runtime::interpreter::ExternalFunction::ExternalFunction(const shared_ptr<Function>& function,
                                                          bool release_function)
     : runtime::ExternalFunction(function, release_function)
-    , m_function(function)
+    , m_main_plan(nullptr)
 {
 }
 
@@ -113,11 +119,17 @@ void runtime::interpreter::ExternalFunction::compile()
     // For now, just make everyone row-major.
     pass_manager.register_pass<pass::AssignLayout<DenseTensorViewLayout>>();
     pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>(s_memory_pool_alignment);
     pass_manager.run_passes(m_function);
 
+    // Resolve every op to its kernel once here, rather than on each call
+    m_main_plan = get_plan(m_function);
+
     m_is_compiled = true;
     if (m_release_function)
     {
+        // Plans hold no references to the graph, so this frees it
+        m_plan_map.clear();
         release_function();
     }
 }
@@ -129,5 +141,170 @@ shared_ptr<runtime::CallFrame> runtime::interpreter::ExternalFunction::make_call
         compile();
     }
 
-    return make_shared<runtime::interpreter::INT_CallFrame>(shared_from_this(), m_function);
+    return make_shared<runtime::interpreter::INT_CallFrame>(shared_from_this());
+}
+
+const runtime::interpreter::INT_Plan*
+    runtime::interpreter::ExternalFunction::get_plan(const shared_ptr<Function>& function)
+{
+    auto it = m_plan_map.find(function.get());
+    if (it != m_plan_map.end())
+    {
+        return it->second;
+    }
+
+    // Register the plan before building its steps so ops that call back into a
+    // function already being planned find it
+    m_plans.emplace_back(new INT_Plan());
+    INT_Plan* plan = m_plans.back().get();
+    plan->index = m_plans.size() - 1;
+    m_plan_map.insert({function.get(), plan});
+
+    // Temporaries were placed by MemoryLayout; constants and other tensors that are
+    // neither bound nor temporary are laid out after them
+    plan->pool_size = function->get_temporary_pool_size();
+    unordered_map<const descriptor::Tensor*, size_t> tensor_index;
+    auto add_tensor = [&](const Node& node, size_t output, bool is_bound) {
+        const descriptor::Tensor& tensor = node.get_output_tensor(output);
+        const Shape& shape = node.get_output_shape(output);
+        size_t pool_offset = 0;
+        if (tensor.has_liveness())
+        {
+            pool_offset = tensor.get_pool_offset();
+        }
+        else if (!is_bound)
+        {
+            pool_offset = plan->pool_size;
+            plan->pool_size += pass::MemoryManager::align(tensor.size(), s_memory_pool_alignment);
+        }
+        plan->tensors.push_back({tensor.get_element_type(),
+                                 shape,
+                                 shape_size(shape),
+                                 tensor.get_name(),
+                                 is_bound,
+                                 pool_offset});
+        tensor_index.insert({&tensor, plan->tensors.size() - 1});
+        return plan->tensors.size() - 1;
+    };
+
+    for (shared_ptr<op::Parameter> param : function->get_parameters())
+    {
+        for (size_t i = 0; i < param->get_output_size(); ++i)
+        {
+            plan->parameters.push_back(add_tensor(*param, i, true));
+        }
+    }
+
+    for (size_t i = 0; i < function->get_output_size(); i++)
+    {
+        auto output_op = function->get_output_op(i);
+        if (!dynamic_pointer_cast<op::Result>(output_op))
+        {
+            throw ngraph_error("One of function's outputs isn't op::Result");
+        }
+        plan->results.push_back(add_tensor(*output_op, 0, true));
+    }
+
+    for (shared_ptr<Node> node : function->get_ordered_ops())
+    {
+        if (dynamic_pointer_cast<op::Parameter>(node))
+        {
+            continue;
+        }
+
+        INT_Step step;
+        step.name = node->get_name();
+        for (const descriptor::Input& input : node->get_inputs())
+        {
+            step.args.push_back(tensor_index.at(&input.get_tensor()));
+        }
+        for (size_t i = 0; i < node->get_output_size(); ++i)
+        {
+            auto tit = tensor_index.find(&node->get_output_tensor(i));
+            step.outputs.push_back(tit == tensor_index.end() ? add_tensor(*node, i, false)
+                                                             : tit->second);
+        }
+        step.kernel = build_kernel(this, *node);
+        step.predecessor_count = 0;
+        step.calls_functions = !node->get_functions().empty();
+        plan->steps.push_back(move(step));
+    }
+
+    return plan;
+}
+
+void runtime::interpreter::ExternalFunction::prepare_parallel_execution()
+{
+    call_once(m_step_dependencies_once,
+              [this]() { add_step_dependencies(*m_plans[m_main_plan->index]); });
+}
+
+// The parallel scheduler runs a step once all steps it depends on have run. Besides the
+// producers of its arguments, a step depends on every step that used pool memory its
+// outputs overwrite, since MemoryLayout reuses memory assuming the serial order.
+void runtime::interpreter::ExternalFunction::add_step_dependencies(INT_Plan& plan)
+{
+    const size_t none = plan.steps.size();
+    vector<size_t> producer(plan.tensors.size(), none);
+    vector<vector<size_t>> users(plan.tensors.size());
+    vector<set<size_t>> successors(plan.steps.size());
+    for (size_t s = 0; s < plan.steps.size(); s++)
+    {
+        for (size_t arg : plan.steps[s].args)
+        {
+            if (producer[arg] != none)
+            {
+                successors[producer[arg]].insert(s);
+            }
+            users[arg].push_back(s);
+        }
+        for (size_t output : plan.steps[s].outputs)
+        {
+            producer[output] = s;
+            users[output].push_back(s);
+        }
+    }
+
+    vector<size_t> pooled;
+    for (size_t i = 0; i < plan.tensors.size(); i++)
+    {
+        if (!plan.tensors[i].is_bound && producer[i] != none)
+        {
+            pooled.push_back(i);
+        }
+    }
+    auto begin = [&](size_t i) { return plan.tensors[i].pool_offset; };
+    auto end = [&](size_t i) {
+        const INT_TensorInfo& info = plan.tensors[i];
+        return info.pool_offset + info.element_count * info.element_type.size();
+    };
+    sort(pooled.begin(), pooled.end(), [&](size_t a, size_t b) { return begin(a) < begin(b); });
+    for (size_t i = 0; i < pooled.size(); i++)
+    {
+        for (size_t j = i + 1; j < pooled.size() && begin(pooled[j]) < end(pooled[i]); j++)
+        {
+            size_t a = pooled[i];
+            size_t b = pooled[j];
+            if (users[b].back() < producer[a])
+            {
+                swap(a, b);
+            }
+            if (users[a].back() < producer[b])
+            {
+                for (size_t user : users[a])
+                {
+                    successors[user].insert(producer[b]);
+                }
+            }
+        }
+    }
+
+    for (size_t s = 0; s < plan.steps.size(); s++)
+    {
+        plan.steps[s].successors.assign(successors[s].begin(), successors[s].end());
+        for (size_t successor : successors[s])
+        {
+            plan.steps[successor].predecessor_count++;
+        }
+    }
 }
@@ -17,10 +17,14 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "ngraph/function.hpp"
 #include "ngraph/runtime/call_frame.hpp"
 #include "ngraph/runtime/external_function.hpp"
+#include "ngraph/runtime/interpreter/int_plan.hpp"
 
 namespace ngraph
 {
@@ -36,9 +40,24 @@ namespace ngraph
                                  bool release_function = true);
                 std::shared_ptr<ngraph::runtime::CallFrame> make_call_frame();
 
+                /// @brief Plan of the function being compiled or of a function it calls,
+                /// built on first request.
+                const INT_Plan* get_plan(const std::shared_ptr<Function>& function);
+                const INT_Plan* get_main_plan() const { return m_main_plan; }
+                const std::vector<std::unique_ptr<INT_Plan>>& get_plans() const { return m_plans; }
+                /// @brief Fill in the step dependencies of the main plan that the parallel
+                /// scheduler needs. Done on the first multi-threaded call frame only, since
+                /// serial execution just runs the steps in order.
+                void prepare_parallel_execution();
+
             protected:
-                std::shared_ptr<ngraph::Function> m_function;
                 void compile();
+                static void add_step_dependencies(INT_Plan& plan);
+
+                std::vector<std::unique_ptr<INT_Plan>> m_plans;
+                std::unordered_map<const Function*, INT_Plan*> m_plan_map;
+                const INT_Plan* m_main_plan;
+                std::once_flag m_step_dependencies_once;
             };
         }
     }
@@ -0,0 +1,86 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ngraph/shape.hpp"
+#include "ngraph/types/element_type.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace interpreter
+        {
+            class INT_CallFrame;
+
+            /// @brief An op's kernel with its element types resolved and its shapes and
+            /// attributes bound. args and out are the data pointers of the op's tensors.
+            using INT_Kernel =
+                std::function<void(INT_CallFrame& frame, void* const* args, void* const* out)>;
+
+            struct INT_TensorInfo
+            {
+                element::Type element_type;
+                Shape shape;
+                size_t element_count;
+                std::string name;
+                /// Parameters and results are bound to the caller's buffers on each call.
+                /// Every other tensor has a fixed place in the call frame's pool.
+                bool is_bound;
+                size_t pool_offset;
+            };
+
+            struct INT_Step
+            {
+                /// Name of the op, for performance data and NaN check messages. The plan
+                /// keeps no reference to the graph, so it can be released after compiling.
+                std::string name;
+                /// Indices into INT_Plan::tensors
+                std::vector<size_t> args;
+                std::vector<size_t> outputs;
+                INT_Kernel kernel;
+                /// Steps that must wait for this one, because they read its outputs or
+                /// reuse pool memory it reads or writes
+                std::vector<size_t> successors;
+                size_t predecessor_count;
+                /// The kernel runs other plans (Reduce, FunctionCall, ...)
+                bool calls_functions;
+            };
+
+            /// @brief Execution plan of one function, built once at compile time.
+            ///
+            /// Every tensor of the function gets an index; the call frame binds parameters
+            /// and results to the caller's buffers and runs the steps in order. Temporaries
+            /// are placed by pass::MemoryLayout, constants follow them in the pool.
+            struct INT_Plan
+            {
+                /// Position of this plan in ExternalFunction's plan list
+                size_t index;
+                std::vector<INT_TensorInfo> tensors;
+                std::vector<size_t> parameters;
+                std::vector<size_t> results;
+                std::vector<INT_Step> steps;
+                /// Bytes of pool a call frame needs to run this plan
+                size_t pool_size;
+            };
+        }
+    }
+}
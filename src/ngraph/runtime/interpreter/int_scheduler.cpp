@@ -0,0 +1,262 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "ngraph/runtime/interpreter/int_scheduler.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Failed polls of the deques before an idle worker blocks
+static const size_t s_spin_count = 64;
+
+runtime::interpreter::INT_Scheduler::INT_Scheduler(size_t thread_count)
+    : m_plan(nullptr)
+    , m_run_step(nullptr)
+    , m_pending_size(0)
+    , m_remaining(0)
+    , m_failed(false)
+    , m_sleepers(0)
+    , m_generation(0)
+    , m_active(0)
+    , m_stop(false)
+{
+    thread_count = max<size_t>(thread_count, 1);
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        m_workers.emplace_back(new Worker());
+    }
+    for (size_t i = 1; i < thread_count; i++)
+    {
+        m_threads.emplace_back(&INT_Scheduler::worker_main, this, i);
+    }
+}
+
+runtime::interpreter::INT_Scheduler::~INT_Scheduler()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for (thread& t : m_threads)
+    {
+        t.join();
+    }
+}
+
+void runtime::interpreter::INT_Scheduler::run(const INT_Plan& plan, const StepFunction& run_step)
+{
+    size_t step_count = plan.steps.size();
+    if (step_count == 0)
+    {
+        return;
+    }
+    if (m_pending_size < step_count)
+    {
+        m_pending.reset(new atomic<size_t>[step_count]);
+        m_pending_size = step_count;
+    }
+
+    size_t next_worker = 0;
+    for (size_t step = 0; step < step_count; step++)
+    {
+        size_t predecessor_count = plan.steps[step].predecessor_count;
+        m_pending[step].store(predecessor_count);
+        if (predecessor_count == 0)
+        {
+            push(next_worker, step);
+            next_worker = (next_worker + 1) % m_workers.size();
+        }
+    }
+    m_plan = &plan;
+    m_run_step = &run_step;
+    m_remaining.store(step_count);
+    m_failed.store(false);
+    m_exception = nullptr;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_generation++;
+        m_active = m_threads.size();
+    }
+    m_start.notify_all();
+
+    execute(0);
+
+    {
+        unique_lock<mutex> lock(m_mutex);
+        m_done.wait(lock, [this]() { return m_active == 0; });
+    }
+
+    // A failed run leaves steps behind
+    for (unique_ptr<Worker>& worker : m_workers)
+    {
+        worker->ready.clear();
+    }
+    if (m_exception)
+    {
+        rethrow_exception(m_exception);
+    }
+}
+
+void runtime::interpreter::INT_Scheduler::worker_main(size_t worker)
+{
+    size_t generation = 0;
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_start.wait(lock, [&]() { return m_stop || m_generation != generation; });
+            if (m_stop)
+            {
+                return;
+            }
+            generation = m_generation;
+        }
+
+        execute(worker);
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            if (--m_active == 0)
+            {
+                m_done.notify_one();
+            }
+        }
+    }
+}
+
+void runtime::interpreter::INT_Scheduler::execute(size_t worker)
+{
+    size_t idle_polls = 0;
+    while (m_remaining.load() > 0 && !m_failed.load())
+    {
+        size_t step;
+        if (!pop(worker, step))
+        {
+            wait_for_work(idle_polls++);
+            continue;
+        }
+        idle_polls = 0;
+
+        try
+        {
+            (*m_run_step)(step, worker);
+        }
+        catch (...)
+        {
+            lock_guard<mutex> lock(m_exception_mutex);
+            if (!m_exception)
+            {
+                m_exception = current_exception();
+            }
+            m_failed.store(true);
+        }
+
+        for (size_t successor : m_plan->steps[step].successors)
+        {
+            if (m_pending[successor].fetch_sub(1) == 1)
+            {
+                push(worker, successor);
+            }
+        }
+        if (m_remaining.fetch_sub(1) == 1 || m_failed.load())
+        {
+            wake_all();
+        }
+    }
+}
+
+void runtime::interpreter::INT_Scheduler::wait_for_work(size_t idle_polls)
+{
+    // A short spin covers the common case of a successor being pushed right away
+    if (idle_polls < s_spin_count)
+    {
+        this_thread::yield();
+        return;
+    }
+
+    unique_lock<mutex> lock(m_idle_mutex);
+    m_sleepers++;
+    m_work.wait(lock, [this]() {
+        if (m_remaining.load() == 0 || m_failed.load())
+        {
+            return true;
+        }
+        for (unique_ptr<Worker>& worker : m_workers)
+        {
+            lock_guard<mutex> worker_lock(worker->mutex);
+            if (!worker->ready.empty())
+            {
+                return true;
+            }
+        }
+        return false;
+    });
+    m_sleepers--;
+}
+
+void runtime::interpreter::INT_Scheduler::wake_all()
+{
+    {
+        lock_guard<mutex> lock(m_idle_mutex);
+    }
+    m_work.notify_all();
+}
+
+bool runtime::interpreter::INT_Scheduler::pop(size_t worker, size_t& step)
+{
+    {
+        Worker& own = *m_workers[worker];
+        lock_guard<mutex> lock(own.mutex);
+        if (!own.ready.empty())
+        {
+            step = own.ready.back();
+            own.ready.pop_back();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < m_workers.size(); i++)
+    {
+        Worker& victim = *m_workers[(worker + i) % m_workers.size()];
+        lock_guard<mutex> lock(victim.mutex);
+        if (!victim.ready.empty())
+        {
+            step = victim.ready.front();
+            victim.ready.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void runtime::interpreter::INT_Scheduler::push(size_t worker, size_t step)
+{
+    {
+        Worker& own = *m_workers[worker];
+        lock_guard<mutex> lock(own.mutex);
+        own.ready.push_back(step);
+    }
+    // Sleepers register under m_idle_mutex before checking the deques, so taking it here
+    // means a sleeper either sees this step or is already waiting for the notification.
+    if (m_sleepers.load() > 0)
+    {
+        {
+            lock_guard<mutex> lock(m_idle_mutex);
+        }
+        m_work.notify_one();
+    }
+}
@@ -0,0 +1,101 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ngraph/runtime/interpreter/int_plan.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace interpreter
+        {
+            class INT_Scheduler;
+        }
+    }
+}
+
+/// @brief Runs the steps of a plan on a pool of worker threads as their arguments
+/// become ready.
+///
+/// Each worker keeps a deque of ready steps. A worker pushes the steps its own step
+/// unblocked onto the back of its deque and pops from there. When it runs dry it steals
+/// from the front of the other workers' deques, and blocks once there is nothing to steal.
+/// The thread calling run() is worker 0.
+class ngraph::runtime::interpreter::INT_Scheduler
+{
+public:
+    using StepFunction = std::function<void(size_t step, size_t worker)>;
+
+    INT_Scheduler(size_t thread_count);
+    ~INT_Scheduler();
+
+    size_t get_thread_count() const { return m_workers.size(); }
+    /// @brief Run every step of plan, each once all of its predecessors have finished.
+    /// Rethrows the first exception thrown by a step after all workers have stopped.
+    void run(const INT_Plan& plan, const StepFunction& run_step);
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<size_t> ready;
+    };
+
+    void worker_main(size_t worker);
+    void execute(size_t worker);
+    bool pop(size_t worker, size_t& step);
+    void push(size_t worker, size_t step);
+    void wait_for_work(size_t idle_polls);
+    void wake_all();
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+
+    // State of the current run
+    const INT_Plan* m_plan;
+    const StepFunction* m_run_step;
+    std::unique_ptr<std::atomic<size_t>[]> m_pending;
+    size_t m_pending_size;
+    std::atomic<size_t> m_remaining;
+    std::atomic<bool> m_failed;
+    std::exception_ptr m_exception;
+    std::mutex m_exception_mutex;
+
+    // Idle workers spin briefly, then block here until a step is pushed or the run ends
+    std::mutex m_idle_mutex;
+    std::condition_variable m_work;
+    std::atomic<size_t> m_sleepers;
+
+    // Wakes the worker threads for a run and tells run() when they are done
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    size_t m_generation;
+    size_t m_active;
+    bool m_stop;
+};
@@ -18,7 +18,8 @@
 
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/axis_set.hpp"
+#include "ngraph/strided_walk.hpp"
 
 namespace ngraph
 {
@@ -33,16 +34,20 @@ namespace ngraph
                            const Shape& out_shape,
                            const AxisSet& broadcast_axes)
             {
-                CoordinateTransform input_transform(in_shape);
-                CoordinateTransform output_transform(out_shape);
-
-                for (const Coordinate& output_coord : output_transform)
+                // Broadcast axes do not move through the input
+                StridedWalk::SignedStrides in_strides = StridedWalk::dense_strides(in_shape);
+                StridedWalk::SignedStrides walk_strides(out_shape.size(), 0);
+                size_t in_axis = 0;
+                for (size_t i = 0; i < out_shape.size(); i++)
                 {
-                    Coordinate input_coord = project(output_coord, broadcast_axes);
-
-                    out[output_transform.index(output_coord)] =
-                        arg[input_transform.index(input_coord)];
+                    if (broadcast_axes.count(i) == 0)
+                    {
+                        walk_strides[i] = in_strides[in_axis++];
+                    }
                 }
+                StridedWalk walk(
+                    out_shape, 0, walk_strides, 0, StridedWalk::dense_strides(out_shape));
+                walk.for_each([&](size_t in, size_t o) { out[o] = arg[in]; });
             }
         }
     }
@@ -16,10 +16,10 @@
 
 #pragma once
 
-#include <cmath>
-#include <utility>
+#include <algorithm>
+#include <cstddef>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/shape.hpp"
 
 namespace ngraph
 {
@@ -27,6 +27,65 @@ namespace ngraph
     {
         namespace kernel
         {
+            /// @brief out[m x n] = arg0[m x k] * arg1[k x n], all dense row-major.
+            ///
+            /// Every output element accumulates its products in increasing k, as an unblocked
+            /// loop would, so results do not depend on the block sizes.
+            template <typename T>
+            void gemm(const T* arg0, const T* arg1, T* out, size_t m, size_t k, size_t n)
+            {
+                // Block sizes in elements. A block of arg1 (block_k by block_n) stays in L2
+                // while the rows of a block of arg0 stream past it.
+                const size_t block_m = 64;
+                const size_t block_k = 128;
+                const size_t block_n = 256;
+
+                std::fill(out, out + m * n, T(0));
+                for (size_t j0 = 0; j0 < n; j0 += block_n)
+                {
+                    size_t j1 = std::min(j0 + block_n, n);
+                    for (size_t p0 = 0; p0 < k; p0 += block_k)
+                    {
+                        size_t p1 = std::min(p0 + block_k, k);
+                        for (size_t i0 = 0; i0 < m; i0 += block_m)
+                        {
+                            size_t i1 = std::min(i0 + block_m, m);
+                            for (size_t i = i0; i < i1; i++)
+                            {
+                                T* out_row = out + i * n;
+                                for (size_t p = p0; p < p1; p++)
+                                {
+                                    // Unit stride over j in both arg1 and out, so this
+                                    // inner loop vectorizes.
+                                    const T a = arg0[i * k + p];
+                                    const T* arg1_row = arg1 + p * n;
+                                    for (size_t j = j0; j < j1; j++)
+                                    {
+                                        out_row[j] += a * arg1_row[j];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Matrix-vector case; each output is one dot product, accumulated in a register.
+            template <typename T>
+            void gemv(const T* arg0, const T* arg1, T* out, size_t m, size_t k)
+            {
+                for (size_t i = 0; i < m; i++)
+                {
+                    const T* arg0_row = arg0 + i * k;
+                    T sum = 0;
+                    for (size_t p = 0; p < k; p++)
+                    {
+                        sum += arg0_row[p] * arg1[p];
+                    }
+                    out[i] = sum;
+                }
+            }
+
             template <typename T>
             void dot(const T* arg0,
                      const T* arg1,
@@ -36,84 +95,31 @@ namespace ngraph
                      const Shape& out_shape,
                      size_t reduction_axes_count)
             {
-                // Get the sizes of the dot axes. It's easiest to pull them from arg1 because they're
-                // right up front.
-                Shape dot_axis_sizes(reduction_axes_count);
-                std::copy(arg1_shape.begin(),
-                          arg1_shape.begin() + reduction_axes_count,
-                          dot_axis_sizes.begin());
-
-                CoordinateTransform arg0_transform(arg0_shape);
-                CoordinateTransform arg1_transform(arg1_shape);
-                CoordinateTransform output_transform(out_shape);
-
-                // Create coordinate transforms for arg0 and arg1 that throw away the dotted axes.
+                // The dotted axes are the last reduction_axes_count axes of arg0 and the first
+                // reduction_axes_count axes of arg1, and the output shape is the concatenation of
+                // the remaining axes. With row-major layout that makes any Dot a matrix product:
+                // arg0 is [m x k], arg1 is [k x n] and out is [m x n].
                 size_t arg0_projected_rank = arg0_shape.size() - reduction_axes_count;
-                size_t arg1_projected_rank = arg1_shape.size() - reduction_axes_count;
 
-                Shape arg0_projected_shape(arg0_projected_rank);
-                std::copy(arg0_shape.begin(),
-                          arg0_shape.begin() + arg0_projected_rank,
-                          arg0_projected_shape.begin());
-
-                Shape arg1_projected_shape(arg1_projected_rank);
-                std::copy(arg1_shape.begin() + reduction_axes_count,
-                          arg1_shape.end(),
-                          arg1_projected_shape.begin());
-
-                CoordinateTransform arg0_projected_transform(arg0_projected_shape);
-                CoordinateTransform arg1_projected_transform(arg1_projected_shape);
-
-                // Create a coordinate transform that allows us to iterate over all possible values
-                // for the dotted axes.
-                CoordinateTransform dot_axes_transform(dot_axis_sizes);
-
-                for (const Coordinate& arg0_projected_coord : arg0_projected_transform)
+                size_t m = 1;
+                for (size_t i = 0; i < arg0_projected_rank; i++)
                 {
-                    for (const Coordinate& arg1_projected_coord : arg1_projected_transform)
-                    {
-                        // The output coordinate is just the concatenation of the projected coordinates.
-                        Coordinate out_coord(arg0_projected_coord.size() +
-                                             arg1_projected_coord.size());
-
-                        auto out_coord_it = std::copy(arg0_projected_coord.begin(),
-                                                      arg0_projected_coord.end(),
-                                                      out_coord.begin());
-                        std::copy(
-                            arg1_projected_coord.begin(), arg1_projected_coord.end(), out_coord_it);
-
-                        // Zero out to start the sum.
-                        T sum = 0;
-
-                        size_t out_index = output_transform.index(out_coord);
-
-                        // Walk along the dotted axes.
-                        Coordinate arg0_coord(arg0_shape.size());
-                        Coordinate arg1_coord(arg1_shape.size());
-                        auto arg0_it = std::copy(arg0_projected_coord.begin(),
-                                                 arg0_projected_coord.end(),
-                                                 arg0_coord.begin());
-                        for (const Coordinate& dot_axis_positions : dot_axes_transform)
-                        {
-                            // In order to find the points to multiply together, we need to inject our current
-                            // positions along the dotted axes back into the projected arg0 and arg1 coordinates.
-                            std::copy(
-                                dot_axis_positions.begin(), dot_axis_positions.end(), arg0_it);
-
-                            auto arg1_it = std::copy(dot_axis_positions.begin(),
-                                                     dot_axis_positions.end(),
-                                                     arg1_coord.begin());
-                            std::copy(
-                                arg1_projected_coord.begin(), arg1_projected_coord.end(), arg1_it);
-
-                            // Multiply and add to the sum.
-                            sum += arg0[arg0_transform.index(arg0_coord)] *
-                                   arg1[arg1_transform.index(arg1_coord)];
-                        }
+                    m *= arg0_shape[i];
+                }
+                size_t k = 1;
+                size_t n = 1;
+                for (size_t i = 0; i < arg1_shape.size(); i++)
+                {
+                    (i < reduction_axes_count ? k : n) *= arg1_shape[i];
+                }
 
-                        // Write the sum back.
-                        out[out_index] = sum;
-                    }
+                if (n == 1)
+                {
+                    gemv(arg0, arg1, out, m, k);
+                }
+                else
+                {
+                    gemm(arg0, arg1, out, m, k, n);
                 }
             }
         }
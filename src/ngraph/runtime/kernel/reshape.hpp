@@ -19,7 +19,7 @@
 #include <cmath>
 
 #include "ngraph/axis_vector.hpp"
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/strided_walk.hpp"
 
 namespace ngraph
 {
@@ -34,26 +34,18 @@ namespace ngraph
                          const AxisVector& in_axis_order,
                          const Shape& out_shape)
             {
-                // Unfortunately we don't yet have a constructor for CoordinateTransform that lets us pass only source_space_shape
-                // and source_axis_order so we have to construct the defaults here.
-                Shape in_start_corner(in_shape.size(), 0); // (0,...0)
-                Strides in_strides(in_shape.size(), 1);    // (1,...,1)
-
-                CoordinateTransform input_transform(
-                    in_shape, in_start_corner, in_shape, in_strides, in_axis_order);
-
-                CoordinateTransform output_transform(out_shape);
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                for (const Coordinate& input_coord : input_transform)
+                // Walk the input in the new axis order; the output is written sequentially
+                StridedWalk::SignedStrides in_strides = StridedWalk::dense_strides(in_shape);
+                Shape walk_shape(in_shape.size());
+                StridedWalk::SignedStrides walk_strides(in_shape.size());
+                for (size_t i = 0; i < in_axis_order.size(); i++)
                 {
-                    const Coordinate& output_coord = *output_it;
-
-                    out[output_transform.index(output_coord)] =
-                        arg[input_transform.index(input_coord)];
-
-                    ++output_it;
+                    walk_shape[i] = in_shape[in_axis_order[i]];
+                    walk_strides[i] = in_strides[in_axis_order[i]];
                 }
+                StridedWalk walk(
+                    walk_shape, 0, walk_strides, 0, StridedWalk::dense_strides(walk_shape));
+                walk.for_each([&](size_t in, size_t o) { out[o] = arg[in]; });
             }
         }
     }
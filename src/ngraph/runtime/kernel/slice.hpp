@@ -18,7 +18,9 @@
 
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/coordinate.hpp"
+#include "ngraph/strided_walk.hpp"
+#include "ngraph/strides.hpp"
 
 namespace ngraph
 {
@@ -35,19 +37,16 @@ namespace ngraph
                        const Strides& strides,
                        const Shape& out_shape)
             {
-                CoordinateTransform input_transform(arg_shape, lower_bounds, upper_bounds, strides);
-                CoordinateTransform output_transform(out_shape);
-
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                for (const Coordinate& in_coord : input_transform)
+                StridedWalk::SignedStrides arg_strides = StridedWalk::dense_strides(arg_shape);
+                std::ptrdiff_t arg_offset = 0;
+                for (size_t i = 0; i < arg_shape.size(); i++)
                 {
-                    const Coordinate& out_coord = *output_it;
-
-                    out[output_transform.index(out_coord)] = arg[input_transform.index(in_coord)];
-
-                    ++output_it;
+                    arg_offset += lower_bounds[i] * arg_strides[i];
+                    arg_strides[i] *= strides[i];
                 }
+                StridedWalk walk(
+                    out_shape, arg_offset, arg_strides, 0, StridedWalk::dense_strides(out_shape));
+                walk.for_each([&](size_t in, size_t o) { out[o] = arg[in]; });
             }
         }
     }
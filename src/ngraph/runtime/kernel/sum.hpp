@@ -18,7 +18,8 @@
 
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/axis_set.hpp"
+#include "ngraph/strided_walk.hpp"
 
 namespace ngraph
 {
@@ -33,22 +34,26 @@ namespace ngraph
                      const Shape& out_shape,
                      const AxisSet& reduction_axes)
             {
-                CoordinateTransform output_transform(out_shape);
-
-                for (const Coordinate& output_coord : output_transform)
+                size_t out_count = shape_size(out_shape);
+                for (size_t i = 0; i < out_count; i++)
                 {
-                    out[output_transform.index(output_coord)] = 0;
+                    out[i] = 0;
                 }
 
-                CoordinateTransform input_transform(in_shape);
-
-                for (const Coordinate& input_coord : input_transform)
+                // Reduced axes do not move through the output
+                StridedWalk::SignedStrides out_strides = StridedWalk::dense_strides(out_shape);
+                StridedWalk::SignedStrides walk_strides(in_shape.size(), 0);
+                size_t out_axis = 0;
+                for (size_t i = 0; i < in_shape.size(); i++)
                 {
-                    Coordinate output_coord = project(input_coord, reduction_axes);
-
-                    out[output_transform.index(output_coord)] +=
-                        arg[input_transform.index(input_coord)];
+                    if (reduction_axes.count(i) == 0)
+                    {
+                        walk_strides[i] = out_strides[out_axis++];
+                    }
                 }
+                StridedWalk walk(
+                    in_shape, 0, StridedWalk::dense_strides(in_shape), 0, walk_strides);
+                walk.for_each([&](size_t in, size_t o) { out[o] += arg[in]; });
             }
         }
     }
@@ -0,0 +1,161 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ngraph/except.hpp"
+#include "ngraph/shape.hpp"
+
+namespace ngraph
+{
+    /// @brief Visits every coordinate of a box in row-major order, keeping the flat offsets
+    /// of a source and a target tensor.
+    ///
+    /// Each tensor is addressed as offset + sum(coordinate[i] * strides[i]), with strides in
+    /// elements. Strides may be 0 (broadcast, reduction) or negative (reversal). Offsets are
+    /// advanced incrementally, so unlike iterating CoordinateTransforms there is no per
+    /// element allocation or index computation. Ranks up to 3 run as plain nested loops.
+    class StridedWalk
+    {
+    public:
+        using SignedStrides = std::vector<std::ptrdiff_t>;
+
+        StridedWalk(const Shape& shape,
+                    std::ptrdiff_t source_offset,
+                    const SignedStrides& source_strides,
+                    std::ptrdiff_t target_offset,
+                    const SignedStrides& target_strides)
+            : m_shape(shape)
+            , m_source_offset(source_offset)
+            , m_source_strides(source_strides)
+            , m_target_offset(target_offset)
+            , m_target_strides(target_strides)
+        {
+            if (source_strides.size() != shape.size() || target_strides.size() != shape.size())
+            {
+                throw ngraph_error("StridedWalk strides must have one entry per axis");
+            }
+        }
+
+        /// @brief Strides of a dense row-major tensor of the given shape.
+        static SignedStrides dense_strides(const Shape& shape)
+        {
+            SignedStrides strides(shape.size());
+            std::ptrdiff_t stride = 1;
+            for (size_t i = shape.size(); i-- > 0;)
+            {
+                strides[i] = stride;
+                stride *= shape[i];
+            }
+            return strides;
+        }
+
+        /// @brief Calls f(source_offset, target_offset) for every coordinate.
+        template <typename F>
+        void for_each(F f) const
+        {
+            for (size_t d : m_shape)
+            {
+                if (d == 0)
+                {
+                    return;
+                }
+            }
+
+            const SignedStrides& ss = m_source_strides;
+            const SignedStrides& ts = m_target_strides;
+            switch (m_shape.size())
+            {
+            case 0: f(size_t(m_source_offset), size_t(m_target_offset)); break;
+            case 1: walk_last_axis(m_source_offset, m_target_offset, f); break;
+            case 2:
+                for (std::ptrdiff_t i = 0; i < std::ptrdiff_t(m_shape[0]); i++)
+                {
+                    walk_last_axis(m_source_offset + i * ss[0], m_target_offset + i * ts[0], f);
+                }
+                break;
+            case 3:
+                for (std::ptrdiff_t i = 0; i < std::ptrdiff_t(m_shape[0]); i++)
+                {
+                    for (std::ptrdiff_t j = 0; j < std::ptrdiff_t(m_shape[1]); j++)
+                    {
+                        walk_last_axis(m_source_offset + i * ss[0] + j * ss[1],
+                                       m_target_offset + i * ts[0] + j * ts[1],
+                                       f);
+                    }
+                }
+                break;
+            default: walk(f); break;
+            }
+        }
+
+    private:
+        template <typename F>
+        void walk_last_axis(std::ptrdiff_t source, std::ptrdiff_t target, F& f) const
+        {
+            size_t count = m_shape.back();
+            std::ptrdiff_t source_stride = m_source_strides.back();
+            std::ptrdiff_t target_stride = m_target_strides.back();
+            for (size_t i = 0; i < count; i++)
+            {
+                f(size_t(source), size_t(target));
+                source += source_stride;
+                target += target_stride;
+            }
+        }
+
+        // Odometer over all axes but the last, which walk_last_axis covers
+        template <typename F>
+        void walk(F& f) const
+        {
+            size_t outer_axes = m_shape.size() - 1;
+            std::vector<size_t> counter(outer_axes, 0);
+            std::ptrdiff_t source = m_source_offset;
+            std::ptrdiff_t target = m_target_offset;
+            while (true)
+            {
+                walk_last_axis(source, target, f);
+
+                size_t axis = outer_axes;
+                while (axis-- > 0)
+                {
+                    source += m_source_strides[axis];
+                    target += m_target_strides[axis];
+                    if (++counter[axis] < m_shape[axis])
+                    {
+                        break;
+                    }
+                    source -= m_source_strides[axis] * std::ptrdiff_t(m_shape[axis]);
+                    target -= m_target_strides[axis] * std::ptrdiff_t(m_shape[axis]);
+                    counter[axis] = 0;
+                    if (axis == 0)
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+
+        Shape m_shape;
+        std::ptrdiff_t m_source_offset;
+        SignedStrides m_source_strides;
+        std::ptrdiff_t m_target_offset;
+        SignedStrides m_target_strides;
+    };
+}
@@ -41,10 +41,18 @@ int main(int argc, char** argv)
     string model;
     string backend = "CPU";
     int iterations = 10;
+    int warmup_iterations = 1;
     bool failed = false;
     bool statistics = false;
     bool timing_detail = false;
     bool visualize = false;
+    double peak_gflops = 0;
+    double peak_gbps = 0;
+    string json_output;
+    string baseline;
+    double threshold = 5;
+    vector<size_t> thread_counts;
+    bool pin_threads = false;
     for (size_t i = 1; i < argc; i++)
     {
         string arg = argv[i];
@@ -68,6 +76,37 @@ int main(int argc, char** argv)
                 failed = true;
             }
         }
+        else if (arg == "-w" || arg == "--warmup_iterations")
+        {
+            try
+            {
+                warmup_iterations = stoi(argv[++i]);
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "-t" || arg == "--threads")
+        {
+            try
+            {
+                for (const string& count : split(argv[++i], ',', true))
+                {
+                    thread_counts.push_back(stoul(count));
+                }
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--pin")
+        {
+            pin_threads = true;
+        }
         else if (arg == "-s" || arg == "--statistics")
         {
             statistics = true;
@@ -76,6 +115,38 @@ int main(int argc, char** argv)
         {
             timing_detail = true;
         }
+        else if (arg == "--json")
+        {
+            json_output = argv[++i];
+        }
+        else if (arg == "--compare")
+        {
+            baseline = argv[++i];
+        }
+        else if (arg == "--peak_gflops" || arg == "--peak_gbps" || arg == "--threshold")
+        {
+            try
+            {
+                double value = stod(argv[++i]);
+                if (arg == "--peak_gflops")
+                {
+                    peak_gflops = value;
+                }
+                else if (arg == "--peak_gbps")
+                {
+                    peak_gbps = value;
+                }
+                else
+                {
+                    threshold = value;
+                }
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
         else if (arg == "-v" || arg == "--visualize")
         {
             visualize = true;
@@ -91,6 +162,17 @@ int main(int argc, char** argv)
         cout << "File " << model << " not found\n";
         failed = true;
     }
+    if (!baseline.empty() && !static_cast<bool>(ifstream(baseline)))
+    {
+        cout << "Baseline " << baseline << " not found\n";
+        failed = true;
+    }
+
+    if (thread_counts.size() > 1 && (!json_output.empty() || !baseline.empty()))
+    {
+        cout << "--json and --compare take a single thread count in throughput mode\n";
+        failed = true;
+    }
 
     if (failed)
     {
@@ -99,15 +181,28 @@ DESCRIPTION
     Benchmark ngraph json model with given backend.
 
 SYNOPSIS
-        nbench [-f <filename>] [-b <backend>] [-i <iterations>]
+        nbench [-f <filename>] [-b <backend>] [-i <iterations>] [-w <warmup iterations>]
+               [--json <filename>] [--compare <baseline> [--threshold <percent>]]
+               [-t <thread count>[,<thread count>...] [--pin]]
 
 OPTIONS
         -f|--file          Serialized model file
         -b|--backend       Backend to use (default: CPU)
         -i|--iterations    Iterations (default: 10)
+        -w|--warmup_iterations
+                           Unmeasured iterations after the first call (default: 1)
         -s|--statistics    Display op stastics
         -v|--visualize     Visualize a model (WARNING: requires GraphViz installed)
-        --timing_detail    Gather detailed timing
+        --timing_detail    Gather detailed timing, and the GFLOP/s and GB/s achieved per op
+        --peak_gflops      Peak GFLOP/s of the machine, to place ops on its roofline
+        --peak_gbps        Peak memory bandwidth of the machine in GB/s
+        --json             Save compile, first call and per iteration times as JSON
+        --compare          Compare with times saved by --json, exit with 1 on regressions.
+                           Both take a single thread count in throughput mode
+        --threshold        Slowdown in percent flagged as a regression (default: 5)
+        -t|--threads       Throughput mode: run each given number of threads concurrently,
+                           each with its own call frame, and report calls/s and latencies
+        --pin              Split the cores evenly between the threads of throughput mode
 )###";
         return 1;
     }
@@ -164,7 +259,35 @@ OPTIONS
     {
         cout << "Benchmarking " << model << ", " << backend << " backend, " << iterations
              << " iterations.\n";
-        run_benchmark(f, backend, iterations, timing_detail);
+        BenchmarkOptions options;
+        options.iterations = iterations;
+        options.warmup_iterations = warmup_iterations;
+        options.timing_detail = timing_detail;
+        options.peak_gflops = peak_gflops;
+        options.peak_gbps = peak_gbps;
+        BenchmarkResult result;
+        if (thread_counts.empty())
+        {
+            result = run_benchmark(f, backend, options);
+        }
+        else
+        {
+            vector<BenchmarkResult> results =
+                run_concurrent_benchmark(f, backend, options, thread_counts, pin_threads);
+            if (results.size() != 1)
+            {
+                return 0;
+            }
+            result = results[0];
+        }
+        if (!json_output.empty())
+        {
+            write_benchmark_json(result, json_output);
+        }
+        if (!baseline.empty() && !compare_benchmark(result, baseline, threshold))
+        {
+            return 1;
+        }
     }
 
     return 0;
@@ -14,6 +14,8 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <cstdlib>
 #include <random>
 #include <sstream>
 #include <string>
@@ -23,6 +25,8 @@
 #include "ngraph/log.hpp"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/runtime/interpreter/int_call_frame.hpp"
+#include "ngraph/runtime/interpreter/int_external_function.hpp"
+#include "util/random.hpp"
 #include "util/test_tools.hpp"
 
 using namespace std;
@@ -79,3 +83,128 @@ TEST(INTERPRETER, nan_check_output)
     icf->set_nan_check(true);
     EXPECT_ANY_THROW(icf->call({a, b}, {result}));
 }
+
+TEST(INTERPRETER, dispatch_plan)
+{
+    Shape shape{2, 3};
+    auto fA = make_shared<op::Parameter>(element::f32, Shape{});
+    auto fB = make_shared<op::Parameter>(element::f32, Shape{});
+    auto g = make_shared<Function>(fA + fB, op::ParameterVector{fA, fB});
+
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, Shape{});
+    auto reduce = make_shared<op::Reduce>(A * A, B, g, AxisSet{1});
+    auto f = make_shared<Function>(reduce, op::ParameterVector{A, B});
+
+    auto manager = runtime::Manager::get("INTERPRETER");
+    auto external = manager->compile(f);
+    auto backend = manager->allocate_backend();
+    auto cf = backend->make_call_frame(external);
+
+    // One plan for f and one for the reduction function, with every op resolved
+    auto ief = static_pointer_cast<runtime::interpreter::ExternalFunction>(external);
+    ASSERT_EQ(ief->get_plans().size(), 2);
+    const runtime::interpreter::INT_Plan* plan = ief->get_main_plan();
+    ASSERT_NE(plan, nullptr);
+    EXPECT_EQ(plan->parameters.size(), 2);
+    EXPECT_EQ(plan->results.size(), 1);
+    EXPECT_EQ(plan->steps.size(), 3);
+    for (const runtime::interpreter::INT_Step& step : plan->steps)
+    {
+        EXPECT_TRUE(static_cast<bool>(step.kernel));
+    }
+
+    // The Multiply and Reduce outputs are live together, so they get separate, aligned
+    // places in the call frame's pool
+    const runtime::interpreter::INT_TensorInfo& product =
+        plan->tensors[plan->steps[0].outputs[0]];
+    const runtime::interpreter::INT_TensorInfo& reduced =
+        plan->tensors[plan->steps[1].outputs[0]];
+    EXPECT_FALSE(product.is_bound);
+    EXPECT_FALSE(reduced.is_bound);
+    EXPECT_NE(product.pool_offset, reduced.pool_offset);
+    EXPECT_EQ(plan->pool_size, 128);
+
+    auto a = backend->make_primary_tensor_view(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4, 5, 6});
+    auto b = backend->make_primary_tensor_view(element::f32, Shape{});
+    copy_data(b, vector<float>{1});
+    auto result = backend->make_primary_tensor_view(element::f32, Shape{2});
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        cf->call({a, b}, {result});
+        EXPECT_EQ((vector<float>{15, 78}), read_vector<float>(result));
+    }
+
+    // The plans do not hold on to the graph, so it is gone once the caller drops it
+    weak_ptr<Function> weak_f = f;
+    weak_ptr<Function> weak_g = g;
+    f = nullptr;
+    g = nullptr;
+    reduce = nullptr;
+    EXPECT_TRUE(weak_f.expired());
+    EXPECT_TRUE(weak_g.expired());
+    cf->call({a, b}, {result});
+    EXPECT_EQ((vector<float>{15, 78}), read_vector<float>(result));
+}
+
+TEST(INTERPRETER, parallel_execution)
+{
+    // Independent branches of dots and reductions joined at the end, with enough
+    // temporaries that MemoryLayout has to reuse pool memory
+    Shape shape{8, 8};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto fA = make_shared<op::Parameter>(element::f32, Shape{});
+    auto fB = make_shared<op::Parameter>(element::f32, Shape{});
+    auto g = make_shared<Function>(fA + fB, op::ParameterVector{fA, fB});
+    auto zero = op::Constant::create(element::f32, Shape{}, {0});
+    shared_ptr<Node> sum;
+    for (size_t i = 0; i < 8; i++)
+    {
+        shared_ptr<Node> branch = make_shared<op::Dot>(A, B) * A + B;
+        branch = make_shared<op::Dot>(branch, A) - branch;
+        auto reduced = make_shared<op::Reduce>(branch, zero, g, AxisSet{1});
+        sum = sum ? sum + reduced : reduced;
+    }
+    auto f = make_shared<Function>(sum, op::ParameterVector{A, B});
+
+    auto manager = runtime::Manager::get("INTERPRETER");
+    auto external = manager->compile(f);
+    auto backend = manager->allocate_backend();
+    auto serial = backend->make_call_frame(external);
+    auto parallel = backend->make_call_frame(external);
+    static_pointer_cast<runtime::interpreter::INT_CallFrame>(serial)->set_thread_count(1);
+
+    // Step dependencies are only worked out once a frame runs multi-threaded
+    auto ief = static_pointer_cast<runtime::interpreter::ExternalFunction>(external);
+    const runtime::interpreter::INT_Plan& plan = *ief->get_main_plan();
+    auto has_dependencies = [&]() {
+        return any_of(plan.steps.begin(),
+                      plan.steps.end(),
+                      [](const runtime::interpreter::INT_Step& step) {
+                          return step.predecessor_count > 0;
+                      });
+    };
+    if (getenv("NGRAPH_INTERPRETER_THREADS") == nullptr)
+    {
+        EXPECT_FALSE(has_dependencies());
+    }
+    static_pointer_cast<runtime::interpreter::INT_CallFrame>(parallel)->set_thread_count(4);
+    EXPECT_TRUE(has_dependencies());
+
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    auto a = backend->make_primary_tensor_view(element::f32, shape);
+    auto b = backend->make_primary_tensor_view(element::f32, shape);
+    auto expected = backend->make_primary_tensor_view(element::f32, Shape{8});
+    auto result = backend->make_primary_tensor_view(element::f32, Shape{8});
+    for (size_t i = 0; i < 10; i++)
+    {
+        rng.initialize(a);
+        rng.initialize(b);
+        serial->call({a, b}, {expected});
+        parallel->call({a, b}, {result});
+        EXPECT_EQ(read_vector<float>(expected), read_vector<float>(result));
+    }
+}
@@ -1243,6 +1243,58 @@ TEST(${BACKEND_NAME}, dot_matrix_vector_int64)
     EXPECT_EQ((vector<int64_t>{190, 486, 782, 1078}), read_vector<int64_t>(result));
 }
 
+// Large enough to cross the block boundaries of the reference GEMM in every dimension
+TEST(${BACKEND_NAME}, dot_matrix_blocked_int64)
+{
+    SKIP_TEST_FOR("GPU", "${BACKEND_NAME}");
+    size_t m = 70;
+    size_t k = 150;
+    size_t n = 300;
+    Shape shape_a{m, k};
+    Shape shape_b{k, n};
+    auto A = make_shared<op::Parameter>(element::i64, shape_a);
+    auto B = make_shared<op::Parameter>(element::i64, shape_b);
+    auto f = make_shared<Function>(make_shared<op::Dot>(A, B), op::ParameterVector{A, B});
+    Shape shape_r{m, n};
+
+    auto manager = runtime::Manager::get("${BACKEND_NAME}");
+    auto external = manager->compile(f);
+    auto backend = manager->allocate_backend();
+    auto cf = backend->make_call_frame(external);
+
+    vector<int64_t> a_data(m * k);
+    for (size_t i = 0; i < a_data.size(); i++)
+    {
+        a_data[i] = int64_t(i % 7) - 3;
+    }
+    vector<int64_t> b_data(k * n);
+    for (size_t i = 0; i < b_data.size(); i++)
+    {
+        b_data[i] = int64_t(i % 11) - 5;
+    }
+    vector<int64_t> expected(m * n, 0);
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+        {
+            for (size_t p = 0; p < k; p++)
+            {
+                expected[i * n + j] += a_data[i * k + p] * b_data[p * n + j];
+            }
+        }
+    }
+
+    // Create some tensors for input/output
+    auto a = backend->make_primary_tensor_view(element::i64, shape_a);
+    copy_data(a, a_data);
+    auto b = backend->make_primary_tensor_view(element::i64, shape_b);
+    copy_data(b, b_data);
+    auto result = backend->make_primary_tensor_view(element::i64, shape_r);
+
+    cf->call({a, b}, {result});
+    EXPECT_EQ(expected, read_vector<int64_t>(result));
+}
+
 TEST(${BACKEND_NAME}, greater)
 {
     Shape shape{2, 2, 2};
@@ -5411,6 +5463,59 @@ TEST(${BACKEND_NAME}, abc_tbb)
     }
 }
 
+TEST(${BACKEND_NAME}, abc_dex)
+{
+    ONLY_ENABLE_TEST_FOR("CPU", "${BACKEND_NAME}");
+
+    // Force direct execution in the CPU backend
+    // This has no effect on other backends
+    bool use_dex = (getenv("NGRAPH_DEX") != nullptr);
+    if (!use_dex)
+    {
+        setenv("NGRAPH_DEX", "1", 1);
+    }
+
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(NodeVector{(A + B) * C, make_shared<op::Dot>(A, B)},
+                                   op::ParameterVector{A, B, C});
+
+    auto manager = runtime::Manager::get("${BACKEND_NAME}");
+    auto external = manager->compile(f);
+    auto backend = manager->allocate_backend();
+    auto cf = backend->make_call_frame(external);
+
+    // Create some tensors for input/output
+    shared_ptr<runtime::TensorView> a = backend->make_primary_tensor_view(element::f32, shape);
+    shared_ptr<runtime::TensorView> b = backend->make_primary_tensor_view(element::f32, shape);
+    shared_ptr<runtime::TensorView> c = backend->make_primary_tensor_view(element::f32, shape);
+    shared_ptr<runtime::TensorView> result = backend->make_primary_tensor_view(element::f32, shape);
+    shared_ptr<runtime::TensorView> dot = backend->make_primary_tensor_view(element::f32, shape);
+
+    copy_data(a, test::NDArray<float, 2>({{1, 2}, {3, 4}}).get_vector());
+    copy_data(b, test::NDArray<float, 2>({{5, 6}, {7, 8}}).get_vector());
+    copy_data(c, test::NDArray<float, 2>({{9, 10}, {11, 12}}).get_vector());
+
+    cf->call({a, b, c}, {result, dot});
+    EXPECT_EQ(read_vector<float>(result),
+              (test::NDArray<float, 2>({{54, 80}, {110, 144}})).get_vector());
+    EXPECT_EQ(read_vector<float>(dot),
+              (test::NDArray<float, 2>({{19, 22}, {43, 50}})).get_vector());
+
+    cf->call({a, c, b}, {result, dot});
+    EXPECT_EQ(read_vector<float>(result),
+              (test::NDArray<float, 2>({{50, 72}, {98, 128}})).get_vector());
+    EXPECT_EQ(read_vector<float>(dot),
+              (test::NDArray<float, 2>({{31, 34}, {71, 78}})).get_vector());
+
+    if (!use_dex)
+    {
+        unsetenv("NGRAPH_DEX");
+    }
+}
+
 //
 // The unit tests for ReduceWindow follow exactly what we test for MaxPool---but they use ReduceWindow to do it.
 //
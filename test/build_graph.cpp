@@ -21,6 +21,7 @@
 #include "ngraph/serializer.hpp"
 #include "util/test_tools.hpp"
 
+#include <algorithm>
 #include <memory>
 using namespace std;
 using namespace ngraph;
@@ -132,3 +133,30 @@ TEST(build_graph, function_undeclared_parameters)
         FAIL() << "Function construction failed for unexpected reason";
     }
 }
+
+TEST(build_graph, ordered_ops_follow_rewrites)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto add = make_shared<op::Add>(A, B);
+    auto neg = make_shared<op::Negative>(add);
+    auto f = make_shared<Function>(neg, op::ParameterVector{A, B});
+
+    auto ops = f->get_ordered_ops();
+    EXPECT_EQ(5, ops.size());
+    EXPECT_EQ(ops, f->get_ordered_ops());
+
+    // Rewiring any input makes the function sort its ops again
+    auto mul = make_shared<op::Multiply>(A, B);
+    auto abs = make_shared<op::Abs>(mul);
+    f->replace_node(add, abs);
+    ops = f->get_ordered_ops();
+    EXPECT_EQ(6, ops.size());
+    EXPECT_EQ(ops.end(), find(ops.begin(), ops.end(), add));
+    auto mul_position = find(ops.begin(), ops.end(), mul);
+    auto abs_position = find(ops.begin(), ops.end(), abs);
+    auto neg_position = find(ops.begin(), ops.end(), neg);
+    ASSERT_NE(ops.end(), mul_position);
+    EXPECT_LT(distance(ops.begin(), mul_position), distance(ops.begin(), abs_position));
+    EXPECT_LT(distance(ops.begin(), abs_position), distance(ops.begin(), neg_position));
+}
@@ -14,14 +14,26 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <cstdlib>
+#include <fstream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
 
 #include "ngraph/codegen/compiler.hpp"
 #include "ngraph/codegen/execution_engine.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/cpu/cpu_exported_function.hpp"
+#include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_hw_counters.hpp"
+#include "ngraph/runtime/cpu/cpu_trace_buffer.hpp"
+#include "nlohmann/json.hpp"
+#include "util/all_close.hpp"
+#include "util/test_tools.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -42,6 +54,80 @@ TEST(codegen, eigen_gpl_test)
     ASSERT_NE(nullptr, module);
 }
 
+TEST(codegen, compile_multiple_modules)
+{
+    vector<string> sources;
+    for (int i = 0; i < 4; i++)
+    {
+        sources.push_back("extern \"C\" int test" + to_string(i) + "() { return " +
+                          to_string(i) + "; }");
+    }
+    sources.push_back("syntax error");
+
+    codegen::Compiler compiler;
+    auto modules = compiler.compile(sources, 3);
+    ASSERT_EQ(sources.size(), modules.size());
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_NE(nullptr, modules[i]);
+    }
+    EXPECT_EQ(nullptr, modules[4]);
+}
+
+TEST(codegen, object_cache_key)
+{
+    string source = "extern \"C\" int cached_square(int x) { return x * x; }";
+    string dir = file_util::make_temp_directory();
+    string header_dir = file_util::path_join(dir, "include");
+    file_util::make_directory(header_dir);
+    string header = file_util::path_join(header_dir, "cached.hpp");
+    {
+        ofstream out(header);
+        out << "#define CACHED_VALUE 1\n";
+    }
+
+    codegen::Compiler compiler;
+    compiler.add_header_search_path(header_dir);
+    string fingerprint = compiler.get_header_fingerprint();
+    EXPECT_EQ(fingerprint, compiler.get_header_fingerprint());
+    {
+        codegen::ExecutionEngine execution_engine;
+        execution_engine.enable_object_cache(dir, fingerprint);
+        EXPECT_FALSE(execution_engine.add_cached_module(source));
+        auto module = compiler.compile(source);
+        ASSERT_NE(nullptr, module);
+        ASSERT_TRUE(execution_engine.add_module(module, source));
+        execution_engine.finalize();
+        auto func = execution_engine.find_function<int(int)>("cached_square");
+        ASSERT_NE(nullptr, func);
+        EXPECT_EQ(49, func(7));
+    }
+    {
+        codegen::ExecutionEngine execution_engine;
+        execution_engine.enable_object_cache(dir, fingerprint);
+        ASSERT_TRUE(execution_engine.add_cached_module(source));
+        execution_engine.finalize();
+        auto func = execution_engine.find_function<int(int)>("cached_square");
+        ASSERT_NE(nullptr, func);
+        EXPECT_EQ(49, func(7));
+    }
+
+    // Changing a header the source can include changes the fingerprint, and so the key
+    {
+        ofstream out(header);
+        out << "#define CACHED_VALUE 2\n";
+    }
+    string changed_fingerprint = compiler.get_header_fingerprint();
+    EXPECT_NE(fingerprint, changed_fingerprint);
+    {
+        codegen::ExecutionEngine execution_engine;
+        execution_engine.enable_object_cache(dir, changed_fingerprint);
+        EXPECT_FALSE(execution_engine.add_cached_module(source));
+    }
+
+    file_util::remove_directory(dir);
+}
+
 TEST(DISABLED_codegen, simple_return)
 {
     constexpr auto source = R"(extern "C" int test() { return 2+5; })";
@@ -111,3 +197,580 @@ TEST(DISABLED_codegen, include)
     int result = func(20, 2);
     EXPECT_EQ(400, result);
 }
+
+TEST(codegen, cpu_export_function)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = op::Constant::create(element::f32, shape, {1, 2, 3, 4});
+    auto f = make_shared<Function>((A + B) * C, op::ParameterVector{A, B});
+
+    string dir = file_util::make_temp_directory();
+    auto external = make_shared<runtime::cpu::CPU_ExternalFunction>(f);
+    external->export_function(dir);
+
+    auto exported = make_shared<runtime::cpu::CPU_ExportedFunction>(dir, f->get_name());
+    auto cf = exported->make_call_frame();
+
+    auto backend = runtime::Manager::get("CPU")->allocate_backend();
+    auto a = backend->make_primary_tensor_view(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4});
+    auto b = backend->make_primary_tensor_view(element::f32, shape);
+    copy_data(b, vector<float>{5, 6, 7, 8});
+    auto result = backend->make_primary_tensor_view(element::f32, shape);
+
+    cf->call({a, b}, {result});
+    EXPECT_EQ((vector<float>{6, 16, 30, 48}), read_vector<float>(result));
+
+    file_util::remove_directory(dir);
+}
+
+TEST(codegen, cpu_export_function_checks)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(-A, op::ParameterVector{A});
+
+    string dir = file_util::make_temp_directory();
+    auto external = make_shared<runtime::cpu::CPU_ExternalFunction>(f);
+    external->export_function(dir);
+
+    // Without NGRAPH_CPU_EXPORT_ISA the library runs on any x86-64 CPU
+    string manifest_path = file_util::path_join(dir, f->get_name() + ".json");
+    nlohmann::json manifest = nlohmann::json::parse(file_util::read_file_to_string(manifest_path));
+    if (getenv("NGRAPH_CPU_EXPORT_ISA") == nullptr)
+    {
+        EXPECT_EQ(manifest.at("isa").get<string>(), "x86-64");
+        EXPECT_TRUE(manifest.at("cpu_features").empty());
+    }
+
+    auto exported = make_shared<runtime::cpu::CPU_ExportedFunction>(dir, f->get_name());
+    auto cf = exported->make_call_frame();
+    auto backend = runtime::Manager::get("CPU")->allocate_backend();
+    auto a = backend->make_primary_tensor_view(element::f32, shape);
+    auto result = backend->make_primary_tensor_view(element::f32, shape);
+    auto wrong_type = backend->make_primary_tensor_view(element::i32, shape);
+    auto wrong_shape = backend->make_primary_tensor_view(element::f32, Shape{4});
+    EXPECT_NO_THROW(cf->call({a}, {result}));
+    EXPECT_THROW(cf->call({wrong_type}, {result}), ngraph_error);
+    EXPECT_THROW(cf->call({a}, {wrong_type}), ngraph_error);
+    EXPECT_THROW(cf->call({wrong_shape}, {result}), ngraph_error);
+
+    // A library needing a feature this CPU does not have is not loaded
+    manifest["cpu_features"].push_back("no-such-feature");
+    {
+        ofstream out(manifest_path);
+        out << manifest.dump(4);
+    }
+    EXPECT_THROW(make_shared<runtime::cpu::CPU_ExportedFunction>(dir, f->get_name()),
+                 ngraph_error);
+
+    file_util::remove_directory(dir);
+}
+
+TEST(codegen, cpu_export_function_timeline)
+{
+    bool tracing = (getenv("NGRAPH_CPU_TRACING") != nullptr);
+    if (!tracing)
+    {
+        setenv("NGRAPH_CPU_TRACING", "1", 1);
+    }
+
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(A + B, op::ParameterVector{A, B});
+
+    string dir = file_util::make_temp_directory();
+    auto external = make_shared<runtime::cpu::CPU_ExternalFunction>(f);
+    external->export_function(dir);
+
+    // The op attributes travel in the manifest, so the loaded function writes timelines
+    auto exported = make_shared<runtime::cpu::CPU_ExportedFunction>(dir, f->get_name());
+    ASSERT_NE(exported->get_trace_buffer(), nullptr);
+    auto cf = exported->make_call_frame();
+
+    auto backend = runtime::Manager::get("CPU")->allocate_backend();
+    auto a = backend->make_primary_tensor_view(element::f32, shape);
+    auto b = backend->make_primary_tensor_view(element::f32, shape);
+    auto result = backend->make_primary_tensor_view(element::f32, shape);
+    cf->call({a, b}, {result});
+    EXPECT_GT(exported->get_trace_buffer()->get_record_count(), 0);
+
+    string timeline = file_util::path_join(dir, "exported.timeline.json");
+    exported->write_timeline(timeline);
+    EXPECT_NE(file_util::read_file_to_string(timeline).find("\"Add\""), string::npos);
+
+    // Destroying a traced function writes its timeline to NGRAPH_CPU_TRACE_DIR
+    const char* env_trace_dir = getenv("NGRAPH_CPU_TRACE_DIR");
+    string trace_dir = env_trace_dir ? env_trace_dir : "";
+    setenv("NGRAPH_CPU_TRACE_DIR", dir.c_str(), 1);
+    string destroyed_timeline = file_util::path_join(dir, f->get_name() + ".timeline.json");
+    cf = nullptr;
+    exported = nullptr;
+    EXPECT_TRUE(file_util::exists(destroyed_timeline));
+    file_util::remove_file(destroyed_timeline);
+
+    // Loaded without tracing, the exported code records nothing and writes no timeline
+    unsetenv("NGRAPH_CPU_TRACING");
+    exported = make_shared<runtime::cpu::CPU_ExportedFunction>(dir, f->get_name());
+    EXPECT_EQ(exported->get_trace_buffer(), nullptr);
+    cf = exported->make_call_frame();
+    cf->call({a, b}, {result});
+    cf = nullptr;
+    exported = nullptr;
+    EXPECT_FALSE(file_util::exists(destroyed_timeline));
+
+    file_util::remove_directory(dir);
+    if (env_trace_dir)
+    {
+        setenv("NGRAPH_CPU_TRACE_DIR", trace_dir.c_str(), 1);
+    }
+    else
+    {
+        unsetenv("NGRAPH_CPU_TRACE_DIR");
+    }
+    if (tracing)
+    {
+        setenv("NGRAPH_CPU_TRACING", "1", 1);
+    }
+}
+
+TEST(codegen, cpu_split_modules)
+{
+    // Enough ops that a small NGRAPH_CPU_MIN_MODULE_SIZE splits the code into several modules
+    Shape shape{4, 4};
+    auto make_function = [&]() {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        shared_ptr<Node> sum;
+        for (size_t i = 0; i < 16; i++)
+        {
+            shared_ptr<Node> branch = make_shared<op::Dot>(A, B) * A - B;
+            auto transpose = make_shared<op::Reshape>(branch, AxisVector{1, 0}, shape);
+            branch = make_shared<op::Tanh>(branch) + transpose;
+            sum = sum ? sum + branch : branch;
+        }
+        return make_shared<Function>(sum, op::ParameterVector{A, B});
+    };
+
+    auto run = [&](const char* compile_threads, const char* min_module_size) {
+        const char* env_threads = getenv("NGRAPH_CPU_COMPILE_THREADS");
+        const char* env_size = getenv("NGRAPH_CPU_MIN_MODULE_SIZE");
+        string saved_threads = env_threads ? env_threads : "";
+        string saved_size = env_size ? env_size : "";
+        setenv("NGRAPH_CPU_COMPILE_THREADS", compile_threads, 1);
+        setenv("NGRAPH_CPU_MIN_MODULE_SIZE", min_module_size, 1);
+
+        auto external = make_shared<runtime::cpu::CPU_ExternalFunction>(make_function());
+        auto cf = external->make_call_frame();
+        auto backend = runtime::Manager::get("CPU")->allocate_backend();
+        auto a = backend->make_primary_tensor_view(element::f32, shape);
+        auto b = backend->make_primary_tensor_view(element::f32, shape);
+        auto result = backend->make_primary_tensor_view(element::f32, shape);
+        vector<float> a_data(shape_size(shape));
+        vector<float> b_data(shape_size(shape));
+        for (size_t i = 0; i < a_data.size(); i++)
+        {
+            a_data[i] = static_cast<float>(i % 5) * 0.25f - 0.5f;
+            b_data[i] = static_cast<float>(i % 3) * 0.5f - 0.25f;
+        }
+        copy_data(a, a_data);
+        copy_data(b, b_data);
+        cf->call({a, b}, {result});
+
+        if (env_threads)
+        {
+            setenv("NGRAPH_CPU_COMPILE_THREADS", saved_threads.c_str(), 1);
+        }
+        else
+        {
+            unsetenv("NGRAPH_CPU_COMPILE_THREADS");
+        }
+        if (env_size)
+        {
+            setenv("NGRAPH_CPU_MIN_MODULE_SIZE", saved_size.c_str(), 1);
+        }
+        else
+        {
+            unsetenv("NGRAPH_CPU_MIN_MODULE_SIZE");
+        }
+        return make_pair(external->get_module_count(), read_vector<float>(result));
+    };
+
+    auto single = run("1", "1024");
+    auto split = run("4", "1024");
+    EXPECT_EQ(single.first, 1);
+    EXPECT_GT(split.first, 1);
+    EXPECT_EQ(single.second, split.second);
+}
+
+TEST(codegen, cpu_concurrent_call_frames)
+{
+    // Convolution and Relu use MKLDNN primitives whose memory handles are set on every call
+    Shape shape_a{2, 1, 5, 5};
+    Shape shape_w{2, 1, 2, 2};
+    auto make_function = [&]() {
+        auto A = make_shared<op::Parameter>(element::f32, shape_a);
+        auto W = make_shared<op::Parameter>(element::f32, shape_w);
+        return make_shared<Function>(make_shared<op::Relu>(make_shared<op::Convolution>(A, W)),
+                                     op::ParameterVector{A, W});
+    };
+    auto f = make_function();
+    Shape shape_r = f->get_output_shape(0);
+
+    auto external = make_shared<runtime::cpu::CPU_ExternalFunction>(f);
+    auto backend = runtime::Manager::get("CPU")->allocate_backend();
+    auto interpreter = runtime::Manager::get("INTERPRETER");
+    auto ref_backend = interpreter->allocate_backend();
+    auto ref_cf = ref_backend->make_call_frame(interpreter->compile(make_function()));
+
+    const size_t thread_count = 4;
+    vector<vector<float>> inputs;
+    vector<vector<float>> expected;
+    vector<float> weights{1, -1, 0.5f, 2, -2, 1, 1, 0.25f};
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        vector<float> input(shape_size(shape_a));
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            input[i] = static_cast<float>((i * (t + 3)) % 11) - 5.0f;
+        }
+        auto a = ref_backend->make_primary_tensor_view(element::f32, shape_a);
+        auto w = ref_backend->make_primary_tensor_view(element::f32, shape_w);
+        auto r = ref_backend->make_primary_tensor_view(element::f32, shape_r);
+        copy_data(a, input);
+        copy_data(w, weights);
+        ref_cf->call({a, w}, {r});
+        inputs.push_back(input);
+        expected.push_back(read_vector<float>(r));
+    }
+
+    vector<shared_ptr<runtime::CallFrame>> call_frames;
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        call_frames.push_back(external->make_call_frame());
+    }
+
+    vector<int> mismatches(thread_count, 0);
+    vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back([&, t]() {
+            auto a = backend->make_primary_tensor_view(element::f32, shape_a);
+            auto w = backend->make_primary_tensor_view(element::f32, shape_w);
+            auto r = backend->make_primary_tensor_view(element::f32, shape_r);
+            copy_data(a, inputs[t]);
+            copy_data(w, weights);
+            for (size_t i = 0; i < 50; i++)
+            {
+                call_frames[t]->call({a, w}, {r});
+                if (!test::all_close(expected[t], read_vector<float>(r)))
+                {
+                    mismatches[t]++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(vector<int>(thread_count, 0), mismatches);
+}
+
+TEST(codegen, cpu_tbb_flow_graph_repeated_calls)
+{
+    // The flow graph is built once with the call frame, so every call after the first
+    // re-triggers the same graph with new inputs
+    bool use_tbb = (getenv("NGRAPH_CPU_USE_TBB") != nullptr);
+    if (!use_tbb)
+    {
+        setenv("NGRAPH_CPU_USE_TBB", "1", 1);
+    }
+
+    // Two independent branches joined at the end
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>((A + B) * C + (A - C) * B, op::ParameterVector{A, B, C});
+
+    auto external = make_shared<runtime::cpu::CPU_ExternalFunction>(f);
+    auto cf = external->make_call_frame();
+
+    auto backend = runtime::Manager::get("CPU")->allocate_backend();
+    auto a = backend->make_primary_tensor_view(element::f32, shape);
+    auto b = backend->make_primary_tensor_view(element::f32, shape);
+    auto c = backend->make_primary_tensor_view(element::f32, shape);
+    auto result = backend->make_primary_tensor_view(element::f32, shape);
+
+    for (size_t call = 0; call < 5; call++)
+    {
+        vector<float> a_data(shape_size(shape));
+        vector<float> b_data(shape_size(shape));
+        vector<float> c_data(shape_size(shape));
+        vector<float> expected(shape_size(shape));
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            a_data[i] = static_cast<float>(call + i);
+            b_data[i] = static_cast<float>(2 * call) - static_cast<float>(i);
+            c_data[i] = static_cast<float>(i + 1);
+            expected[i] = (a_data[i] + b_data[i]) * c_data[i] + (a_data[i] - c_data[i]) * b_data[i];
+        }
+        copy_data(a, a_data);
+        copy_data(b, b_data);
+        copy_data(c, c_data);
+
+        cf->call({a, b, c}, {result});
+        EXPECT_EQ(expected, read_vector<float>(result)) << "call " << call;
+    }
+
+    if (!use_tbb)
+    {
+        unsetenv("NGRAPH_CPU_USE_TBB");
+    }
+}
+
+TEST(codegen, cpu_tbb_flow_graph_after_error)
+{
+    // An op that throws cancels the call frame's flow graph, which must still run later calls
+    bool use_tbb = (getenv("NGRAPH_CPU_USE_TBB") != nullptr);
+    bool nan_check = (getenv("NGRAPH_CPU_NAN_CHECK") != nullptr);
+    setenv("NGRAPH_CPU_USE_TBB", "1", 1);
+    setenv("NGRAPH_CPU_NAN_CHECK", "1", 1);
+
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>((A + B) * C + (A - C) * B, op::ParameterVector{A, B, C});
+
+    auto external = make_shared<runtime::cpu::CPU_ExternalFunction>(f);
+    auto cf = external->make_call_frame();
+
+    if (!use_tbb)
+    {
+        unsetenv("NGRAPH_CPU_USE_TBB");
+    }
+    if (!nan_check)
+    {
+        unsetenv("NGRAPH_CPU_NAN_CHECK");
+    }
+
+    auto backend = runtime::Manager::get("CPU")->allocate_backend();
+    auto a = backend->make_primary_tensor_view(element::f32, shape);
+    auto b = backend->make_primary_tensor_view(element::f32, shape);
+    auto c = backend->make_primary_tensor_view(element::f32, shape);
+    auto result = backend->make_primary_tensor_view(element::f32, shape);
+    copy_data(b, vector<float>{5, 6, 7, 8});
+    copy_data(c, vector<float>{1, 2, 3, 4});
+
+    copy_data(a, vector<float>{1, NAN, 3, 4});
+    EXPECT_ANY_THROW(cf->call({a, b, c}, {result}));
+
+    for (size_t call = 0; call < 2; call++)
+    {
+        copy_data(a, vector<float>{1, 2, 3, 4});
+        cf->call({a, b, c}, {result});
+        EXPECT_EQ((vector<float>{6, 16, 30, 48}), read_vector<float>(result)) << "call " << call;
+    }
+}
+
+TEST(codegen, cpu_tbb_no_in_place_ops)
+{
+    // The flow graph only orders ops by data dependencies, so no op may overwrite its inputs
+    auto count_in_place_pairs = [](bool use_tbb) {
+        bool env_use_tbb = (getenv("NGRAPH_CPU_USE_TBB") != nullptr);
+        if (use_tbb)
+        {
+            setenv("NGRAPH_CPU_USE_TBB", "1", 1);
+        }
+        else
+        {
+            unsetenv("NGRAPH_CPU_USE_TBB");
+        }
+
+        Shape shape{2, 2};
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        auto C = make_shared<op::Parameter>(element::f32, shape);
+        auto f = make_shared<Function>(make_shared<op::Negative>(A * B) * C,
+                                       op::ParameterVector{A, B, C});
+        auto external = make_shared<runtime::cpu::CPU_ExternalFunction>(f, false);
+        external->make_call_frame();
+
+        size_t pairs = 0;
+        for (shared_ptr<Node> node : f->get_ordered_ops())
+        {
+            auto annotated = dynamic_pointer_cast<op::Op>(node);
+            if (annotated && annotated->get_op_annotations())
+            {
+                pairs += annotated->get_op_annotations()->get_in_place_oi_pairs().size();
+            }
+        }
+
+        if (env_use_tbb)
+        {
+            setenv("NGRAPH_CPU_USE_TBB", "1", 1);
+        }
+        else
+        {
+            unsetenv("NGRAPH_CPU_USE_TBB");
+        }
+        return pairs;
+    };
+
+    EXPECT_GT(count_in_place_pairs(false), 0);
+    EXPECT_EQ(count_in_place_pairs(true), 0);
+}
+
+TEST(codegen, cpu_update_constant)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto W = op::Constant::create(element::f32, shape, {1, 2, 3, 4});
+    W->set_name("weights");
+    auto f = make_shared<Function>(A * W, op::ParameterVector{A});
+
+    auto external = make_shared<runtime::cpu::CPU_ExternalFunction>(f);
+    external->set_updatable_constants({"weights"});
+    auto cf = external->make_call_frame();
+
+    auto backend = runtime::Manager::get("CPU")->allocate_backend();
+    auto a = backend->make_primary_tensor_view(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4});
+    auto result = backend->make_primary_tensor_view(element::f32, shape);
+
+    cf->call({a}, {result});
+    EXPECT_EQ((vector<float>{1, 4, 9, 16}), read_vector<float>(result));
+
+    vector<float> weights{2, 2, 2, 2};
+    external->update_constant("weights", weights.data(), weights.size() * sizeof(float));
+    cf->call({a}, {result});
+    EXPECT_EQ((vector<float>{2, 4, 6, 8}), read_vector<float>(result));
+
+    auto w = backend->make_primary_tensor_view(element::f32, shape);
+    copy_data(w, vector<float>{-1, 0, 1, 2});
+    external->bind_constant("weights", w);
+    cf->call({a}, {result});
+    EXPECT_EQ((vector<float>{-1, 0, 3, 8}), read_vector<float>(result));
+
+    // A bound constant follows writes to its tensor
+    copy_data(w, vector<float>{0, 1, 0, 1});
+    cf->call({a}, {result});
+    EXPECT_EQ((vector<float>{0, 2, 0, 4}), read_vector<float>(result));
+
+    EXPECT_THROW(external->update_constant("weights", weights.data(), sizeof(float)),
+                 ngraph_error);
+    EXPECT_THROW(external->update_constant("bias", weights.data(), sizeof(float)),
+                 ngraph_error);
+}
+
+TEST(codegen, cpu_trace_buffer)
+{
+    runtime::cpu::TraceBuffer trace(3);
+    EXPECT_EQ(trace.get_capacity(), 4);
+
+    runtime::cpu::Timestamp start = runtime::cpu::Clock::now();
+    for (size_t i = 0; i < 6; i++)
+    {
+        trace.record(i, start + chrono::microseconds(i), start + chrono::microseconds(i + 1));
+    }
+    EXPECT_EQ(trace.get_record_count(), 6);
+
+    // The two oldest records were overwritten
+    auto records = trace.get_records();
+    ASSERT_EQ(records.size(), 4);
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        EXPECT_EQ(records[i].op, i + 2);
+        EXPECT_EQ(records[i].thread, this_thread::get_id());
+        EXPECT_EQ(records[i].end - records[i].start, chrono::microseconds(1));
+    }
+
+    trace.clear();
+    EXPECT_TRUE(trace.get_records().empty());
+}
+
+TEST(codegen, cpu_trace_buffer_threads)
+{
+    // Each thread keeps its own records, so none is lost or mixed with another thread's
+    const size_t thread_count = 4;
+    const size_t record_count = 1000;
+    runtime::cpu::TraceBuffer trace(record_count);
+    runtime::cpu::Timestamp start = runtime::cpu::Clock::now();
+    vector<thread> threads;
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back([&trace, start, t, record_count]() {
+            for (size_t i = 0; i < record_count; i++)
+            {
+                size_t op = t * record_count + i;
+                trace.record(op,
+                             start + chrono::microseconds(op),
+                             start + chrono::microseconds(op + 1));
+            }
+        });
+    }
+    for (thread& t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(trace.get_record_count(), thread_count * record_count);
+    auto records = trace.get_records();
+    ASSERT_EQ(records.size(), thread_count * record_count);
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        EXPECT_EQ(records[i].op, i);
+        EXPECT_EQ(records[i].start - start, chrono::microseconds(i));
+        EXPECT_EQ(records[i].end - records[i].start, chrono::microseconds(1));
+    }
+}
+
+TEST(codegen, cpu_hardware_counters)
+{
+    runtime::cpu::HardwareCounters counters(2);
+    volatile float sum = 0;
+    counters.start(1);
+    for (size_t i = 0; i < 100000; i++)
+    {
+        sum = sum + 1.0f;
+    }
+    counters.stop(1);
+
+    EXPECT_EQ(counters.get_counts(0).cycles, 0);
+    EXPECT_EQ(counters.get_counts(0).instructions, 0);
+    if (runtime::cpu::HardwareCounters::is_available())
+    {
+        EXPECT_GT(counters.get_counts(1).instructions, 100000);
+    }
+    else
+    {
+        EXPECT_EQ(counters.get_counts(1).instructions, 0);
+    }
+}
+
+TEST(codegen, cpu_hardware_counters_worker_threads)
+{
+    // Threads started while an op is counted, like OpenMP workers, count towards the op
+    runtime::cpu::HardwareCounters counters(1);
+    if (!runtime::cpu::HardwareCounters::is_available())
+    {
+        return;
+    }
+    counters.start(0);
+    thread worker([]() {
+        volatile float sum = 0;
+        for (size_t i = 0; i < 1000000; i++)
+        {
+            sum = sum + 1.0f;
+        }
+    });
+    worker.join();
+    counters.stop(0);
+    EXPECT_GT(counters.get_counts(0).instructions, 1000000);
+}
@@ -0,0 +1,88 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/constant_folding.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "util/test_tools.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+TEST(constant_folding, reshape_broadcast_convert)
+{
+    auto k = op::Constant::create(element::i32, Shape{1, 2}, {1, 2});
+    auto reshape = make_shared<op::Reshape>(k, AxisVector{0, 1}, Shape{2});
+    auto broadcast = make_shared<op::Broadcast>(reshape, Shape{2, 3}, AxisSet{1});
+    auto convert = make_shared<op::Convert>(broadcast, element::f32);
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto f = make_shared<Function>(A * convert, op::ParameterVector{A});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantFolding>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Reshape>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Broadcast>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Convert>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 1);
+
+    auto multiply = f->get_results().at(0)->get_input_op(0);
+    auto folded = dynamic_pointer_cast<op::Constant>(multiply->get_input_op(1));
+    ASSERT_TRUE(folded);
+    EXPECT_EQ(folded->get_element_type(), element::f32);
+    EXPECT_EQ(folded->get_shape(), (Shape{2, 3}));
+    EXPECT_EQ(folded->get_vector<float>(), (vector<float>{1, 1, 1, 2, 2, 2}));
+}
+
+TEST(constant_folding, scale_computation)
+{
+    auto a = op::Constant::create(element::f32, Shape{3}, {1, 4, 9});
+    auto b = op::Constant::create(element::f32, Shape{3}, {2, 2, 2});
+    auto scale = make_shared<op::Sqrt>(a) / b;
+    auto sum = make_shared<op::Sum>(scale, AxisSet{0});
+    auto f = make_shared<Function>(NodeVector{scale, sum}, op::ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantFolding>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 2);
+    auto folded_scale = dynamic_pointer_cast<op::Constant>(f->get_results().at(0)->get_input_op(0));
+    auto folded_sum = dynamic_pointer_cast<op::Constant>(f->get_results().at(1)->get_input_op(0));
+    ASSERT_TRUE(folded_scale);
+    ASSERT_TRUE(folded_sum);
+    EXPECT_EQ(folded_scale->get_vector<float>(), (vector<float>{0.5f, 1.0f, 1.5f}));
+    EXPECT_EQ(folded_sum->get_vector<float>(), (vector<float>{3.0f}));
+}
+
+TEST(constant_folding, parameters_are_not_folded)
+{
+    auto k = op::Constant::create(element::f32, Shape{2}, {1, 2});
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto f = make_shared<Function>(make_shared<op::Negative>(A + k), op::ParameterVector{A});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantFolding>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Add>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 1);
+}
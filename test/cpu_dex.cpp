@@ -0,0 +1,311 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "util/all_close.hpp"
+#include "util/random.hpp"
+#include "util/test_tools.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Runs f on the named backend. Inputs are filled the same way on every backend:
+// f32 with seeded uniform values, i32 with 0, 1, 2, ... modulo 3 and booleans alternating.
+static vector<shared_ptr<runtime::TensorView>> execute(const shared_ptr<Function>& f,
+                                                       const string& backend_name)
+{
+    auto manager = runtime::Manager::get(backend_name);
+    auto external = manager->compile(f);
+    auto backend = manager->allocate_backend();
+    auto cf = backend->make_call_frame(external);
+    if (backend_name == "CPU")
+    {
+        auto cpu_external = static_pointer_cast<runtime::cpu::CPU_ExternalFunction>(external);
+        EXPECT_TRUE(cpu_external->is_direct_execution());
+    }
+
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    vector<shared_ptr<runtime::TensorView>> args;
+    for (shared_ptr<op::Parameter> param : f->get_parameters())
+    {
+        const element::Type& type = param->get_element_type();
+        auto arg = backend->make_primary_tensor_view(type, param->get_shape());
+        size_t count = shape_size(param->get_shape());
+        if (type == element::f32)
+        {
+            rng.initialize(arg);
+        }
+        else if (type == element::i32)
+        {
+            vector<int> data(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                data[i] = static_cast<int>(i % 3);
+            }
+            copy_data(arg, data);
+        }
+        else if (type == element::boolean)
+        {
+            vector<char> data(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                data[i] = static_cast<char>(i % 2);
+            }
+            copy_data(arg, data);
+        }
+        else
+        {
+            throw ngraph_error("Unsupported parameter type in DEX test: " + type.c_type_string());
+        }
+        args.push_back(arg);
+    }
+
+    vector<shared_ptr<runtime::TensorView>> results;
+    for (size_t i = 0; i < f->get_output_size(); i++)
+    {
+        results.push_back(backend->make_primary_tensor_view(f->get_output_element_type(i),
+                                                            f->get_output_shape(i)));
+    }
+    cf->call(args, results);
+    return results;
+}
+
+// Compiles the function made by make_function for the CPU backend in direct execution
+// mode and for the interpreter, and checks that both give the same results. Returns the
+// function compiled for the CPU backend.
+static shared_ptr<Function>
+    compare_with_interpreter(const function<shared_ptr<Function>()>& make_function)
+{
+    bool use_dex = (getenv("NGRAPH_DEX") != nullptr);
+    if (!use_dex)
+    {
+        setenv("NGRAPH_DEX", "1", 1);
+    }
+    auto dex_function = make_function();
+    auto dex_results = execute(dex_function, "CPU");
+    if (!use_dex)
+    {
+        unsetenv("NGRAPH_DEX");
+    }
+    auto int_results = execute(make_function(), "INTERPRETER");
+
+    EXPECT_EQ(dex_results.size(), int_results.size());
+    for (size_t i = 0; i < dex_results.size(); i++)
+    {
+        const element::Type& type = int_results[i]->get_tensor_view_layout()->get_element_type();
+        if (type == element::f32)
+        {
+            EXPECT_TRUE(test::all_close(
+                read_vector<float>(dex_results[i]), read_vector<float>(int_results[i])))
+                << "result " << i;
+        }
+        else if (type == element::i32)
+        {
+            EXPECT_EQ(read_vector<int>(dex_results[i]), read_vector<int>(int_results[i]))
+                << "result " << i;
+        }
+        else
+        {
+            EXPECT_EQ(read_vector<char>(dex_results[i]), read_vector<char>(int_results[i]))
+                << "result " << i;
+        }
+    }
+    return dex_function;
+}
+
+TEST(cpu_dex, elementwise)
+{
+    compare_with_interpreter([]() {
+        Shape shape{3, 4};
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        auto unary = make_shared<op::Tanh>(make_shared<op::Abs>(A)) + make_shared<op::Exp>(B);
+        auto binary = make_shared<op::Maximum>(A, B) * make_shared<op::Minimum>(A, B) - A / unary;
+        auto relu = make_shared<op::Relu>(make_shared<op::Negative>(binary));
+        return make_shared<Function>(
+            NodeVector{relu, make_shared<op::Greater>(A, B), make_shared<op::Equal>(A, A)},
+            op::ParameterVector{A, B});
+    });
+}
+
+TEST(cpu_dex, reshape)
+{
+    compare_with_interpreter([]() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3, 4});
+        auto transpose = make_shared<op::Reshape>(A, AxisVector{2, 0, 1}, Shape{4, 2, 3});
+        auto flatten = make_shared<op::Reshape>(A, AxisVector{0, 1, 2}, Shape{6, 4});
+        return make_shared<Function>(NodeVector{transpose, flatten}, op::ParameterVector{A});
+    });
+}
+
+TEST(cpu_dex, broadcast)
+{
+    compare_with_interpreter([]() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{3});
+        auto B = make_shared<op::Parameter>(element::f32, Shape{});
+        auto rows = make_shared<op::Broadcast>(A, Shape{2, 3, 4}, AxisSet{0, 2});
+        auto scalar = make_shared<op::Broadcast>(B, Shape{2, 3}, AxisSet{0, 1});
+        return make_shared<Function>(NodeVector{rows, scalar}, op::ParameterVector{A, B});
+    });
+}
+
+TEST(cpu_dex, slice)
+{
+    compare_with_interpreter([]() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{4, 6});
+        auto block = make_shared<op::Slice>(A, Coordinate{1, 2}, Coordinate{3, 5});
+        auto strided =
+            make_shared<op::Slice>(A, Coordinate{0, 1}, Coordinate{4, 6}, Strides{2, 3});
+        return make_shared<Function>(NodeVector{block, strided}, op::ParameterVector{A});
+    });
+}
+
+TEST(cpu_dex, concat)
+{
+    compare_with_interpreter([]() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 2});
+        auto B = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+        auto C = make_shared<op::Parameter>(element::f32, Shape{2, 1});
+        auto concat = make_shared<op::Concat>(NodeVector{A, B, C}, 1);
+        return make_shared<Function>(concat, op::ParameterVector{A, B, C});
+    });
+}
+
+TEST(cpu_dex, reductions)
+{
+    compare_with_interpreter([]() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3, 4});
+        return make_shared<Function>(NodeVector{make_shared<op::Sum>(A, AxisSet{1}),
+                                                make_shared<op::Product>(A, AxisSet{0, 2}),
+                                                make_shared<op::Max>(A, AxisSet{2}),
+                                                make_shared<op::Min>(A, AxisSet{0, 1, 2})},
+                                     op::ParameterVector{A});
+    });
+}
+
+TEST(cpu_dex, dot_and_reverse)
+{
+    compare_with_interpreter([]() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{3, 4});
+        auto B = make_shared<op::Parameter>(element::f32, Shape{4, 5});
+        auto dot = make_shared<op::Dot>(A, B);
+        auto reverse = make_shared<op::Reverse>(dot, AxisSet{1});
+        return make_shared<Function>(reverse, op::ParameterVector{A, B});
+    });
+}
+
+TEST(cpu_dex, convolution)
+{
+    compare_with_interpreter([]() {
+        auto data = make_shared<op::Parameter>(element::f32, Shape{2, 3, 7, 7});
+        auto filters = make_shared<op::Parameter>(element::f32, Shape{4, 3, 3, 3});
+        auto conv = make_shared<op::Convolution>(data,
+                                                 filters,
+                                                 Strides{2, 1},
+                                                 Strides{1, 2},
+                                                 CoordinateDiff{1, 0},
+                                                 CoordinateDiff{0, 2},
+                                                 Strides{1, 1});
+        return make_shared<Function>(conv, op::ParameterVector{data, filters});
+    });
+}
+
+TEST(cpu_dex, pooling)
+{
+    compare_with_interpreter([]() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3, 6, 5});
+        auto max_pool = make_shared<op::MaxPool>(
+            A, Shape{3, 2}, Strides{2, 1}, Shape{1, 0}, Shape{1, 1});
+        auto avg_pool = make_shared<op::AvgPool>(
+            A, Shape{2, 3}, Strides{1, 2}, Shape{0, 1}, Shape{1, 1}, false);
+        return make_shared<Function>(NodeVector{max_pool, avg_pool}, op::ParameterVector{A});
+    });
+}
+
+TEST(cpu_dex, select_and_convert)
+{
+    compare_with_interpreter([]() {
+        Shape shape{2, 5};
+        auto C = make_shared<op::Parameter>(element::boolean, shape);
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        auto select = make_shared<op::Select>(C, A, B);
+        auto to_float = make_shared<op::Convert>(C, element::f32);
+        auto to_int = make_shared<op::Convert>(A * B, element::i32);
+        return make_shared<Function>(NodeVector{select + to_float, to_int},
+                                     op::ParameterVector{C, A, B});
+    });
+}
+
+TEST(cpu_dex, pad)
+{
+    compare_with_interpreter([]() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{3, 2});
+        auto B = make_shared<op::Parameter>(element::f32, Shape{});
+        auto pad = make_shared<op::Pad>(A, B, Shape{1, 0}, Shape{2, 1}, Shape{1, 2});
+        return make_shared<Function>(pad, op::ParameterVector{A, B});
+    });
+}
+
+TEST(cpu_dex, one_hot)
+{
+    compare_with_interpreter([]() {
+        auto A = make_shared<op::Parameter>(element::i32, Shape{2, 4});
+        auto one_hot = make_shared<op::OneHot>(A, Shape{2, 3, 4}, 1);
+        return make_shared<Function>(one_hot, op::ParameterVector{A});
+    });
+}
+
+TEST(cpu_dex, softmax)
+{
+    compare_with_interpreter([]() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3, 4});
+        return make_shared<Function>(NodeVector{make_shared<op::Softmax>(A, AxisSet{2}),
+                                                make_shared<op::Softmax>(A, AxisSet{0, 1})},
+                                     op::ParameterVector{A});
+    });
+}
+
+TEST(cpu_dex, results)
+{
+    // The first result of A + B is computed straight into its output, with no copy,
+    // while the second result of the same value, and those of a parameter and a
+    // constant, are copied
+    auto f = compare_with_interpreter([]() {
+        Shape shape{2, 3};
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        auto K = op::Constant::create(element::f32, shape, {1, 2, 3, 4, 5, 6});
+        auto sum = A + B;
+        return make_shared<Function>(NodeVector{sum, sum * K, sum, A, K},
+                                     op::ParameterVector{A, B});
+    });
+
+    vector<bool> needs_copy;
+    for (shared_ptr<op::Result> result : f->get_results())
+    {
+        needs_copy.push_back(result->needs_copy());
+    }
+    EXPECT_EQ((vector<bool>{false, false, true, true, true}), needs_copy);
+}
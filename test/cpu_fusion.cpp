@@ -25,6 +25,7 @@
 #include "ngraph/graph_util.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/op_cost.hpp"
 #include "ngraph/ops/batch_norm.hpp"
 #include "ngraph/ops/get_output_element.hpp"
 #include "ngraph/ops/parameter.hpp"
@@ -41,9 +42,11 @@
 #include "ngraph/pass/reshape_elimination.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
 #include "ngraph/runtime/cpu/ops/conv_bias.hpp"
+#include "ngraph/runtime/cpu/ops/loop_kernel.hpp"
 #include "ngraph/runtime/cpu/ops/matmul_bias.hpp"
 #include "ngraph/runtime/cpu/ops/sigmoid.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_fusion.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_loop_kernel_fusion.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
 #include "nlohmann/json.hpp"
@@ -960,3 +963,137 @@ TEST(cpu_fusion, sigmoid_bprop_n1c1h4)
     vector<float> expected{0.196612f, 0.0176627f, 0.196612f, 0.0176627f};
     EXPECT_TRUE(test::all_close(expected, read_vector<float>(result)));
 }
+
+TEST(cpu_fusion, loop_kernel_fusion)
+{
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto tanh = make_shared<op::Tanh>(A * B + C);
+    // The product is also a function output, so it has to stay materialized
+    auto product = B * C;
+    auto f = make_shared<Function>(NodeVector{tanh, product, make_shared<op::Exp>(product)},
+                                   op::ParameterVector{A, B, C});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPULoopKernelFusion>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<runtime::cpu::op::LoopKernel>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Multiply>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Exp>(f), 1);
+    auto kernel = dynamic_pointer_cast<runtime::cpu::op::LoopKernel>(
+        f->get_results().at(0)->get_input_op(0));
+    ASSERT_TRUE(kernel);
+    ASSERT_EQ(kernel->get_operations().size(), 3);
+    ASSERT_EQ(kernel->get_input_size(), 3);
+}
+
+TEST(cpu_fusion, loop_kernel_n2c3)
+{
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto sum = A * B + C;
+    auto gate = make_shared<op::Sigmoid>(sum);
+    auto f = make_shared<Function>(make_shared<op::Tanh>(sum) * gate - C,
+                                   op::ParameterVector{A, B, C});
+
+    auto manager = runtime::Manager::get("CPU");
+    auto external = manager->compile(f);
+    auto backend = manager->allocate_backend();
+    auto cf = backend->make_call_frame(external);
+
+    auto a = backend->make_primary_tensor_view(element::f32, shape);
+    auto b = backend->make_primary_tensor_view(element::f32, shape);
+    auto c = backend->make_primary_tensor_view(element::f32, shape);
+    auto result = backend->make_primary_tensor_view(element::f32, shape);
+
+    vector<float> dataA{-1.0f, 0.5f, 2.0f, 0.0f, 1.5f, -3.0f};
+    vector<float> dataB{2.0f, 1.0f, -0.5f, 4.0f, 0.25f, 1.0f};
+    vector<float> dataC{0.5f, -0.5f, 1.0f, 0.0f, 2.0f, 1.0f};
+    copy_data(a, dataA);
+    copy_data(b, dataB);
+    copy_data(c, dataC);
+
+    cf->call({a, b, c}, {result});
+
+    vector<float> expected;
+    for (size_t i = 0; i < dataA.size(); i++)
+    {
+        float x = dataA[i] * dataB[i] + dataC[i];
+        expected.push_back(tanhf(x) / (1.0f + expf(-x)) - dataC[i]);
+    }
+    EXPECT_TRUE(test::all_close(expected, read_vector<float>(result)));
+}
+
+TEST(cpu_fusion, op_cost_fused_graph)
+{
+    auto total_flops = [](const shared_ptr<Function>& f) {
+        size_t flops = 0;
+        for (shared_ptr<Node> node : f->get_ordered_ops())
+        {
+            flops += get_op_cost(*node).flops;
+        }
+        return flops;
+    };
+
+    // Fusing a matmul with its bias and the elementwise ops after it into a loop kernel
+    // keeps the FLOPs of the graph
+    auto W = make_shared<op::Parameter>(element::f32, Shape{2, 4});
+    auto x = make_shared<op::Parameter>(element::f32, Shape{4, 3});
+    auto b = make_shared<op::Parameter>(element::f32, Shape{3});
+    auto C = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto dot = make_shared<op::Dot>(W, x);
+    auto add = dot + make_shared<op::Broadcast>(b, dot->get_shape(), AxisSet{0});
+    auto f = make_shared<Function>(make_shared<op::Tanh>(add * C + C),
+                                   op::ParameterVector{W, x, b, C});
+    size_t flops = 2 * 2 * 3 * 4 + 4 * 2 * 3;
+    EXPECT_EQ(total_flops(f), flops);
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUFusion>();
+    pass_manager.register_pass<runtime::cpu::pass::CPULoopKernelFusion>();
+    pass_manager.run_passes(f);
+    ASSERT_EQ(count_ops_of_type<op::MatmulBias>(f), 1);
+    ASSERT_EQ(count_ops_of_type<runtime::cpu::op::LoopKernel>(f), 1);
+    EXPECT_EQ(total_flops(f), flops);
+
+    // A convolution with bias costs the convolution plus one add per output element
+    auto data = make_shared<op::Parameter>(element::f32, Shape{1, 2, 5, 5});
+    auto filters = make_shared<op::Parameter>(element::f32, Shape{3, 2, 3, 3});
+    auto bias = make_shared<op::Parameter>(element::f32, Shape{3});
+    auto conv = make_shared<op::Convolution>(data, filters);
+    auto conv_bias = make_shared<op::ConvolutionBias>(conv, bias);
+    EXPECT_EQ(get_op_cost(*conv_bias).flops, get_op_cost(*conv).flops + 3 * 3 * 3);
+
+    auto delta = make_shared<op::Parameter>(element::f32, conv->get_shape());
+    auto backprop =
+        make_shared<op::ConvolutionBiasBackpropFiltersBias>(data,
+                                                            filters->get_shape(),
+                                                            bias->get_shape(),
+                                                            delta,
+                                                            conv->get_window_movement_strides(),
+                                                            conv->get_window_dilation_strides(),
+                                                            conv->get_padding_below(),
+                                                            conv->get_padding_above(),
+                                                            conv->get_data_dilation_strides());
+    auto filters_backprop =
+        make_shared<op::ConvolutionBackpropFilters>(data,
+                                                    filters->get_shape(),
+                                                    delta,
+                                                    conv->get_window_movement_strides(),
+                                                    conv->get_window_dilation_strides(),
+                                                    conv->get_padding_below(),
+                                                    conv->get_padding_above(),
+                                                    conv->get_data_dilation_strides());
+    EXPECT_EQ(get_op_cost(*backprop).flops,
+              get_op_cost(*filters_backprop).flops + 3 * 3 * 3);
+
+    auto sigmoid = make_shared<op::Sigmoid>(C);
+    EXPECT_EQ(get_op_cost(*sigmoid).flops, 3 * 6);
+    auto sigmoid_backprop = make_shared<op::SigmoidBackprop>(C, C);
+    EXPECT_EQ(get_op_cost(*sigmoid_backprop).flops, 6 * 6);
+}
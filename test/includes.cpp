@@ -59,6 +59,7 @@ TEST(DISABLED_include, complete)
                                     "ngraph/ngraph.hpp",
                                     "ngraph/node.hpp",
                                     "ngraph/node_vector.hpp",
+                                    "ngraph/op_cost.hpp",
                                     "ngraph/ops/abs.hpp",
                                     "ngraph/ops/acos.hpp",
                                     "ngraph/ops/add.hpp",
@@ -156,6 +157,7 @@ TEST(DISABLED_include, complete)
                                     "ngraph/runtime/cpu/cpu_eigen_utils.hpp",
                                     "ngraph/runtime/cpu/cpu_emitter.hpp",
                                     "ngraph/runtime/cpu/cpu_external_function.hpp",
+                                    "ngraph/runtime/cpu/cpu_hw_counters.hpp",
                                     "ngraph/runtime/cpu/cpu_kernels.hpp",
                                     "ngraph/runtime/cpu/cpu_kernel_emitters.hpp",
                                     "ngraph/runtime/cpu/cpu_kernel_utils.hpp",
@@ -165,6 +167,7 @@ TEST(DISABLED_include, complete)
                                     "ngraph/runtime/cpu/cpu_runtime_context.hpp",
                                     "ngraph/runtime/cpu/cpu_tensor_view.hpp",
                                     "ngraph/runtime/cpu/cpu_tensor_view_wrapper.hpp",
+                                    "ngraph/runtime/cpu/cpu_trace_buffer.hpp",
                                     "ngraph/runtime/cpu/cpu_tracing.hpp",
                                     "ngraph/runtime/cpu/mkldnn_emitter.hpp",
                                     "ngraph/runtime/cpu/mkldnn_invoke.hpp",
@@ -191,10 +194,13 @@ TEST(DISABLED_include, complete)
                                     // "ngraph/runtime/gpu/gpu_util.hpp",
                                     "ngraph/runtime/host_tensor_view.hpp",
                                     "ngraph/runtime/interpreter/int_backend.hpp",
+                                    "ngraph/runtime/interpreter/int_builder.hpp",
                                     "ngraph/runtime/interpreter/int_call_frame.hpp",
                                     "ngraph/runtime/interpreter/int_external_function.hpp",
                                     "ngraph/runtime/interpreter/int_kernels.hpp",
                                     "ngraph/runtime/interpreter/int_manager.hpp",
+                                    "ngraph/runtime/interpreter/int_plan.hpp",
+                                    "ngraph/runtime/interpreter/int_scheduler.hpp",
                                     "ngraph/runtime/kernel/abs.hpp",
                                     "ngraph/runtime/kernel/acos.hpp",
                                     "ngraph/runtime/kernel/add.hpp",
@@ -255,6 +261,7 @@ TEST(DISABLED_include, complete)
                                     "ngraph/runtime/tensor_view.hpp",
                                     "ngraph/serializer.hpp",
                                     "ngraph/shape.hpp",
+                                    "ngraph/strided_walk.hpp",
                                     "ngraph/strides.hpp",
                                     "ngraph/types/element_type.hpp",
                                     "ngraph/types/type.hpp",
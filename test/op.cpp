@@ -17,6 +17,7 @@
 #include "gtest/gtest.h"
 
 #include "ngraph/ngraph.hpp"
+#include "ngraph/op_cost.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -36,3 +37,38 @@ TEST(op, is_parameter)
     ASSERT_NE(nullptr, t0);
     EXPECT_FALSE(t0->is_parameter());
 }
+
+TEST(op, cost_dot)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{3, 4});
+    auto dot = make_shared<op::Dot>(A, B);
+    OpCost cost = get_op_cost(*dot);
+    EXPECT_EQ(cost.flops, 2 * 2 * 4 * 3);
+    EXPECT_EQ(cost.bytes_read, (6 + 12) * 4);
+    EXPECT_EQ(cost.bytes_written, 8 * 4);
+    EXPECT_EQ(get_op_cost(*A).bytes(), 0);
+}
+
+TEST(op, cost_convolution)
+{
+    auto data = make_shared<op::Parameter>(element::f32, Shape{1, 2, 5, 5});
+    auto filters = make_shared<op::Parameter>(element::f32, Shape{3, 2, 3, 3});
+    auto conv = make_shared<op::Convolution>(data, filters);
+    // 3x3 outputs per channel, each a sum over 2 channels of 3x3 taps
+    EXPECT_EQ(get_op_cost(*conv).flops, 2 * (3 * 3 * 3) * (2 * 3 * 3));
+}
+
+TEST(op, cost_elementwise_and_data_movement)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto add = make_shared<op::Add>(A, A);
+    EXPECT_EQ(get_op_cost(*add).flops, 6);
+    auto sum = make_shared<op::Sum>(A, AxisSet{1});
+    EXPECT_EQ(get_op_cost(*sum).flops, 6);
+    auto reshape = make_shared<op::Reshape>(A, AxisVector{1, 0}, Shape{3, 2});
+    OpCost cost = get_op_cost(*reshape);
+    EXPECT_EQ(cost.flops, 0);
+    EXPECT_EQ(cost.bytes(), 2 * 6 * 4);
+    EXPECT_DOUBLE_EQ(cost.arithmetic_intensity(), 0);
+}
@@ -48,21 +48,50 @@ TEST(liveness, constant)
     auto tmp = f->get_ordered_ops();
     vector<shared_ptr<Node>> sorted{tmp.begin(), tmp.end()};
     ASSERT_EQ(3, sorted.size());
-    EXPECT_EQ(0, sorted[0]->liveness_live_list.size());
-    EXPECT_EQ(0, sorted[0]->liveness_new_list.size());
-    EXPECT_EQ(0, sorted[0]->liveness_free_list.size());
+    auto live_lists = pass::Liveness::get_live_lists(tmp);
+    EXPECT_EQ(0, live_lists[0].size());
+    EXPECT_EQ(0, sorted[0]->get_liveness_new_list().size());
+    EXPECT_EQ(0, sorted[0]->get_liveness_free_list().size());
 
     //op::Negative is live on output to op::Result
-    EXPECT_EQ(1, sorted[1]->liveness_live_list.size());
+    EXPECT_EQ(1, live_lists[1].size());
     //op::Negative is new
-    EXPECT_EQ(1, sorted[1]->liveness_new_list.size());
-    EXPECT_EQ(0, sorted[1]->liveness_free_list.size());
+    EXPECT_EQ(1, sorted[1]->get_liveness_new_list().size());
+    EXPECT_EQ(0, sorted[1]->get_liveness_free_list().size());
 
     //op::Negative is live on input to op::Result
-    EXPECT_EQ(1, sorted[2]->liveness_live_list.size());
-    EXPECT_EQ(0, sorted[2]->liveness_new_list.size());
+    EXPECT_EQ(1, live_lists[2].size());
+    EXPECT_EQ(0, sorted[2]->get_liveness_new_list().size());
     //op::Negative is freed
-    EXPECT_EQ(1, sorted[2]->liveness_free_list.size());
+    EXPECT_EQ(1, sorted[2]->get_liveness_free_list().size());
+}
+
+TEST(liveness, intervals)
+{
+    Shape shape{2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto t1 = make_shared<op::Negative>(A);
+    auto t2 = make_shared<op::Negative>(t1);
+    auto t3 = make_shared<op::Add>(t1, t2);
+    auto f = make_shared<Function>(make_shared<op::Negative>(t3), op::ParameterVector{A});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.run_passes(f);
+
+    auto& tensor = A->get_output_tensor(0);
+    EXPECT_FALSE(tensor.has_liveness());
+    EXPECT_EQ(1, t1->get_liveness_index());
+    EXPECT_EQ(1, t1->get_output_tensor(0).get_first_use());
+    EXPECT_EQ(3, t1->get_output_tensor(0).get_last_use());
+    EXPECT_EQ(2, t2->get_output_tensor(0).get_first_use());
+    EXPECT_EQ(3, t2->get_output_tensor(0).get_last_use());
+
+    // Both inputs of t3 die at t3
+    EXPECT_EQ(2, t3->get_liveness_free_list().size());
+    EXPECT_EQ(1, t3->get_liveness_new_list().size());
+    auto live_lists = pass::Liveness::get_live_lists(f->get_ordered_ops());
+    EXPECT_EQ(3, live_lists[3].size());
 }
 
 TEST(liveness, liveness)
@@ -236,3 +236,129 @@ TEST(memory_layout, constant)
     size_t temporary_pool_size = f->get_temporary_pool_size();
     EXPECT_EQ(4, temporary_pool_size);
 }
+
+TEST(memory_layout, in_place)
+{
+    Shape shape{4};
+    auto make_function = [&](bool in_place) {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto t1 = make_shared<op::Negative>(A);
+        auto t2 = make_shared<op::Exp>(t1);
+        auto t3 = make_shared<op::Abs>(t2);
+        auto t4 = make_shared<op::Negative>(t3);
+        if (in_place)
+        {
+            for (shared_ptr<op::Op> op : vector<shared_ptr<op::Op>>{t1, t2, t3, t4})
+            {
+                auto op_annotations = make_shared<op::util::OpAnnotations>();
+                op_annotations->add_in_place_oi_pair({0, 0});
+                op->set_op_annotations(op_annotations);
+            }
+        }
+        return make_shared<Function>(t4, op::ParameterVector{A});
+    };
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>();
+
+    auto f = make_function(false);
+    pass_manager.run_passes(f);
+    EXPECT_EQ(32, f->get_temporary_pool_size());
+
+    // Every temporary reuses the buffer of its input, except the first whose input is a parameter
+    f = make_function(true);
+    pass_manager.run_passes(f);
+    EXPECT_EQ(16, f->get_temporary_pool_size());
+    for (shared_ptr<Node> node : f->get_ordered_ops())
+    {
+        if (!node->get_liveness_new_list().empty())
+        {
+            EXPECT_EQ(0, node->get_output_tensor(0).get_pool_offset());
+        }
+    }
+}
+
+TEST(memory_layout, offline)
+{
+    auto make_function = []() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{});
+        auto x = make_shared<op::Negative>(A);
+        auto y = make_shared<op::Broadcast>(x, Shape{4}, AxisSet{0});
+        auto z = make_shared<op::Negative>(y);
+        auto w = make_shared<op::Negative>(z);
+        return make_shared<Function>(make_shared<op::Negative>(w), op::ParameterVector{A});
+    };
+
+    // Greedy placement leaves the hole of the 4 byte x in front of z
+    pass::Manager greedy;
+    greedy.register_pass<pass::Liveness>();
+    greedy.register_pass<pass::MemoryLayout>();
+    auto f = make_function();
+    greedy.run_passes(f);
+    EXPECT_EQ(36, f->get_temporary_pool_size());
+    EXPECT_EQ(32, f->get_temporary_pool_lower_bound());
+
+    pass::Manager offline;
+    offline.register_pass<pass::Liveness>();
+    offline.register_pass<pass::MemoryLayout>(1, pass::MemoryLayout::allocation_scheme::OFFLINE);
+    f = make_function();
+    offline.run_passes(f);
+    EXPECT_EQ(32, f->get_temporary_pool_size());
+    EXPECT_EQ(32, f->get_temporary_pool_lower_bound());
+}
+
+TEST(memory_layout, offline_no_overlap)
+{
+    // Branches of different sizes that stay live for different lengths of time
+    auto A = make_shared<op::Parameter>(element::f32, Shape{});
+    shared_ptr<Node> chain = make_shared<op::Negative>(A);
+    NodeVector pending;
+    for (size_t i = 0; i < 40; i++)
+    {
+        chain = make_shared<op::Negative>(chain);
+        pending.push_back(make_shared<op::Broadcast>(chain, Shape{i % 7 + 1}, AxisSet{0}));
+        if (i % 5 == 4)
+        {
+            shared_ptr<Node> sum = make_shared<op::Sum>(pending.front(), AxisSet{0});
+            for (size_t j = 1; j < pending.size(); j++)
+            {
+                sum = sum + make_shared<op::Sum>(pending[j], AxisSet{0});
+            }
+            chain = chain + sum;
+            pending.clear();
+        }
+    }
+    auto f = make_shared<Function>(chain, op::ParameterVector{A});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>(
+        1, pass::MemoryLayout::allocation_scheme::OFFLINE);
+    pass_manager.run_passes(f);
+
+    vector<descriptor::Tensor*> tensors;
+    for (shared_ptr<Node> node : f->get_ordered_ops())
+    {
+        for (descriptor::Tensor* tensor : node->get_liveness_new_list())
+        {
+            tensors.push_back(tensor);
+        }
+    }
+    ASSERT_GT(tensors.size(), 100);
+    for (size_t i = 0; i < tensors.size(); i++)
+    {
+        const descriptor::Tensor& a = *tensors[i];
+        EXPECT_LE(a.get_pool_offset() + a.size(), f->get_temporary_pool_size());
+        for (size_t j = i + 1; j < tensors.size(); j++)
+        {
+            const descriptor::Tensor& b = *tensors[j];
+            bool live_together =
+                a.get_first_use() <= b.get_last_use() && b.get_first_use() <= a.get_last_use();
+            bool share_memory = a.get_pool_offset() < b.get_pool_offset() + b.size() &&
+                                b.get_pool_offset() < a.get_pool_offset() + a.size();
+            EXPECT_FALSE(live_together && share_memory) << a.get_name() << " " << b.get_name();
+        }
+    }
+    EXPECT_GE(f->get_temporary_pool_size(), f->get_temporary_pool_lower_bound());
+}
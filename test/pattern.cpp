@@ -530,3 +530,81 @@ TEST(pattern, variance)
     ASSERT_TRUE(n.match(var_graph, variance));
     ASSERT_EQ(n.get_pattern_map()[var_graph], variance);
 }
+
+TEST(pattern, graph_rewrite_revisits_rewritten_nodes)
+{
+    class NegativeToAbsAbs : public ngraph::pass::GraphRewrite
+    {
+    public:
+        NegativeToAbsAbs()
+            : GraphRewrite()
+        {
+            // -x becomes abs(abs(x)), which only the second matcher can simplify
+            auto x = std::make_shared<pattern::op::Label>(element::i32, Shape{1});
+            ngraph::pattern::gr_callback_fn negative_callback = [x](pattern::Matcher& m) {
+                auto arg = m.get_pattern_map()[x];
+                ngraph::replace_node(
+                    m.match_root(),
+                    std::make_shared<op::Abs>(std::make_shared<op::Abs>(arg)));
+                return true;
+            };
+            add_matcher(std::make_shared<pattern::Matcher>(std::make_shared<op::Negative>(x),
+                                                           negative_callback));
+
+            auto y = std::make_shared<pattern::op::Label>(element::i32, Shape{1});
+            ngraph::pattern::gr_callback_fn abs_callback = [](pattern::Matcher& m) {
+                ngraph::replace_node(m.match_root(), m.match_root()->get_input_op(0));
+                return true;
+            };
+            add_matcher(std::make_shared<pattern::Matcher>(
+                std::make_shared<op::Abs>(std::make_shared<op::Abs>(y)), abs_callback));
+        }
+    };
+
+    auto a = make_shared<op::Parameter>(element::i32, Shape{1});
+    auto f = make_shared<Function>(make_shared<op::Negative>(a), op::ParameterVector{a});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<NegativeToAbsAbs>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(0, count_ops_of_type<op::Negative>(f));
+    ASSERT_EQ(1, count_ops_of_type<op::Abs>(f));
+}
+
+TEST(pattern, graph_rewrite_revisit_limit)
+{
+    class NegativeAbsCycle : public ngraph::pass::GraphRewrite
+    {
+    public:
+        NegativeAbsCycle()
+            : GraphRewrite()
+        {
+            // Each matcher undoes the other's rewrite
+            auto x = std::make_shared<pattern::op::Label>(element::i32, Shape{1});
+            ngraph::pattern::gr_callback_fn to_abs = [x](pattern::Matcher& m) {
+                auto arg = m.get_pattern_map()[x];
+                ngraph::replace_node(m.match_root(), std::make_shared<op::Abs>(arg));
+                return true;
+            };
+            add_matcher(
+                std::make_shared<pattern::Matcher>(std::make_shared<op::Negative>(x), to_abs));
+
+            auto y = std::make_shared<pattern::op::Label>(element::i32, Shape{1});
+            ngraph::pattern::gr_callback_fn to_negative = [y](pattern::Matcher& m) {
+                auto arg = m.get_pattern_map()[y];
+                ngraph::replace_node(m.match_root(), std::make_shared<op::Negative>(arg));
+                return true;
+            };
+            add_matcher(
+                std::make_shared<pattern::Matcher>(std::make_shared<op::Abs>(y), to_negative));
+        }
+    };
+
+    auto a = make_shared<op::Parameter>(element::i32, Shape{1});
+    auto f = make_shared<Function>(make_shared<op::Negative>(a), op::ParameterVector{a});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<NegativeAbsCycle>();
+    EXPECT_THROW(pass_manager.run_passes(f), ngraph_error);
+}
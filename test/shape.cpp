@@ -19,6 +19,7 @@
 #include "gtest/gtest.h"
 
 #include "ngraph/ngraph.hpp"
+#include "ngraph/strided_walk.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -36,3 +37,42 @@ TEST(shape, test_shape_strides)
     ASSERT_EQ((Strides{7, 1}), row_major_strides(Shape{2, 7}));
     ASSERT_EQ((Strides{84, 12, 1}), row_major_strides(Shape{5, 7, 12}));
 }
+
+TEST(shape, strided_walk)
+{
+    // Rank 4 takes the general path; reverse axis 1 and broadcast along axis 3
+    Shape shape{2, 3, 2, 2};
+    Strides source_strides = row_major_strides(Shape{2, 3, 2});
+    StridedWalk walk(shape,
+                     2 * source_strides[1],
+                     {ptrdiff_t(source_strides[0]), -ptrdiff_t(source_strides[1]), 1, 0},
+                     0,
+                     StridedWalk::dense_strides(shape));
+
+    vector<size_t> sources;
+    vector<size_t> targets;
+    walk.for_each([&](size_t source, size_t target) {
+        sources.push_back(source);
+        targets.push_back(target);
+    });
+
+    ASSERT_EQ(shape_size(shape), targets.size());
+    size_t i = 0;
+    for (size_t a = 0; a < 2; a++)
+    {
+        for (size_t b = 0; b < 3; b++)
+        {
+            for (size_t c = 0; c < 2; c++)
+            {
+                for (size_t d = 0; d < 2; d++)
+                {
+                    EXPECT_EQ(i, targets[i]);
+                    EXPECT_EQ(a * 6 + (2 - b) * 2 + c, sources[i]);
+                    i++;
+                }
+            }
+        }
+    }
+
+    EXPECT_THROW(StridedWalk(Shape{2, 2}, 0, {1}, 0, {2, 1}), ngraph_error);
+}
@@ -27,6 +27,7 @@
 #include "ngraph/ngraph.hpp"
 #include "ngraph/serializer.hpp"
 #include "util/all_close.hpp"
+#include "util/benchmark.hpp"
 #include "util/ndarray.hpp"
 
 using namespace std;
@@ -324,3 +325,61 @@ TEST(util, parse_string)
     EXPECT_FLOAT_EQ(-numeric_limits<double>::infinity(), parse_string<double>("-INFINITY"));
     EXPECT_TRUE(std::isnan(parse_string<double>("NaN")));
 }
+
+TEST(util, benchmark_compare)
+{
+    BenchmarkResult baseline;
+    baseline.backend = "INTERPRETER";
+    baseline.compile_ms = 100;
+    baseline.first_call_ms = 10;
+    for (size_t i = 1; i <= 100; i++)
+    {
+        baseline.latencies_ms.push_back(i);
+    }
+    EXPECT_DOUBLE_EQ(baseline.mean_ms(), 50.5);
+    EXPECT_DOUBLE_EQ(baseline.percentile_ms(0), 1);
+    EXPECT_DOUBLE_EQ(baseline.percentile_ms(50), 50);
+    EXPECT_DOUBLE_EQ(baseline.percentile_ms(99), 99);
+    EXPECT_DOUBLE_EQ(baseline.percentile_ms(100), 100);
+
+    string dir = file_util::make_temp_directory();
+    string path = file_util::path_join(dir, "baseline.json");
+    write_benchmark_json(baseline, path);
+
+    BenchmarkResult current = baseline;
+    EXPECT_TRUE(compare_benchmark(current, path, 5));
+
+    // Compile time is reported but not gated, it depends on the state of the code cache
+    current.compile_ms = 300;
+    EXPECT_TRUE(compare_benchmark(current, path, 5));
+
+    // One noisy call is the p99 of 100 samples, too few to gate on
+    current.latencies_ms.back() = 1000;
+    EXPECT_TRUE(compare_benchmark(current, path, 5));
+
+    // A slow tail of 15 calls moves p90, which is gated with 100 samples
+    for (size_t i = 85; i < 100; i++)
+    {
+        current.latencies_ms[i] = 200;
+    }
+    EXPECT_FALSE(compare_benchmark(current, path, 5));
+    EXPECT_TRUE(compare_benchmark(current, path, 300));
+
+    // A shift of the whole distribution is caught by the median and the rank test
+    current = baseline;
+    for (double& latency : current.latencies_ms)
+    {
+        latency *= 1.2;
+    }
+    EXPECT_FALSE(compare_benchmark(current, path, 5));
+    EXPECT_TRUE(compare_benchmark(current, path, 30));
+
+    // A median past the threshold that the rank test finds insignificant is noise
+    BenchmarkResult small = baseline;
+    small.latencies_ms = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+    write_benchmark_json(small, path);
+    current = small;
+    current.latencies_ms = {10, 11, 12, 13, 16, 17, 17, 18, 19, 40};
+    EXPECT_TRUE(compare_benchmark(current, path, 5));
+    file_util::remove_directory(dir);
+}
@@ -14,10 +14,24 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
 #include <iomanip>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include "benchmark.hpp"
 #include "ngraph/graph_util.hpp"
+#include "ngraph/op_cost.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/call_frame.hpp"
 #include "ngraph/runtime/external_function.hpp"
@@ -25,6 +39,7 @@
 #include "ngraph/runtime/tensor_view.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
+#include "nlohmann/json.hpp"
 #include "random.hpp"
 
 using namespace std;
@@ -86,10 +101,10 @@ multimap<size_t, string> aggregate_timing(const vector<runtime::PerformanceCount
     return rc;
 }
 
-void run_benchmark(const string& json_path,
-                   const string& backend_name,
-                   size_t iterations,
-                   bool timing_detail)
+BenchmarkResult run_benchmark(const string& json_path,
+                              const string& backend_name,
+                              size_t iterations,
+                              bool timing_detail)
 {
     stopwatch timer;
     timer.start();
@@ -98,7 +113,36 @@ void run_benchmark(const string& json_path,
     shared_ptr<Function> f = deserialize(ss);
     timer.stop();
     cout << "deserialize time: " << timer.get_milliseconds() << "ms" << endl;
-    run_benchmark(f, backend_name, iterations, timing_detail);
+    BenchmarkOptions options;
+    options.iterations = iterations;
+    options.timing_detail = timing_detail;
+    return run_benchmark(f, backend_name, options);
+}
+
+double BenchmarkResult::mean_ms() const
+{
+    if (latencies_ms.empty())
+    {
+        return 0;
+    }
+    return accumulate(latencies_ms.begin(), latencies_ms.end(), 0.0) / latencies_ms.size();
+}
+
+double BenchmarkResult::percentile_ms(double p) const
+{
+    if (latencies_ms.empty())
+    {
+        return 0;
+    }
+    vector<double> sorted = latencies_ms;
+    sort(sorted.begin(), sorted.end());
+    size_t rank = static_cast<size_t>(ceil(p / 100 * sorted.size()));
+    return sorted[rank == 0 ? 0 : min(rank, sorted.size()) - 1];
+}
+
+double BenchmarkResult::calls_per_second() const
+{
+    return wall_ms > 0 ? latencies_ms.size() * 1000 / wall_ms : 0;
 }
 
 void print_times(const multimap<size_t, string>& timing)
@@ -121,25 +165,84 @@ void print_times(const multimap<size_t, string>& timing)
     }
 }
 
-void run_benchmark(shared_ptr<Function> f,
-                   const string& backend_name,
-                   size_t iterations,
-                   bool timing_detail)
+struct OpThroughput
 {
-    test::Uniform<float> rng{-1, 1, 0};
+    size_t microseconds;
+    size_t flops;
+    size_t bytes;
+};
 
-    stopwatch timer;
-    timer.start();
-    auto manager = runtime::Manager::get(backend_name);
-    auto external = manager->compile(f);
-    external->set_emit_timing(timing_detail);
-    auto backend = manager->allocate_backend();
-    auto cf = backend->make_call_frame(external);
-    timer.stop();
-    cout.imbue(locale(""));
-    cout << "compile time: " << timer.get_milliseconds() << "ms" << endl;
+map<string, OpThroughput> aggregate_throughput(const vector<runtime::PerformanceCounter>& perf_data,
+                                               shared_ptr<Function> f)
+{
+    map<string, OpThroughput> rc;
+    for (const runtime::PerformanceCounter& p : perf_data)
+    {
+        shared_ptr<Node> node = find_node(p.name(), f);
+        string op = p.name().substr(0, p.name().find('_'));
+        string shape_name = "{" + join(node->get_outputs()[0].get_shape()) + "}";
+        OpCost cost = get_op_cost(*node);
+        OpThroughput& t = rc[op + shape_name];
+        t.microseconds += p.microseconds();
+        t.flops += cost.flops;
+        t.bytes += cost.bytes();
+    }
+    return rc;
+}
 
-    vector<shared_ptr<runtime::TensorView>> args;
+void print_throughput(const map<string, OpThroughput>& throughput,
+                      double peak_gflops,
+                      double peak_gbps)
+{
+    bool roofline = peak_gflops > 0 && peak_gbps > 0;
+    int name_width = 0;
+    for (const pair<string, OpThroughput>& t : throughput)
+    {
+        name_width = max(name_width, static_cast<int>(t.first.size()));
+    }
+    cout << setw(name_width + 2) << left << "op" << setw(10) << right << "us" << setw(12)
+         << "GFLOP/s" << setw(10) << "GB/s" << setw(10) << "FLOP/B";
+    if (roofline)
+    {
+        cout << setw(10) << "bound" << setw(10) << "%peak";
+    }
+    cout << "\n";
+
+    // Slowest first, like the timing tables
+    multimap<size_t, pair<string, OpThroughput>> by_time;
+    for (const pair<string, OpThroughput>& t : throughput)
+    {
+        by_time.insert({t.second.microseconds, t});
+    }
+    for (auto it = by_time.rbegin(); it != by_time.rend(); it++)
+    {
+        const string& name = it->second.first;
+        const OpThroughput& t = it->second.second;
+        // FLOPs per microsecond / 1000 is GFLOP/s
+        double us = max<double>(t.microseconds, 1);
+        double gflops = t.flops / us / 1000;
+        double gbps = t.bytes / us / 1000;
+        double intensity = t.bytes == 0 ? 0 : static_cast<double>(t.flops) / t.bytes;
+        cout << setw(name_width + 2) << left << name << setw(10) << right << t.microseconds
+             << setw(12) << fixed << setprecision(2) << gflops << setw(10) << gbps << setw(10)
+             << intensity;
+        if (roofline)
+        {
+            // Ops left of the ridge point are limited by memory bandwidth
+            bool memory_bound = intensity < peak_gflops / peak_gbps;
+            double percent = memory_bound ? 100 * gbps / peak_gbps : 100 * gflops / peak_gflops;
+            cout << setw(10) << (memory_bound ? "memory" : "compute") << setw(10) << percent;
+        }
+        cout << defaultfloat << "\n";
+    }
+}
+
+static void make_tensors(shared_ptr<Function> f,
+                         shared_ptr<runtime::Backend> backend,
+                         test::Uniform<float>& rng,
+                         vector<shared_ptr<runtime::TensorView>>& args,
+                         vector<shared_ptr<runtime::TensorView>>& results)
+{
     for (shared_ptr<op::Parameter> param : f->get_parameters())
     {
         auto tensor =
@@ -147,29 +250,79 @@ void run_benchmark(shared_ptr<Function> f,
         rng.initialize(tensor);
         args.push_back(tensor);
     }
-    vector<shared_ptr<runtime::TensorView>> results;
     for (shared_ptr<Node> out : f->get_results())
     {
         auto result = backend->make_primary_tensor_view(out->get_element_type(), out->get_shape());
         results.push_back(result);
     }
+}
 
+BenchmarkResult run_benchmark(shared_ptr<Function> f,
+                              const string& backend_name,
+                              const BenchmarkOptions& options)
+{
+    test::Uniform<float> rng{-1, 1, 0};
+    BenchmarkResult result;
+    result.backend = backend_name;
+    result.warmup_iterations = options.warmup_iterations;
+
+    stopwatch timer;
+    timer.start();
+    auto manager = runtime::Manager::get(backend_name);
+    auto external = manager->compile(f);
+    external->set_emit_timing(options.timing_detail);
+    auto backend = manager->allocate_backend();
+    auto cf = backend->make_call_frame(external);
+    timer.stop();
+    result.compile_ms = timer.get_nanoseconds() / 1e6;
+    cout.imbue(locale(""));
+    cout << "compile time: " << timer.get_milliseconds() << "ms" << endl;
+    if (f->get_temporary_pool_size() > 0)
+    {
+        cout << "temporary pool: " << f->get_temporary_pool_size()
+             << " bytes, liveness lower bound " << f->get_temporary_pool_lower_bound() << " bytes"
+             << endl;
+    }
+
+    vector<shared_ptr<runtime::TensorView>> args;
+    vector<shared_ptr<runtime::TensorView>> results;
+    make_tensors(f, backend, rng, args, results);
+
+    // The first call pays for lazy initialization and cold caches, so it is reported on
+    // its own and followed by unmeasured warmup calls
     stopwatch t1;
     t1.start();
-    for (size_t i = 0; i < static_cast<size_t>(iterations); i++)
+    cf->tensor_call(args, results);
+    t1.stop();
+    result.first_call_ms = t1.get_nanoseconds() / 1e6;
+    for (size_t i = 0; i < options.warmup_iterations; i++)
     {
         cf->tensor_call(args, results);
     }
-    t1.stop();
-    float time = t1.get_milliseconds();
-    cout << time / iterations << "ms per iteration" << endl;
 
+    result.latencies_ms.reserve(options.iterations);
+    for (size_t i = 0; i < options.iterations; i++)
+    {
+        t1.start();
+        cf->tensor_call(args, results);
+        t1.stop();
+        result.latencies_ms.push_back(t1.get_nanoseconds() / 1e6);
+    }
+    result.wall_ms = accumulate(result.latencies_ms.begin(), result.latencies_ms.end(), 0.0);
+    cout << "first call: " << result.first_call_ms << "ms" << endl;
+    cout << result.mean_ms() << "ms per iteration" << endl;
+    cout << "latency p50: " << result.percentile_ms(50) << "ms, p90: " << result.percentile_ms(90)
+         << "ms, p99: " << result.percentile_ms(99) << "ms, max: " << result.percentile_ms(100)
+         << "ms" << endl;
+
+    // Op timers also count the first and the warmup calls
     vector<runtime::PerformanceCounter> perf_data = cf->get_performance_data();
     sort(perf_data.begin(),
          perf_data.end(),
          [](const runtime::PerformanceCounter& p1, const runtime::PerformanceCounter& p2) {
              return p1.total_microseconds() > p2.total_microseconds();
          });
+    result.perf_data = perf_data;
     multimap<size_t, string> timing = aggregate_timing(perf_data);
     multimap<size_t, string> timing_details = aggregate_timing_details(perf_data, f);
 
@@ -178,4 +331,336 @@ void run_benchmark(shared_ptr<Function> f,
 
     cout << "\n---- Aggregate times per op type/shape ----\n";
     print_times(timing_details);
+
+    if (options.timing_detail)
+    {
+        cout << "\n---- Achieved throughput per op type/shape ----\n";
+        print_throughput(
+            aggregate_throughput(perf_data, f), options.peak_gflops, options.peak_gbps);
+    }
+    return result;
+}
+
+// Restricts the calling thread, and the OpenMP threads it starts, to cores
+// [first, first + count)
+static void pin_to_cores(size_t first, size_t count)
+{
+#ifdef __linux__
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    for (size_t core = first; core < first + count; core++)
+    {
+        CPU_SET(core, &cores);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores);
+#endif
+}
+
+vector<BenchmarkResult> run_concurrent_benchmark(shared_ptr<Function> f,
+                                                 const string& backend_name,
+                                                 const BenchmarkOptions& options,
+                                                 const vector<size_t>& thread_counts,
+                                                 bool pin_threads)
+{
+    test::Uniform<float> rng{-1, 1, 0};
+
+    stopwatch timer;
+    timer.start();
+    auto manager = runtime::Manager::get(backend_name);
+    auto external = manager->compile(f);
+    auto backend = manager->allocate_backend();
+    backend->make_call_frame(external);
+    timer.stop();
+    cout << "compile time: " << timer.get_milliseconds() << "ms" << endl;
+    const char* omp_threads = getenv("OMP_NUM_THREADS");
+    cout << "OMP_NUM_THREADS: " << (omp_threads ? omp_threads : "unset") << endl;
+
+    struct Worker
+    {
+        shared_ptr<runtime::CallFrame> cf;
+        vector<shared_ptr<runtime::TensorView>> args;
+        vector<shared_ptr<runtime::TensorView>> results;
+        vector<double> latencies_ms;
+    };
+
+    cout << "\n" << setw(8) << "threads" << setw(12) << "calls/s" << setw(10) << "mean"
+         << setw(10) << "p50" << setw(10) << "p90" << setw(10) << "p99" << setw(10) << "max"
+         << "   (ms)\n";
+    vector<BenchmarkResult> rc;
+    size_t core_count = max(thread::hardware_concurrency(), 1u);
+    for (size_t thread_count : thread_counts)
+    {
+        // Every worker has its own call frame and tensors on the one compiled function
+        vector<Worker> workers(thread_count);
+        for (Worker& worker : workers)
+        {
+            worker.cf = backend->make_call_frame(external);
+            make_tensors(f, backend, rng, worker.args, worker.results);
+            worker.latencies_ms.reserve(options.iterations);
+        }
+
+        // Workers warm up on their own and then wait for all of them to be ready, so the
+        // wall time only covers the measured calls
+        mutex start_mutex;
+        condition_variable start_cv;
+        size_t ready = 0;
+        bool go = false;
+        vector<thread> threads;
+        for (size_t i = 0; i < thread_count; i++)
+        {
+            threads.emplace_back([&, i]() {
+                Worker& worker = workers[i];
+                if (pin_threads)
+                {
+                    size_t cores = max<size_t>(core_count / thread_count, 1);
+                    pin_to_cores((i * cores) % core_count, cores);
+                }
+                for (size_t j = 0; j < 1 + options.warmup_iterations; j++)
+                {
+                    worker.cf->tensor_call(worker.args, worker.results);
+                }
+                {
+                    unique_lock<mutex> lock(start_mutex);
+                    ready++;
+                    start_cv.notify_all();
+                    start_cv.wait(lock, [&]() { return go; });
+                }
+                stopwatch t;
+                for (size_t j = 0; j < options.iterations; j++)
+                {
+                    t.start();
+                    worker.cf->tensor_call(worker.args, worker.results);
+                    t.stop();
+                    worker.latencies_ms.push_back(t.get_nanoseconds() / 1e6);
+                }
+            });
+        }
+
+        stopwatch wall;
+        {
+            unique_lock<mutex> lock(start_mutex);
+            start_cv.wait(lock, [&]() { return ready == thread_count; });
+            wall.start();
+            go = true;
+        }
+        start_cv.notify_all();
+        for (thread& t : threads)
+        {
+            t.join();
+        }
+        wall.stop();
+
+        BenchmarkResult result;
+        result.backend = backend_name;
+        result.threads = thread_count;
+        result.compile_ms = timer.get_nanoseconds() / 1e6;
+        result.warmup_iterations = options.warmup_iterations;
+        result.wall_ms = wall.get_nanoseconds() / 1e6;
+        for (const Worker& worker : workers)
+        {
+            result.latencies_ms.insert(result.latencies_ms.end(),
+                                       worker.latencies_ms.begin(),
+                                       worker.latencies_ms.end());
+        }
+        cout << setw(8) << thread_count << fixed << setprecision(1) << setw(12)
+             << result.calls_per_second() << setprecision(3) << setw(10) << result.mean_ms()
+             << setw(10) << result.percentile_ms(50) << setw(10) << result.percentile_ms(90)
+             << setw(10) << result.percentile_ms(99) << setw(10) << result.percentile_ms(100)
+             << defaultfloat << "\n";
+        rc.push_back(result);
+    }
+    return rc;
+}
+
+static nlohmann::json latency_summary(const BenchmarkResult& result)
+{
+    return nlohmann::json{{"mean", result.mean_ms()},
+                          {"min", result.percentile_ms(0)},
+                          {"p50", result.percentile_ms(50)},
+                          {"p90", result.percentile_ms(90)},
+                          {"p99", result.percentile_ms(99)},
+                          {"max", result.percentile_ms(100)}};
+}
+
+void write_benchmark_json(const BenchmarkResult& result, const string& path)
+{
+    nlohmann::json ops = nlohmann::json::array();
+    for (const runtime::PerformanceCounter& p : result.perf_data)
+    {
+        ops.push_back({{"name", p.name()},
+                       {"total_us", p.total_microseconds()},
+                       {"calls", p.call_count()}});
+    }
+
+    nlohmann::json j;
+    j["backend"] = result.backend;
+    j["compile_ms"] = result.compile_ms;
+    j["first_call_ms"] = result.first_call_ms;
+    j["threads"] = result.threads;
+    j["warmup_iterations"] = result.warmup_iterations;
+    j["iterations"] = result.latencies_ms.size();
+    j["latency_ms"] = latency_summary(result);
+    j["latencies_ms"] = result.latencies_ms;
+    j["ops"] = ops;
+
+    ofstream out(path);
+    out << j.dump(4);
+}
+
+// Below this many latencies per run, the Mann-Whitney test has too little power and the
+// medians are compared by threshold alone
+static const size_t s_min_rank_test_samples = 8;
+// A percentile is only gated when at least this many samples lie above it, so a single
+// noisy call cannot fail the comparison
+static const size_t s_min_tail_samples = 10;
+// Significance level of the one-sided Mann-Whitney test
+static const double s_significance = 0.01;
+
+// One-sided Mann-Whitney U test, normal approximation with tie and continuity correction.
+// Returns the probability of current being at least this much slower than baseline by chance.
+static double mann_whitney_p(const vector<double>& baseline, const vector<double>& current)
+{
+    vector<pair<double, bool>> all;
+    for (double x : baseline)
+    {
+        all.push_back({x, false});
+    }
+    for (double x : current)
+    {
+        all.push_back({x, true});
+    }
+    sort(all.begin(), all.end());
+
+    double n1 = current.size();
+    double n2 = baseline.size();
+    double n = n1 + n2;
+    double current_rank_sum = 0;
+    double tie_term = 0;
+    for (size_t i = 0; i < all.size();)
+    {
+        size_t j = i;
+        while (j < all.size() && all[j].first == all[i].first)
+        {
+            j++;
+        }
+        double rank = (i + 1 + j) / 2.0;
+        for (size_t k = i; k < j; k++)
+        {
+            current_rank_sum += all[k].second ? rank : 0;
+        }
+        double t = j - i;
+        tie_term += t * t * t - t;
+        i = j;
+    }
+
+    double u = current_rank_sum - n1 * (n1 + 1) / 2;
+    double sigma = sqrt(n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1))));
+    if (sigma == 0)
+    {
+        return 1;
+    }
+    double z = (u - n1 * n2 / 2 - 0.5) / sigma;
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+bool compare_benchmark(const BenchmarkResult& result,
+                       const string& baseline_path,
+                       double threshold_percent)
+{
+    nlohmann::json baseline = nlohmann::json::parse(file_util::read_file_to_string(baseline_path));
+    nlohmann::json latency = latency_summary(result);
+    vector<double> baseline_latencies;
+    if (baseline.count("latencies_ms"))
+    {
+        baseline_latencies = baseline.at("latencies_ms").get<vector<double>>();
+    }
+    size_t sample_count = min(baseline_latencies.size(), result.latencies_ms.size());
+    if (baseline_latencies.empty())
+    {
+        sample_count = result.latencies_ms.size();
+    }
+
+    struct Row
+    {
+        string name;
+        double base;
+        double current;
+        // Empty when the row is gated on the threshold alone
+        string note;
+        bool gated;
+        bool significant;
+    };
+    vector<Row> rows;
+
+    // Compile and first call times swing with caches warm or cold, they are only reported
+    rows.push_back({"compile_ms",
+                    baseline.at("compile_ms").get<double>(),
+                    result.compile_ms,
+                    "not gated",
+                    false,
+                    false});
+    rows.push_back({"first_call_ms",
+                    baseline.at("first_call_ms").get<double>(),
+                    result.first_call_ms,
+                    "not gated",
+                    false,
+                    false});
+
+    // The median is gated when it moved past the threshold and, with enough samples, the
+    // rank test agrees that the whole distribution moved
+    Row median{"latency_ms.p50",
+               baseline.at("latency_ms").at("p50").get<double>(),
+               latency.at("p50").get<double>(),
+               "",
+               true,
+               true};
+    if (!baseline_latencies.empty() && sample_count >= s_min_rank_test_samples)
+    {
+        double p = mann_whitney_p(baseline_latencies, result.latencies_ms);
+        median.significant = p < s_significance;
+        stringstream note;
+        note << "U test p=" << setprecision(3) << p;
+        median.note = note.str();
+    }
+    rows.push_back(median);
+    rows.push_back({"latency_ms.mean",
+                    baseline.at("latency_ms").at("mean").get<double>(),
+                    latency.at("mean").get<double>(),
+                    "not gated",
+                    false,
+                    false});
+    for (double p : {90.0, 99.0})
+    {
+        stringstream key;
+        key << "p" << p;
+        bool enough = sample_count * (100 - p) / 100 >= s_min_tail_samples;
+        rows.push_back({"latency_ms." + key.str(),
+                        baseline.at("latency_ms").at(key.str()).get<double>(),
+                        latency.at(key.str()).get<double>(),
+                        enough ? "" : "too few samples, not gated",
+                        enough,
+                        true});
+    }
+
+    cout << "\n---- Comparison with " << baseline_path << " ----\n";
+    size_t baseline_threads = baseline.value("threads", size_t(1));
+    if (baseline_threads != result.threads)
+    {
+        cout << "Note: baseline ran " << baseline_threads << " threads, this run "
+             << result.threads << "\n";
+    }
+    cout << setw(16) << left << "" << setw(12) << right << "baseline" << setw(12) << "current"
+         << setw(10) << "change\n";
+    bool passed = true;
+    for (const Row& row : rows)
+    {
+        double change = row.base > 0 ? 100 * (row.current - row.base) / row.base : 0;
+        bool regressed = row.gated && row.significant && change > threshold_percent;
+        passed = passed && !regressed;
+        cout << setw(16) << left << row.name << setw(12) << right << fixed << setprecision(3)
+             << row.base << setw(12) << row.current << setw(9) << setprecision(1) << showpos
+             << change << "%" << noshowpos << defaultfloat << (regressed ? "  REGRESSION" : "")
+             << (row.note.empty() ? "" : "  (" + row.note + ")") << "\n";
+    }
+    return passed;
 }
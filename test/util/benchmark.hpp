@@ -17,6 +17,8 @@
 #pragma once
 
 #include <map>
+#include <string>
+#include <vector>
 
 #include <ngraph/function.hpp>
 #include <ngraph/runtime/call_frame.hpp>
@@ -27,12 +29,65 @@
 std::multimap<size_t, std::string>
     aggregate_timing(const std::vector<ngraph::runtime::PerformanceCounter>& perf_data);
 
-void run_benchmark(std::shared_ptr<ngraph::Function> f,
-                   const std::string& backend_name,
-                   size_t iterations,
-                   bool timing_detail);
+struct BenchmarkOptions
+{
+    size_t iterations = 10;
+    /// Calls made after the first one and before the measured ones
+    size_t warmup_iterations = 1;
+    bool timing_detail = false;
+    /// Peaks of the machine, when given the per op throughput reported with timing_detail
+    /// is classified against its roofline
+    double peak_gflops = 0;
+    double peak_gbps = 0;
+};
 
-void run_benchmark(const std::string& json_path,
-                   const std::string& backend_name,
-                   size_t iterations,
-                   bool timing_detail = false);
+struct BenchmarkResult
+{
+    std::string backend;
+    /// Call frames run concurrently
+    size_t threads = 1;
+    double compile_ms = 0;
+    double first_call_ms = 0;
+    size_t warmup_iterations = 0;
+    /// Latency of every measured call
+    std::vector<double> latencies_ms;
+    /// Time from the start of the first measured call to the end of the last one
+    double wall_ms = 0;
+    std::vector<ngraph::runtime::PerformanceCounter> perf_data;
+
+    double mean_ms() const;
+    /// Throughput of all threads together
+    double calls_per_second() const;
+    /// Nearest rank percentile of latencies_ms, p in [0, 100]
+    double percentile_ms(double p) const;
+};
+
+BenchmarkResult run_benchmark(std::shared_ptr<ngraph::Function> f,
+                              const std::string& backend_name,
+                              const BenchmarkOptions& options);
+
+BenchmarkResult run_benchmark(const std::string& json_path,
+                              const std::string& backend_name,
+                              size_t iterations,
+                              bool timing_detail = false);
+
+/// Throughput mode: for each count in thread_counts, runs that many threads, each calling
+/// its own call frame of one compiled function. With pin_threads the cores of the machine
+/// are split evenly between the threads, leaving the rest of each share to OpenMP.
+std::vector<BenchmarkResult> run_concurrent_benchmark(std::shared_ptr<ngraph::Function> f,
+                                                      const std::string& backend_name,
+                                                      const BenchmarkOptions& options,
+                                                      const std::vector<size_t>& thread_counts,
+                                                      bool pin_threads);
+
+/// Writes result as JSON, in the format read by compare_benchmark
+void write_benchmark_json(const BenchmarkResult& result, const std::string& path);
+
+/// Prints result next to the one saved at baseline_path. Returns false on a regression:
+/// the median latency more than threshold_percent above the baseline, confirmed by a
+/// Mann-Whitney U test on the stored latencies when both runs have enough of them, or a
+/// p90/p99 latency more than threshold_percent above it with at least 10 samples beyond
+/// that percentile. Compile and first call times are reported but never fail the comparison.
+bool compare_benchmark(const BenchmarkResult& result,
+                       const std::string& baseline_path,
+                       double threshold_percent);